@@ -0,0 +1,92 @@
+﻿namespace Benchmarks
+{
+    using System;
+    using System.Diagnostics;
+
+    /// <summary>
+    ///     Times code and writes the results.
+    /// </summary>
+    internal static class Benchmark
+    {
+        /// <summary>
+        ///     How many times the code is timed, the fastest time is reported.
+        /// </summary>
+        private const int Rounds = 5;
+
+        /// <summary>
+        ///     Where results are written. This is the console when run as a program and the log file when run in game.
+        /// </summary>
+        internal static Action<string> Output = Console.WriteLine;
+
+        /// <summary>
+        ///     Writes the title of a group of benchmarks.
+        /// </summary>
+        /// <param name="title">The title.</param>
+        internal static void Header(string title)
+        {
+            Output(string.Empty);
+            Output(title);
+            Output(new string('-', title.Length));
+        }
+
+        /// <summary>
+        ///     Runs the code once to warm up and then times it a few times.
+        /// </summary>
+        /// <param name="name">The name of benchmark.</param>
+        /// <param name="operations">The count of operations that one run of code does.</param>
+        /// <param name="body">The code.</param>
+        /// <returns>The fastest time of one operation in nanoseconds.</returns>
+        internal static double Run(string name, long operations, Action body)
+        {
+            body();
+
+            var best = double.MaxValue;
+
+            for ( var i = 0; i < Rounds; i++ )
+            {
+                var watch = Stopwatch.StartNew();
+                body();
+                watch.Stop();
+
+                best = Math.Min(best, watch.Elapsed.TotalMilliseconds * 1000000.0 / operations);
+            }
+
+            Report(name, best);
+            return best;
+        }
+
+        /// <summary>
+        ///     Times code that can only run once, such as writing hooks.
+        /// </summary>
+        /// <param name="name">The name of benchmark.</param>
+        /// <param name="operations">The count of operations that the code does.</param>
+        /// <param name="body">The code.</param>
+        /// <returns>The time of one operation in nanoseconds.</returns>
+        internal static double Once(string name, long operations, Action body)
+        {
+            var watch = Stopwatch.StartNew();
+            body();
+            watch.Stop();
+
+            var time = watch.Elapsed.TotalMilliseconds * 1000000.0 / operations;
+
+            Report(name, time);
+            return time;
+        }
+
+        /// <summary>
+        ///     Writes the difference of two results.
+        /// </summary>
+        /// <param name="name">The name of difference.</param>
+        /// <param name="time">The time in nanoseconds.</param>
+        /// <param name="baseline">The baseline time in nanoseconds.</param>
+        internal static void Overhead(string name, double time, double baseline) => Report(name, time - baseline);
+
+        /// <summary>
+        ///     Writes one result.
+        /// </summary>
+        /// <param name="name">The name.</param>
+        /// <param name="time">The time of one operation in nanoseconds.</param>
+        private static void Report(string name, double time) => Output(string.Format("{0,-56} {1,12:0.0} ns/op", name, time));
+    }
+}
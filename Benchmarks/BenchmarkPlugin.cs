@@ -0,0 +1,48 @@
+﻿namespace Benchmarks
+{
+    using System;
+
+    using NetScriptFramework;
+    using NetScriptFramework.Tools;
+
+    /// <summary>
+    ///     Runs the benchmarks that need the game process when Benchmarks.dll is copied to the plugins directory. Hooks and
+    ///     monitored functions can only be written during plugin initialization so everything runs there, results are written
+    ///     to the benchmarks log file.
+    /// </summary>
+    public sealed class BenchmarkPlugin : Plugin
+    {
+        public override string Key => "benchmarks";
+
+        public override string Name => "Framework Benchmarks";
+
+        public override int Version => 1;
+
+        protected override bool Initialize(bool loadedAny)
+        {
+            using ( var log = new LogFile("Benchmarks", LogFileFlags.None) )
+            {
+                Benchmark.Output = log.AppendLine;
+
+                try
+                {
+                    PerformanceMonitorBenchmarks.Run();
+                    HookBenchmarks.Run();
+                    HookTransactionBenchmarks.Run();
+                    InvokeBatchBenchmarks.Run();
+                    EventBenchmarks.Run();
+                }
+                catch ( Exception ex )
+                {
+                    log.Append(ex);
+                }
+                finally
+                {
+                    Benchmark.Output = Console.WriteLine;
+                }
+            }
+
+            return true;
+        }
+    }
+}
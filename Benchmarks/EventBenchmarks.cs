@@ -0,0 +1,98 @@
+﻿namespace Benchmarks
+{
+    using System;
+    using System.Threading;
+
+    using NetScriptFramework;
+
+    /// <summary>
+    ///     Measures raising an event from many threads at once. Raising reads the published handler snapshot without
+    ///     locking, so the time of one raise should stay about the same as threads are added.
+    /// </summary>
+    internal static class EventBenchmarks
+    {
+        /// <summary>
+        ///     The count of raises on each thread in one run.
+        /// </summary>
+        private const int Raises = 1000000;
+
+        /// <summary>
+        ///     Runs the benchmarks.
+        /// </summary>
+        internal static void Run()
+        {
+            var unlimited = new Event<BenchmarkEventArgs>("benchmark_unlimited");
+            unlimited.Register(OnRaise);
+
+            // A count limited registration takes one count with an atomic decrement on every raise.
+            var counted = new Event<BenchmarkEventArgs>("benchmark_counted");
+            counted.Register(OnRaise, 0, int.MaxValue);
+
+            Benchmark.Header("Event raise");
+
+            // At least up to 8 threads so contention shows even when there are fewer processors.
+            for ( var threads = 1; threads <= Math.Max(8, Environment.ProcessorCount); threads *= 2 )
+            {
+                var count = threads;
+
+                Benchmark.Run("Raise, " + count + " thread(s)", (long)count * Raises, () => Raise(unlimited, count));
+                Benchmark.Run("Raise with counted handler, " + count + " thread(s)", (long)count * Raises, () => Raise(counted, count));
+            }
+        }
+
+        /// <summary>
+        ///     Raises the event on threads at the same time.
+        /// </summary>
+        /// <param name="ev">The event.</param>
+        /// <param name="count">The count of threads.</param>
+        private static void Raise(Event<BenchmarkEventArgs> ev, int count)
+        {
+            var threads = new Thread[count];
+
+            using ( var start = new ManualResetEventSlim(false) )
+            {
+                for ( var i = 0; i < threads.Length; i++ )
+                {
+                    threads[i] = new Thread(() =>
+                    {
+                        var args = new BenchmarkEventArgs();
+                        Func<BenchmarkEventArgs> init = () => args;
+
+                        start.Wait();
+
+                        for ( var n = 0; n < Raises; n++ )
+                        {
+                            ev.Raise(init);
+                        }
+                    });
+
+                    threads[i].Start();
+                }
+
+                start.Set();
+
+                foreach ( var t in threads )
+                {
+                    t.Join();
+                }
+            }
+        }
+
+        /// <summary>
+        ///     The event handler.
+        /// </summary>
+        /// <param name="args">The arguments.</param>
+        private static void OnRaise(BenchmarkEventArgs args) => args.Value++;
+
+        /// <summary>
+        ///     The arguments of benchmark event, each thread has its own.
+        /// </summary>
+        private sealed class BenchmarkEventArgs : EventArgs
+        {
+            /// <summary>
+            ///     The count of times handler was called.
+            /// </summary>
+            internal long Value;
+        }
+    }
+}
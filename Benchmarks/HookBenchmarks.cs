@@ -0,0 +1,174 @@
+﻿namespace Benchmarks
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Reflection;
+
+    using NetScriptFramework;
+    using NetScriptFramework.Tools._Internal;
+
+    /// <summary>
+    ///     Measures the round trip of a managed code hook: the trampoline, the dispatch table lookup, the reused CPU register
+    ///     wrapper and the managed handler. The managed dispatch is also compared with the way hooks were dispatched before
+    ///     the dispatch table: a dictionary lookup, choosing the handler and a new CPU register wrapper on every call.
+    /// </summary>
+    internal static class HookBenchmarks
+    {
+        /// <summary>
+        ///     The count of calls in one run.
+        /// </summary>
+        private const long Calls = 100000;
+
+        /// <summary>
+        ///     Runs the benchmarks. This must be called during plugin initialization because it writes hooks.
+        /// </summary>
+        internal static void Run()
+        {
+            var loop   = NativeCode.CreateLoop();
+            var plain  = NativeCode.CreateTarget();
+            var before = CreateHooked(cpu => { }, null);
+            var after  = CreateHooked(null, cpu => { });
+            var both   = CreateHooked(cpu => { }, cpu => { });
+
+            Benchmark.Header("Managed hooks");
+
+            var baseline = Benchmark.Run("Native call", Calls, () => NativeCode.Call(loop, plain, Calls));
+            var b        = Benchmark.Run("Hooked call, before", Calls, () => NativeCode.Call(loop, before, Calls));
+            var a        = Benchmark.Run("Hooked call, after", Calls, () => NativeCode.Call(loop, after, Calls));
+            var ab       = Benchmark.Run("Hooked call, before and after", Calls, () => NativeCode.Call(loop, both, Calls));
+
+            Benchmark.Overhead("Round trip of before hook", b, baseline);
+            Benchmark.Overhead("Round trip of after hook", a, baseline);
+            Benchmark.Overhead("Round trip of before and after hook", ab, baseline);
+
+            RunDispatch(loop, before);
+        }
+
+        /// <summary>
+        ///     Compares the managed dispatch of a hook call with the dispatch that was used before. Both are called from managed
+        ///     code on a copy of a hook context so only the dispatch differs, the trampoline is not included.
+        /// </summary>
+        /// <param name="loop">The loop function.</param>
+        /// <param name="target">The hooked function. Its hook must be a far jump with only a before action.</param>
+        private static void RunDispatch(IntPtr loop, IntPtr target)
+        {
+            // Make one real hook call so the context size is known, then set up a context that points to the hook.
+            NativeCode.Call(loop, target, 1);
+
+            var size    = (int)typeof(Memory).GetField("_hookContextSize", BindingFlags.NonPublic | BindingFlags.Static).GetValue(null);
+            var table   = (HookDispatchTable)typeof(Memory).GetField("HookDispatch", BindingFlags.NonPublic | BindingFlags.Static).GetValue(null);
+            var key     = target.ToInt64() + 13;
+            var legacy  = new Dictionary<long, HookInfo> { { key, table.Find(key) } };
+            var alloc   = Memory.Allocate(size, 0, false);
+            var context = alloc.Address;
+            var slot    = context + size - IntPtr.Size * 6;
+
+            alloc.Pin();
+            Memory.WriteZero(context, size);
+
+            Benchmark.Header("Managed hook dispatch");
+
+            var before = Benchmark.Run("Dictionary and new CPURegisters (before change)", Calls, () =>
+            {
+                for ( var i = 0; i < Calls; i++ )
+                {
+                    Memory.WritePointer(slot, new IntPtr(key));
+                    LegacyDoAction(legacy, context, size, 0);
+                }
+            });
+
+            var after = Benchmark.Run("Dispatch table and pooled CPURegisters", Calls, () =>
+            {
+                for ( var i = 0; i < Calls; i++ )
+                {
+                    Memory.WritePointer(slot, new IntPtr(key));
+                    Memory.DoAction(context, 0);
+                }
+            });
+
+            Benchmark.Overhead("Saved per hook call", before, after);
+
+            var allocated = GC.GetAllocatedBytesForCurrentThread();
+            Memory.WritePointer(slot, new IntPtr(key));
+            LegacyDoAction(legacy, context, size, 0);
+            var legacyBytes = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+            allocated = GC.GetAllocatedBytesForCurrentThread();
+            Memory.WritePointer(slot, new IntPtr(key));
+            Memory.DoAction(context, 0);
+            var currentBytes = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+            Benchmark.Output(string.Format("Allocated per hook call: {0} bytes before change, {1} bytes now", legacyBytes, currentBytes));
+        }
+
+        /// <summary>
+        ///     The managed dispatch of a hook call as it was before the dispatch table, except that the context size is not read
+        ///     from native code on every call.
+        /// </summary>
+        /// <param name="hooks">The hooks by return address.</param>
+        /// <param name="cpu_address">The address to CPU register info.</param>
+        /// <param name="size">The size of hook context.</param>
+        /// <param name="pass">The pass.</param>
+        private static void LegacyDoAction(Dictionary<long, HookInfo> hooks, IntPtr cpu_address, int size, int pass)
+        {
+            var hookAddr = Memory.ReadPointer((cpu_address + size) - (IntPtr.Size * 6));
+
+            if ( !hooks.TryGetValue(hookAddr.ToInt64(), out var hook) )
+            {
+                throw new InvalidOperationException("Trying to invoke missing hook (0x" + hookAddr.ToInt64().ToString("X") + ")!");
+            }
+
+            HookBase handler = null;
+
+            if ( hook.Before == null )
+            {
+                if ( hook.After != null )
+                {
+                    handler = HookAfter.Instance;
+                }
+                else
+                {
+                    throw new InvalidOperationException("Trying to invoke hook with no handlers!");
+                }
+            }
+            else if ( hook.After != null ) { handler = HookBoth.Instance; }
+            else { handler                           = HookBefore.Instance; }
+
+            var cpu = new CPURegisters(cpu_address, handler);
+
+            cpu.IP        = hook.Address + hook.Length;
+            cpu.Include   = pass == 0 ? hook.Include : hook.Include2;
+            cpu.Hook      = hook.Address;
+            cpu.AllowSkip = pass == 0;
+
+            var ac = pass == 0 ? hook.Before : hook.After;
+
+            if ( ac != null )
+            {
+                ac(cpu);
+            }
+        }
+
+        /// <summary>
+        ///     Creates a target function and hooks it.
+        /// </summary>
+        /// <param name="before">The before action or null.</param>
+        /// <param name="after">The after action or null.</param>
+        /// <returns>The address of function.</returns>
+        private static IntPtr CreateHooked(Action<CPURegisters> before, Action<CPURegisters> after)
+        {
+            var target = NativeCode.CreateTarget();
+
+            Memory.WriteHook(new HookParameters
+            {
+                Address       = target,
+                IncludeLength = NativeCode.TargetReplaceLength,
+                ReplaceLength = NativeCode.TargetReplaceLength,
+                Before        = before,
+                After         = after
+            });
+
+            return target;
+        }
+    }
+}
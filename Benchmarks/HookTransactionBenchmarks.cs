@@ -0,0 +1,80 @@
+﻿namespace Benchmarks
+{
+    using System;
+
+    using NetScriptFramework;
+
+    /// <summary>
+    ///     Compares writing many hooks one at a time, where every hook suspends all threads and changes page protection, with
+    ///     writing them in one <see cref="HookTransaction" />.
+    /// </summary>
+    internal static class HookTransactionBenchmarks
+    {
+        /// <summary>
+        ///     The count of hooks written by each benchmark.
+        /// </summary>
+        private const int Hooks = 64;
+
+        /// <summary>
+        ///     Runs the benchmarks. This must be called during plugin initialization because it writes hooks.
+        /// </summary>
+        internal static void Run()
+        {
+            var single  = CreateTargets();
+            var batched = CreateTargets();
+
+            Benchmark.Header("Hook transaction");
+
+            var one = Benchmark.Once("Write hook, one at a time", Hooks, () =>
+            {
+                foreach ( var target in single )
+                {
+                    WriteHook(target);
+                }
+            });
+
+            var all = Benchmark.Once("Write hook, in one transaction", Hooks, () =>
+            {
+                using ( var transaction = new HookTransaction() )
+                {
+                    foreach ( var target in batched )
+                    {
+                        WriteHook(target);
+                    }
+
+                    transaction.Commit();
+                }
+            });
+
+            Benchmark.Overhead("Saved per hook by transaction", one, all);
+        }
+
+        /// <summary>
+        ///     Creates the functions to hook.
+        /// </summary>
+        /// <returns>The addresses of functions.</returns>
+        private static IntPtr[] CreateTargets()
+        {
+            var targets = new IntPtr[Hooks];
+
+            for ( var i = 0; i < targets.Length; i++ )
+            {
+                targets[i] = NativeCode.CreateTarget();
+            }
+
+            return targets;
+        }
+
+        /// <summary>
+        ///     Writes an empty hook.
+        /// </summary>
+        /// <param name="target">The target function.</param>
+        private static void WriteHook(IntPtr target) => Memory.WriteHook(new HookParameters
+        {
+            Address       = target,
+            IncludeLength = NativeCode.TargetReplaceLength,
+            ReplaceLength = NativeCode.TargetReplaceLength,
+            Before        = cpu => { }
+        });
+    }
+}
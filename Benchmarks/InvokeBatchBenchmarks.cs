@@ -0,0 +1,52 @@
+﻿namespace Benchmarks
+{
+    using NetScriptFramework;
+
+    /// <summary>
+    ///     Compares many individual <see cref="Memory.InvokeCdecl" /> calls, each with its own transition to native code, with
+    ///     the same calls recorded in one <see cref="InvokeBatch" />.
+    /// </summary>
+    internal static class InvokeBatchBenchmarks
+    {
+        /// <summary>
+        ///     The count of calls in one run.
+        /// </summary>
+        private const int Calls = 10000;
+
+        /// <summary>
+        ///     Runs the benchmarks.
+        /// </summary>
+        internal static void Run()
+        {
+            var target = NativeCode.CreateTarget();
+            var batch  = new InvokeBatch(Calls);
+
+            Benchmark.Header("Invoke batch");
+
+            var single = Benchmark.Run("InvokeCdecl, one call at a time", Calls, () =>
+            {
+                for ( var i = 0; i < Calls; i++ )
+                {
+                    Memory.InvokeCdecl(target, i);
+                }
+            });
+
+            var recorded = Benchmark.Run("InvokeBatch, record and execute", Calls, () =>
+            {
+                batch.Clear();
+
+                for ( var i = 0; i < Calls; i++ )
+                {
+                    batch.Call(target);
+                    batch.Arg(i);
+                }
+
+                batch.Execute();
+            });
+
+            Benchmark.Run("InvokeBatch, execute recorded calls", Calls, () => batch.Execute());
+
+            Benchmark.Overhead("Saved per call by batch", single, recorded);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+﻿namespace Benchmarks
+{
+    using System;
+
+    using NetScriptFramework;
+
+    /// <summary>
+    ///     Small native functions written to executable memory so native calls can be timed without depending on game code.
+    /// </summary>
+    internal static class NativeCode
+    {
+        /// <summary>
+        ///     The length of code at the start of a target function that a hook or the performance monitor may replace. It ends
+        ///     on an instruction boundary and has no relative addressing.
+        /// </summary>
+        internal const int TargetReplaceLength = 16;
+
+        /// <summary>
+        ///     Creates a function that returns its first argument. It is padded so it can be hooked with a far jump.
+        /// </summary>
+        /// <returns>The address of function.</returns>
+        internal static IntPtr CreateTarget()
+        {
+            var code = new byte[TargetReplaceLength + 1];
+
+            code[0] = 0x48; // mov rax, rcx
+            code[1] = 0x89;
+            code[2] = 0xC8;
+
+            for ( var i = 3; i < TargetReplaceLength; i++ )
+            {
+                code[i] = 0x90; // nop
+            }
+
+            code[TargetReplaceLength] = 0xC3; // ret
+
+            return Write(code);
+        }
+
+        /// <summary>
+        ///     Creates a function that calls the function in its second argument as many times as its first argument says, so
+        ///     the calls are timed without a transition from .NET for each call.
+        /// </summary>
+        /// <returns>The address of function.</returns>
+        internal static IntPtr CreateLoop()
+        {
+            var code = new byte[]
+            {
+                0x53,                   // push rbx
+                0x56,                   // push rsi
+                0x48, 0x83, 0xEC, 0x28, // sub rsp, 0x28
+                0x48, 0x89, 0xCB,       // mov rbx, rcx
+                0x48, 0x89, 0xD6,       // mov rsi, rdx
+                0x48, 0x85, 0xDB,       // test rbx, rbx
+                0x74, 0x07,             // jz done
+                0xFF, 0xD6,             // loop: call rsi
+                0x48, 0xFF, 0xCB,       // dec rbx
+                0x75, 0xF9,             // jnz loop
+                0x48, 0x83, 0xC4, 0x28, // done: add rsp, 0x28
+                0x5E,                   // pop rsi
+                0x5B,                   // pop rbx
+                0xC3                    // ret
+            };
+
+            return Write(code);
+        }
+
+        /// <summary>
+        ///     Calls the target function count times from native code.
+        /// </summary>
+        /// <param name="loop">The loop function, see <see cref="CreateLoop" />.</param>
+        /// <param name="target">The target function.</param>
+        /// <param name="count">The count of calls.</param>
+        internal static void Call(IntPtr loop, IntPtr target, long count) => Memory.InvokeCdecl(loop, count, target);
+
+        /// <summary>
+        ///     Writes code to new executable memory that is never freed.
+        /// </summary>
+        /// <param name="code">The code.</param>
+        /// <returns>The address of code.</returns>
+        private static IntPtr Write(byte[] code)
+        {
+            var alloc = Memory.Allocate(code.Length + 0x10, 0, true);
+            alloc.Pin();
+            Memory.WriteBytes(alloc.Address, code);
+            return alloc.Address;
+        }
+    }
+}
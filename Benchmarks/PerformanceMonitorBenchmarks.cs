@@ -0,0 +1,43 @@
+﻿namespace Benchmarks
+{
+    using NetScriptFramework.Tools;
+
+    /// <summary>
+    ///     Measures what the native performance monitor adds to each call of a monitored function.
+    /// </summary>
+    internal static class PerformanceMonitorBenchmarks
+    {
+        /// <summary>
+        ///     The count of calls in one run.
+        /// </summary>
+        private const long Calls = 1000000;
+
+        /// <summary>
+        ///     Runs the benchmarks. This must be called during plugin initialization because it adds a monitored function.
+        /// </summary>
+        internal static void Run()
+        {
+            var loop      = NativeCode.CreateLoop();
+            var plain     = NativeCode.CreateTarget();
+            var monitored = NativeCode.CreateTarget();
+
+            PerformanceMonitor.Add(monitored, NativeCode.TargetReplaceLength);
+
+            Benchmark.Header("Performance monitor");
+
+            var enabled  = PerformanceMonitor.Enabled;
+            var baseline = Benchmark.Run("Native call", Calls, () => NativeCode.Call(loop, plain, Calls));
+
+            PerformanceMonitor.Enabled = true;
+            var on = Benchmark.Run("Native call, monitored", Calls, () => NativeCode.Call(loop, monitored, Calls));
+
+            PerformanceMonitor.Enabled = false;
+            var off = Benchmark.Run("Native call, monitored while disabled", Calls, () => NativeCode.Call(loop, monitored, Calls));
+
+            PerformanceMonitor.Enabled = enabled;
+
+            Benchmark.Overhead("Overhead of monitoring", on, baseline);
+            Benchmark.Overhead("Overhead of disabled monitor", off, baseline);
+        }
+    }
+}
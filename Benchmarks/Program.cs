@@ -0,0 +1,25 @@
+﻿namespace Benchmarks
+{
+    using System;
+
+    /// <summary>
+    ///     Runs the benchmarks that don't need the game. Copy Benchmarks.dll to the plugins directory to run the benchmarks of
+    ///     hooks and native calls in game, see <see cref="BenchmarkPlugin" />.
+    /// </summary>
+    internal static class Program
+    {
+        /// <summary>
+        ///     Runs the benchmarks.
+        /// </summary>
+        /// <param name="args">The command line arguments.</param>
+        /// <returns>Zero on success.</returns>
+        private static int Main(string[] args)
+        {
+            EventBenchmarks.Run();
+
+            Console.WriteLine();
+            Console.WriteLine("Benchmarks of hooks, native calls and the performance monitor only run in game.");
+            return 0;
+        }
+    }
+}
@@ -0,0 +1,255 @@
+﻿namespace BytePatternBenchmark
+{
+    using System;
+    using System.Collections.Generic;
+    using System.IO;
+
+    using Benchmarks;
+
+    using NetScriptFramework;
+
+    /// <summary>
+    ///     Command line tool that times the byte pattern scanner on the executable sections of a PE image read from a file,
+    ///     either the module file itself or a raw dump of the loaded module. It doesn't need the game so it runs on any
+    ///     platform.
+    /// </summary>
+    internal static class Program
+    {
+        /// <summary>
+        ///     The patterns that are searched if none are given in arguments, common x64 function prologues and call sites.
+        /// </summary>
+        private static readonly string[] DefaultPatterns =
+        {
+            "48 89 5C 24 ? 57 48 83 EC ?",
+            "48 89 5C 24 ? 48 89 74 24 ? 57 48 83 EC ?",
+            "40 53 48 83 EC ?",
+            "48 8B C4 48 89 58 ?",
+            "48 83 EC ? 48 8B 05 ? ? ? ? 48 85 C0",
+            "E8 ? ? ? ? 48 8B D8 48 85 C0",
+            "48 8D 0D ? ? ? ? E8 ? ? ? ?",
+            "FF 15 ? ? ? ? 90",
+            "?? ?? 48 8B 01 FF 50 ??",
+            "CC CC CC CC CC CC CC CC"
+        };
+
+        /// <summary>
+        ///     Times the scanner on the image given in arguments.
+        /// </summary>
+        /// <param name="args">The command line arguments.</param>
+        /// <returns>Zero on success.</returns>
+        private static int Main(string[] args)
+        {
+            string input  = null;
+            var    mapped = false;
+            var    texts  = new List<string>();
+
+            for ( var i = 0; i < args.Length; i++ )
+            {
+                var arg = args[i];
+
+                if ( arg.StartsWith("-") )
+                {
+                    switch ( arg.ToLowerInvariant() )
+                    {
+                        case "-mapped":
+                            mapped = true;
+                            break;
+
+                        case "-pattern":
+                            if ( i + 1 >= args.Length )
+                            {
+                                return Usage("Missing value for " + arg + "!");
+                            }
+
+                            texts.Add(args[++i]);
+                            break;
+
+                        default: return Usage("Unknown option " + arg + "!");
+                    }
+                }
+                else if ( input == null )
+                {
+                    input = arg;
+                }
+                else
+                {
+                    return Usage("Too many arguments!");
+                }
+            }
+
+            if ( input == null )
+            {
+                return Usage(null);
+            }
+
+            if ( texts.Count == 0 )
+            {
+                texts.AddRange(DefaultPatterns);
+            }
+
+            var patterns = new List<BytePattern>(texts.Count);
+
+            try
+            {
+                foreach ( var text in texts )
+                {
+                    patterns.Add(BytePattern.Parse(text));
+                }
+            }
+            catch ( FormatException ex )
+            {
+                return Usage(ex.Message);
+            }
+
+            byte[] image;
+            var    sections = new List<KeyValuePair<int, int>>();
+
+            try
+            {
+                image = File.ReadAllBytes(input);
+
+                // A dump may be cut short, only scan what is in the file.
+                foreach ( var x in BytePattern.GetCodeSections(image, mapped) )
+                {
+                    if ( x.Key < image.Length )
+                    {
+                        sections.Add(new KeyValuePair<int, int>((int)x.Key, (int)Math.Min(x.Value, image.Length - x.Key)));
+                    }
+                }
+            }
+            catch ( Exception ex ) when ( ex is IOException || ex is UnauthorizedAccessException || ex is InvalidOperationException )
+            {
+                Console.Error.WriteLine("Failed to read \"" + input + "\": " + ex.Message);
+                return 1;
+            }
+
+            long total = 0;
+
+            foreach ( var x in sections )
+            {
+                total += x.Value;
+            }
+
+            if ( total == 0 )
+            {
+                Console.Error.WriteLine("Image \"" + input + "\" has no executable code!");
+                return 1;
+            }
+
+            try
+            {
+                Run(image, sections, texts, patterns, total);
+            }
+            catch ( ArgumentException ex )
+            {
+                return Usage(ex.Message);
+            }
+
+            return 0;
+        }
+
+        /// <summary>
+        ///     Runs the benchmarks.
+        /// </summary>
+        /// <param name="image">The image.</param>
+        /// <param name="sections">The offset and length of executable sections in image.</param>
+        /// <param name="texts">The texts of patterns.</param>
+        /// <param name="patterns">The patterns.</param>
+        /// <param name="total">The total length of sections.</param>
+        private static void Run(byte[] image, List<KeyValuePair<int, int>> sections, List<string> texts, List<BytePattern> patterns, long total)
+        {
+            var kib     = Math.Max(1, total / 1024);
+            var found   = new List<int>();
+            var ordered = new List<KeyValuePair<int, int>>();
+            var counts  = new int[patterns.Count];
+
+            Console.WriteLine("Scanning " + total + " bytes of code in " + sections.Count + " sections for " + patterns.Count + " patterns.");
+
+            Benchmark.Header("Byte pattern");
+
+            Benchmark.Run("Parse", texts.Count, () =>
+            {
+                foreach ( var text in texts )
+                {
+                    BytePattern.Parse(text);
+                }
+            });
+
+            var first = Benchmark.Run("IndexOf, first pattern to end of code (per KiB)", kib, () =>
+            {
+                foreach ( var x in sections )
+                {
+                    var data = new ReadOnlySpan<byte>(image, x.Key, x.Value);
+                    var pos  = patterns[0].IndexOf(data);
+
+                    while ( pos >= 0 )
+                    {
+                        pos = patterns[0].IndexOf(data, pos + 1);
+                    }
+                }
+            });
+
+            var single = Benchmark.Run("FindAll, each pattern separately (per KiB)", kib, () =>
+            {
+                Array.Clear(counts, 0, counts.Length);
+
+                for ( var i = 0; i < patterns.Count; i++ )
+                {
+                    foreach ( var x in sections )
+                    {
+                        found.Clear();
+                        patterns[i].FindAll(new ReadOnlySpan<byte>(image, x.Key, x.Value), found);
+                        counts[i] += found.Count;
+                    }
+                }
+            });
+
+            var orderedCount = 0;
+
+            var all = Benchmark.Run("FindAll, all patterns ordered by position (per KiB)", kib, () =>
+            {
+                orderedCount = 0;
+
+                foreach ( var x in sections )
+                {
+                    ordered.Clear();
+                    BytePattern.FindAll(patterns, new ReadOnlySpan<byte>(image, x.Key, x.Value), ordered);
+                    orderedCount += ordered.Count;
+                }
+            });
+
+            Benchmark.Overhead("Ordering matches by position (per KiB)", all, single);
+
+            Console.WriteLine();
+            Console.WriteLine(string.Format("Scan speed of one pattern: {0:0} MiB/s", 1000000000.0 / first / 1024.0));
+
+            var separateCount = 0;
+
+            for ( var i = 0; i < patterns.Count; i++ )
+            {
+                Console.WriteLine(string.Format("{0,8} {1}", counts[i], texts[i]));
+                separateCount += counts[i];
+            }
+
+            Console.WriteLine(string.Format("{0,8} matches separately, {1} ordered", separateCount, orderedCount));
+        }
+
+        /// <summary>
+        ///     Writes the usage of tool.
+        /// </summary>
+        /// <param name="error">The error to write before usage or null.</param>
+        /// <returns></returns>
+        private static int Usage(string error)
+        {
+            if ( error != null )
+            {
+                Console.Error.WriteLine(error);
+            }
+
+            Console.WriteLine("Usage: BytePatternBenchmark <image> [-mapped] [-pattern <hex>]...");
+            Console.WriteLine("  -mapped   The image is a dump of a loaded module instead of the module file.");
+            Console.WriteLine("  -pattern  Search this pattern instead of the default ones, can be given many times.");
+            return 2;
+        }
+    }
+}
@@ -1,6 +1,7 @@
 ﻿namespace IFPV
 {
     using System;
+    using System.Buffers.Binary;
     using System.Collections.Generic;
 
     using NetScriptFramework;
@@ -8,14 +9,22 @@
 
     internal sealed class CameraHideHelper
     {
-        internal readonly CameraMain       CameraMain;
-        private readonly  biped_mask       IsHelmetBipedMask;
-        private readonly  List<NiAVObject> LastHelmet = new List<NiAVObject>();
-        private readonly  biped_mask       NotHelmetBipedMask;
-        private           NiAVObject       FirstPersonSkeleton;
-        private           IntPtr           LastAddress = IntPtr.Zero;
-        private           HideFlags        LastFlags   = HideFlags.None;
-        private           uint             LastFormId;
+        // Partition count is read from game memory, anything above this is treated as a corrupt skin.
+        private const int MaxDismemberPartitions = 1024;
+
+        private static readonly uint FaceGenNodeNameHash = SceneSnapshot.HashName("BSFaceGenNiNodeSkinned");
+
+        internal readonly CameraMain               CameraMain;
+        private readonly  SceneSnapshot            EquipmentSnapshot = new SceneSnapshot(256);
+        private readonly  Dictionary<IntPtr, bool> GeometryVTables   = new Dictionary<IntPtr, bool>();
+        private readonly  biped_mask               IsHelmetBipedMask;
+        private readonly  List<NiAVObject>         LastHelmet = new List<NiAVObject>();
+        private readonly  biped_mask               NotHelmetBipedMask;
+        private           bool[]                   EquipmentSkipped = new bool[256];
+        private           NiAVObject               FirstPersonSkeleton;
+        private           IntPtr                   LastAddress = IntPtr.Zero;
+        private           HideFlags                LastFlags   = HideFlags.None;
+        private           uint                     LastFormId;
 
         private uint   LastRaceId;
         private IntPtr LastSkeleton = IntPtr.Zero;
@@ -236,19 +245,8 @@
             this.LastHelmet.Clear();
         }
 
-        private void ExploreEquipment(NiNode root, NiAVObject current, List<NiAVObject> ls)
+        private void ExploreEquipment(NiAVObject current, List<NiAVObject> ls)
         {
-            // Special case, we should ignore and stop looking here, head is handled elsewhere.
-            if ( current != null )
-            {
-                var nm = current.Name.Text ?? "";
-
-                if ( nm.Equals("BSFaceGenNiNodeSkinned", StringComparison.OrdinalIgnoreCase) )
-                {
-                    return;
-                }
-            }
-
             if ( current is BSGeometry )
             {
                 var g    = (BSGeometry)current;
@@ -258,17 +256,18 @@
                 {
                     var count = Memory.ReadInt32(skin.Address + 0x88);
 
-                    if ( count > 0 )
+                    if ( count > 0 && count <= MaxDismemberPartitions )
                     {
                         var pbuf = Memory.ReadPointer(skin.Address + 0x90);
 
                         if ( pbuf != IntPtr.Zero )
                         {
                             var isHelm = false;
+                            var data   = Memory.ReadBytesSpan(pbuf, 4 * count);
 
                             for ( var i = 0; i < count; i++ )
                             {
-                                int m = Memory.ReadUInt16(pbuf + ((4 * i) + 2));
+                                int m = BinaryPrimitives.ReadUInt16LittleEndian(data.Slice((4 * i) + 2));
 
                                 if ( this.NotHelmetBipedMask[m] )
                                 {
@@ -290,19 +289,60 @@
                     }
                 }
             }
+        }
 
-            if ( current is NiNode )
+        private void FillValidBipedObjects(NiNode root, List<NiAVObject> ls)
+        {
+            // The whole subtree is read in one native walk, objects are in the same depth first order as recursing children.
+            var snapshot = this.EquipmentSnapshot;
+            snapshot.Recapture(root, SceneSnapshotFlags.NameHashes);
+
+            var count   = snapshot.Count;
+            var parents = snapshot.ParentIndices;
+            var names   = snapshot.NameHashes;
+
+            if ( this.EquipmentSkipped.Length < count )
             {
-                var n = current as NiNode;
+                this.EquipmentSkipped = new bool[count];
+            }
+
+            var skipped = this.EquipmentSkipped;
 
-                foreach ( var ch in n.Children )
+            for ( var i = 0; i < count; i++ )
+            {
+                var parent = parents[i];
+
+                // Special case, we should ignore and stop looking here, head is handled elsewhere.
+                skipped[i] = (parent >= 0 && skipped[parent]) || (names[i] == FaceGenNodeNameHash && IsFaceGenNode(snapshot, i));
+
+                // Only geometry is checked, so look at the vtable first and don't create a wrapper for every other node.
+                if ( !skipped[i] && this.IsGeometry(snapshot, i) )
                 {
-                    this.ExploreEquipment(root, ch, ls);
+                    this.ExploreEquipment(snapshot.GetNode(i), ls);
                 }
             }
         }
 
-        private void FillValidBipedObjects(NiNode root, List<NiAVObject> ls) => this.ExploreEquipment(root, root, ls);
+        private bool IsGeometry(SceneSnapshot snapshot, int index)
+        {
+            var vtable = Memory.ReadPointer(snapshot.Nodes[index]);
+            var result = false;
+
+            if ( !this.GeometryVTables.TryGetValue(vtable, out result) )
+            {
+                result = snapshot.GetNode(index) is BSGeometry;
+                this.GeometryVTables[vtable] = result;
+            }
+
+            return result;
+        }
+
+        private static bool IsFaceGenNode(SceneSnapshot snapshot, int index)
+        {
+            var nm = snapshot.GetNode(index).Name.Text ?? "";
+
+            return nm.Equals("BSFaceGenNiNodeSkinned", StringComparison.OrdinalIgnoreCase);
+        }
 
         private List<NiAVObject> GetHelmetNodes(NiNode root)
         {
@@ -951,7 +951,7 @@ namespace IFPV
         internal bool IsGameCameraSwitchControlsEnabled()
         {
             var controls = PlayerControls.Instance;
-            return controls != null && Memory.InvokeCdecl(this.Plugin.PlayerControls_IsCamSwitchControlsEnabled, controls.Address).ToBool();
+            return controls != null && this.Plugin.PlayerControls_IsCamSwitchControlsEnabled.Invoke(controls.Address) != 0;
         }
 
         private void OnEnabled(CameraUpdate update) => this.LastActorTurnFrames = 0;
@@ -1223,7 +1223,7 @@ namespace IFPV
                     }
                 }
 
-                Memory.InvokeCdecl(this.Plugin.ActorTurnZ, actor.Address, (float)actual);
+                this.Plugin.ActorTurnZ.Invoke(actor.Address, (float)actual);
 
                 if ( actual == x )
                 {
@@ -1241,7 +1241,7 @@ namespace IFPV
             if ( y != 0.0 )
             {
                 var actual = y;
-                Memory.InvokeCdecl(this.Plugin.ActorTurnX, actor.Address, -(float)actual);
+                this.Plugin.ActorTurnX.Invoke(actor.Address, -(float)actual);
                 third.YRotationFromLastResetPoint = 0.0f;
 
                 didy = actual;
@@ -5,6 +5,7 @@ namespace IFPV
     using System;
     using System.Collections.Generic;
     using System.Diagnostics;
+    using System.Runtime.InteropServices;
     using System.Threading;
 
     using NetScriptFramework;
@@ -55,24 +56,29 @@ namespace IFPV
 
         internal long _lastDiff2 { get; private set; }
 
-        internal IntPtr Actor_GetMoveDirection { get; private set; }
+        internal NativeFunction<_ActorGetMoveDirection> Actor_GetMoveDirection { get; private set; }
 
-        internal IntPtr ActorTurnX { get; private set; }
+        internal NativeFunction<_ActorTurn> ActorTurnX { get; private set; }
 
-        internal IntPtr ActorTurnZ { get; private set; }
+        internal NativeFunction<_ActorTurn> ActorTurnZ { get; private set; }
 
         internal CameraMain CameraMain { get; private set; }
 
         internal IntPtr NiNode_ctor { get; private set; }
 
-        internal IntPtr PlayerControls_IsCamSwitchControlsEnabled { get; private set; }
+        internal NativeFunction<_PlayerControlsIsCamSwitchControlsEnabled> PlayerControls_IsCamSwitchControlsEnabled { get; private set; }
 
         internal IntPtr SwitchSkeleton { get; private set; }
 
         protected override bool Initialize(bool loadedAny)
         {
             Instance = this;
-            this.init();
+
+            using ( var hooks = new HookTransaction() )
+            {
+                this.init();
+                hooks.Commit();
+            }
 
             return true;
         }
@@ -85,17 +91,17 @@ namespace IFPV
             this.Settings = new Settings();
             this.Settings.Load();
 
-            this.PlayerControls_IsCamSwitchControlsEnabled = this.PrepareFunction("player camera switch controls check", 41263, 0);
+            this.PlayerControls_IsCamSwitchControlsEnabled = this.PrepareFunction<_PlayerControlsIsCamSwitchControlsEnabled>("player camera switch controls check", 41263, 0);
 
             this.NiNode_ctor            = this.PrepareFunction("ninode ctor", 68936, 0);
             this.MagicNodeArt1          = this.PrepareFunction("magic node art 1", 33403, 0x6F);
             this.MagicNodeArt2          = this.PrepareFunction("magic node art 2", 33391, 0x64);
             this.MagicNodeArt3          = this.PrepareFunction("magic node art 3", 33375, 0xF5);
             this.MagicNodeArt4          = this.PrepareFunction("magic node art 4", 33683, 0x63);
-            this.ActorTurnX             = this.PrepareFunction("actor turn x", 36603, 0);
-            this.ActorTurnZ             = this.PrepareFunction("actor turn z", 36250, 0);
+            this.ActorTurnX             = this.PrepareFunction<_ActorTurn>("actor turn x", 36603, 0);
+            this.ActorTurnZ             = this.PrepareFunction<_ActorTurn>("actor turn z", 36250, 0);
             this.SwitchSkeleton         = this.PrepareFunction("switch skeleton", 39401, 0);
-            this.Actor_GetMoveDirection = this.PrepareFunction("actor move direction", 36935, 0);
+            this.Actor_GetMoveDirection = this.PrepareFunction<_ActorGetMoveDirection>("actor move direction", 36935, 0);
 
             if ( this.Settings.AllowLookDownAlot )
             {
@@ -780,5 +786,16 @@ namespace IFPV
         }
 
         private IntPtr PrepareFunction(string name, ulong vid, int offset) => Main.GameInfo.GetAddressOf(vid, offset);
+
+        private NativeFunction<T> PrepareFunction<T>(string name, ulong vid, int offset) where T : Delegate => new NativeFunction<T>(this.PrepareFunction(name, vid, offset));
+
+        [ UnmanagedFunctionPointer(CallingConvention.Cdecl) ]
+        internal delegate float _ActorGetMoveDirection(IntPtr actor);
+
+        [ UnmanagedFunctionPointer(CallingConvention.Cdecl) ]
+        internal delegate void _ActorTurn(IntPtr actor, float amount);
+
+        [ UnmanagedFunctionPointer(CallingConvention.Cdecl) ]
+        internal delegate byte _PlayerControlsIsCamSwitchControlsEnabled(IntPtr controls);
     }
 }
@@ -105,7 +105,7 @@
                 return;
             }
 
-            double dir = Memory.InvokeCdeclF(update.CameraMain.Plugin.Actor_GetMoveDirection, actor.Address);
+            double dir = update.CameraMain.Plugin.Actor_GetMoveDirection.Invoke(actor.Address);
             var    pi  = Math.PI;
             dir =  dir + pi;
             dir %= pi * 2.0;
@@ -0,0 +1,126 @@
+﻿namespace LogDecoder
+{
+    using System;
+    using System.IO;
+    using NetScriptFramework.Tools;
+
+    /// <summary>
+    ///     Command line tool that turns binary log files back to text.
+    /// </summary>
+    internal static class Program
+    {
+        /// <summary>
+        ///     Decodes the binary log file given in arguments.
+        /// </summary>
+        /// <param name="args">The command line arguments.</param>
+        /// <returns>Zero on success.</returns>
+        private static int Main(string[] args)
+        {
+            string    input    = null;
+            string    output   = null;
+            var       threadId = 0;
+            DateTime? from     = null;
+            DateTime? to       = null;
+
+            for ( var i = 0; i < args.Length; i++ )
+            {
+                var arg = args[i];
+
+                if ( arg.StartsWith("-") )
+                {
+                    if ( i + 1 >= args.Length )
+                    {
+                        return Usage("Missing value for " + arg + "!");
+                    }
+
+                    var option = arg.ToLowerInvariant();
+                    var value  = args[++i];
+
+                    switch ( option )
+                    {
+                        case "-thread":
+                            if ( !int.TryParse(value, out threadId) )
+                            {
+                                return Usage("Invalid thread identifier \"" + value + "\"!");
+                            }
+
+                            break;
+
+                        case "-from":
+                        case "-to":
+                            if ( !DateTime.TryParse(value, out var time) )
+                            {
+                                return Usage("Invalid time \"" + value + "\"!");
+                            }
+
+                            if ( option == "-from" )
+                            {
+                                from = time;
+                            }
+                            else
+                            {
+                                to = time;
+                            }
+
+                            break;
+
+                        default: return Usage("Unknown option " + arg + "!");
+                    }
+                }
+                else if ( input == null )
+                {
+                    input = arg;
+                }
+                else if ( output == null )
+                {
+                    output = arg;
+                }
+                else
+                {
+                    return Usage("Too many arguments!");
+                }
+            }
+
+            if ( input == null )
+            {
+                return Usage(null);
+            }
+
+            if ( output == null )
+            {
+                output = Path.ChangeExtension(input, ".txt");
+            }
+
+            try
+            {
+                var count = BinaryLogDecoder.Decode(input, output, threadId, from, to);
+                Console.WriteLine("Wrote " + count + " entries to \"" + output + "\".");
+                return 0;
+            }
+            catch ( Exception ex ) when ( ex is IOException || ex is InvalidDataException || ex is UnauthorizedAccessException )
+            {
+                Console.Error.WriteLine("Failed to decode \"" + input + "\": " + ex.Message);
+                return 1;
+            }
+        }
+
+        /// <summary>
+        ///     Writes the usage of tool.
+        /// </summary>
+        /// <param name="error">The error to write before usage or null.</param>
+        /// <returns></returns>
+        private static int Usage(string error)
+        {
+            if ( error != null )
+            {
+                Console.Error.WriteLine(error);
+            }
+
+            Console.WriteLine("Usage: LogDecoder <input.bin> [output.txt] [-thread <id>] [-from <time>] [-to <time>]");
+            Console.WriteLine("  -thread  Only write entries of this native thread.");
+            Console.WriteLine("  -from    Only write entries at or after this local time.");
+            Console.WriteLine("  -to      Only write entries at or before this local time.");
+            return 2;
+        }
+    }
+}
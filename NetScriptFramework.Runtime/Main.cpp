@@ -4,7 +4,7 @@
 #define FRAMEWORK_PATH "Data\\NetScriptFramework"
 
 #define EXPORT __declspec(dllexport)
-#define RUNTIME_VERSION 5
+#define RUNTIME_VERSION 10
 
 #define ARGTYPE_FLOAT 1
 #define ARGTYPE_OTHER 2
@@ -25,27 +25,59 @@
 // Max recursive hook call depth
 #define HOOK_MAX_CALLS 1024
 
+// Address space reserved per thread for hook contexts. Pages are only committed
+// in chunks of HOOK_CONTEXT_COMMIT_SIZE once a hook actually touches them.
+#define HOOK_CONTEXT_RESERVE_SIZE (HOOK_CONTEXT_SIZE * (HOOK_MAX_CALLS + 1))
+#define HOOK_CONTEXT_COMMIT_SIZE 0x10000
+
 #define TLS_STORAGE_HOOK_CALL_COUNT 0
 #define TLS_STORAGE_HOOK_CONTEXT_BLOCK 1
 #define TLS_STORAGE_EXCEPTION_DEPTH 2
 #define TLS_STORAGE_PERFORMANCE_MONITOR 3
-#define TLS_STORAGE_SIZE 4
+#define TLS_STORAGE_HOOK_HIGH_WATER 4
+#define TLS_STORAGE_HOOK_CONTEXT_COMMITTED 5
+#define TLS_STORAGE_HOOK_STATISTICS 6
+#define TLS_STORAGE_SIZE 7
 
 #define PMON_DEPTH 0
 #define PMON_STACK 1
 #define PMON_ENTRIES 2
-#define PMON_BEGIN 3
-#define PMON_END 4
+#define PMON_NEXT 3
+#define PMON_THREAD 4
 #define PMON_SIZE 5
 
 #define PMONMAXSTACK 1024
+#define PMONMAXFUNCTIONS 4096
+#define PMONFILE_VERSION 1
+
+#define PMONFRAME_SLOT 0
+#define PMONFRAME_BEGIN 1
+#define PMONFRAME_CHILD 2
+#define PMONFRAME_RETURN 3
+#define PMONFRAME_SIZE 4
 
 #define PMONENTRY_DEPTH 0
-#define PMONENTRY_CURRENT_BEGIN 1
+#define PMONENTRY_CALLS 1
 #define PMONENTRY_TOTAL_INCLUSIVE 2
 #define PMONENTRY_TOTAL_EXCLUSIVE 3
 #define PMONENTRY_SIZE 4
 
+// Per thread hook statistics are split in chunks so a thread only allocates
+// memory for the hooks it actually runs.
+#define HOOKSTAT_MAX_HOOKS 4096
+#define HOOKSTAT_CHUNK_SIZE 64
+#define HOOKSTAT_BUCKETS 32
+
+#define HOOKSTAT_NEXT 0
+#define HOOKSTAT_CHUNKS 1
+#define HOOKSTAT_SIZE (HOOKSTAT_CHUNKS + HOOKSTAT_MAX_HOOKS / HOOKSTAT_CHUNK_SIZE)
+
+#define HOOKSTATENTRY_CALLS 0
+#define HOOKSTATENTRY_TOTAL 1
+#define HOOKSTATENTRY_MAX 2
+#define HOOKSTATENTRY_BUCKETS 3
+#define HOOKSTATENTRY_SIZE (HOOKSTATENTRY_BUCKETS + HOOKSTAT_BUCKETS)
+
 int64 _qpc_frequency = 0;
 int64 _qpc_offset32 = 0;
 int64 _qpc_offset64 = 0;
@@ -107,7 +139,10 @@ bool IsFrameworkOk()
     return initState == 2;
 }
 
-delegate void DoActionDelegate(System::IntPtr data, System::Int32 pass);
+delegate System::Int32 DoActionDelegate(System::IntPtr data, System::Int32 pass);
+
+int64 HookStatisticsBegin();
+void HookStatisticsEnd(int slot, int64 begin);
 
 private ref class ManagedHook sealed abstract
 {
@@ -184,13 +219,23 @@ public:
     static DoActionDelegate^ _funcDel = nullptr;
 };
 
+int InvokeAction(void* data, unsigned int pass)
+{
+    return ManagedHook::_funcDel(System::IntPtr(data), static_cast<int>(pass));
+}
+
+#pragma managed(push, off)
 void* DoAction(void* data, unsigned int pass)
 {
     pass &= 0x7F;
 
-    ManagedHook::_funcDel(System::IntPtr(data), static_cast<int>(pass));
+    int64 begin = HookStatisticsBegin();
+    int slot = InvokeAction(data, pass);
+    if (begin != 0)
+        HookStatisticsEnd(slot, begin);
     return data;
 }
+#pragma managed(pop)
 
 void DetachThread()
 {
@@ -221,6 +266,64 @@ void HookVerifyError()
 
 static DWORD dwTlsIndex = 0;
 
+static volatile LONG64 _hookContextCommitted = 0;
+static volatile LONG64 _hookContextReserved = 0;
+
+// Commits the chunk of the current thread's hook context block that contains address
+// and writes the verify index of every context that ends in it.
+bool CommitHookContext(Pointer* tls, Pointer address)
+{
+    Pointer block = tls[TLS_STORAGE_HOOK_CONTEXT_BLOCK];
+    if (block == 0 || address < block || address >= block +
+        HOOK_CONTEXT_RESERVE_SIZE)
+        return false;
+
+    Pointer begin = block + (address - block) / HOOK_CONTEXT_COMMIT_SIZE *
+        HOOK_CONTEXT_COMMIT_SIZE;
+    Pointer end = begin + HOOK_CONTEXT_COMMIT_SIZE;
+    if (end > block + HOOK_CONTEXT_RESERVE_SIZE)
+        end = block + HOOK_CONTEXT_RESERVE_SIZE;
+
+    if (VirtualAlloc((void*)begin, end - begin, MEM_COMMIT,
+                     PAGE_READWRITE) == nullptr)
+        return false;
+
+    for (Pointer i = (begin - block) / HOOK_CONTEXT_SIZE; i <= HOOK_MAX_CALLS;
+         i++)
+    {
+        Pointer contextIndex = block + (i + 1) * HOOK_CONTEXT_SIZE - sizeof(
+            Pointer);
+        if (contextIndex >= end)
+            break;
+        if (contextIndex >= begin)
+            *(Pointer*)contextIndex = i;
+    }
+
+    tls[TLS_STORAGE_HOOK_CONTEXT_COMMITTED] += end - begin;
+    InterlockedAdd64(&_hookContextCommitted, end - begin);
+    return true;
+}
+
+// Registered before anything else so the first touch of an uncommitted hook
+// context page is resolved before any other handler sees the fault.
+LONG WINAPI HookContextFilter(EXCEPTION_POINTERS* info)
+{
+    auto record = info->ExceptionRecord;
+    if (record->ExceptionCode != EXCEPTION_ACCESS_VIOLATION || record->
+        NumberParameters < 2)
+        return EXCEPTION_CONTINUE_SEARCH;
+
+    DWORD lastError = GetLastError();
+    auto tls = static_cast<Pointer*>(TlsGetValue(dwTlsIndex));
+    bool committed = tls != nullptr && CommitHookContext(
+        tls, (Pointer)record->ExceptionInformation[1]);
+    SetLastError(lastError);
+
+    return committed
+               ? EXCEPTION_CONTINUE_EXECUTION
+               : EXCEPTION_CONTINUE_SEARCH;
+}
+
 Pointer* GetExceptionDepthPointer()
 {
     Pointer* depth = nullptr;
@@ -232,81 +335,188 @@ Pointer* GetExceptionDepthPointer()
     return depth;
 }
 
-/*void _SetupPerformanceMonitor(void * begin, void * end)
+static Pointer _pmonFunctions[PMONMAXFUNCTIONS];
+static volatile LONG _pmonFunctionCount = 0;
+static volatile LONG _pmonEnabled = 0;
+static void* _pmonExitAddress = nullptr;
+static Pointer* volatile _pmonThreads = nullptr;
+
+// The per thread tables are never freed so they can still be written out after
+// the thread has exited.
+Pointer* _CreatePerformanceMonitor(Pointer* tls)
 {
-	Pointer begin_t = (Pointer)begin;
-	Pointer end_t = (Pointer)end;
+    auto pmon = static_cast<Pointer*>(calloc(PMON_SIZE, sizeof(Pointer)));
+    auto stack = calloc(PMONMAXSTACK * PMONFRAME_SIZE, sizeof(Pointer));
+    auto entries = calloc(PMONMAXFUNCTIONS * PMONENTRY_SIZE, sizeof(Pointer));
+    if (pmon == nullptr || stack == nullptr || entries == nullptr)
+    {
+        free(pmon);
+        free(stack);
+        free(entries);
+        return nullptr;
+    }
 
-	if (end_t <= begin_t)
-		return;
+    pmon[PMON_STACK] = (Pointer)stack;
+    pmon[PMON_ENTRIES] = (Pointer)entries;
+    pmon[PMON_THREAD] = GetCurrentThreadId();
 
-	Pointer count = end_t - begin_t;
-	auto tls = (Pointer*)TlsGetValue(dwTlsIndex);
-	if (tls == NULL)
-		return;
+    Pointer* next;
+    do
+    {
+        next = _pmonThreads;
+        pmon[PMON_NEXT] = (Pointer)next;
+    }
+    while (InterlockedCompareExchangePointer(
+        (void* volatile*)&_pmonThreads, pmon, next) != next);
 
-	Pointer * pmon = &tls[TLS_STORAGE_PERFORMANCE_MONITOR];
-	if (*pmon)
-		return;
+    tls[TLS_STORAGE_PERFORMANCE_MONITOR] = (Pointer)pmon;
+    return pmon;
+}
 
-	*pmon = (Pointer)AllocateC(PMON_SIZE * sizeof(Pointer), 0);
-	pmon = (Pointer*)(*pmon);
+static volatile LONG _hookStatEnabled = 0;
+static Pointer* volatile _hookStatThreads = nullptr;
 
-	pmon[PMON_DEPTH] = 0;
-	pmon[PMON_STACK] = (Pointer)AllocateC(PMONMAXSTACK * sizeof(Pointer), 0);
-	pmon[PMON_ENTRIES] = (Pointer)AllocateC(count * sizeof(Pointer) * PMONENTRY_SIZE, 0);
-	pmon[PMON_BEGIN] = begin_t;
-	pmon[PMON_END] = end_t;
+int64 HookStatisticsBegin()
+{
+    if (_hookStatEnabled == 0)
+        return 0;
 
-	for (Pointer i = 0; i < count; i++)
-	{
-		Pointer * entry = (Pointer*)(*((Pointer*)(pmon[PMON_ENTRIES] + sizeof(Pointer) * PMONENTRY_SIZE * i)));
-		entry[PMONENTRY_DEPTH] = 0;
-		entry[PMONENTRY_CURRENT_BEGIN] = 0;
-		entry[PMONENTRY_TOTAL_INCLUSIVE] = 0;
-		entry[PMONENTRY_TOTAL_EXCLUSIVE] = 0;
-	}
+    LARGE_INTEGER li;
+    QueryPerformanceCounter(&li);
+    return li.QuadPart;
 }
 
-void _FinishPerformanceMonitor()
+// Only the owning thread writes its table, readers may see a call that is
+// half recorded which is fine for statistics.
+void HookStatisticsEnd(int slot, int64 begin)
 {
-	auto tls = (Pointer*)TlsGetValue(dwTlsIndex);
-	if (tls == NULL)
-		return;
+    LARGE_INTEGER li;
+    QueryPerformanceCounter(&li);
 
-	Pointer * pmon = &tls[TLS_STORAGE_PERFORMANCE_MONITOR];
-	if (*pmon == 0)
-		return;
+    if (slot < 0 || slot >= HOOKSTAT_MAX_HOOKS)
+        return;
 
-	pmon = (Pointer*)(*pmon);
+    DWORD lastError = GetLastError();
+    auto tls = static_cast<Pointer*>(TlsGetValue(dwTlsIndex));
+    SetLastError(lastError);
+    if (tls == nullptr)
+        return;
 
-	Pointer begin_t = pmon[PMON_BEGIN];
-	Pointer end_t = pmon[PMON_END];
-	Pointer count = end_t - begin_t;
+    auto stat = (Pointer*)tls[TLS_STORAGE_HOOK_STATISTICS];
+    if (stat == nullptr)
+    {
+        stat = static_cast<Pointer*>(calloc(HOOKSTAT_SIZE, sizeof(Pointer)));
+        if (stat == nullptr)
+            return;
 
-	System::IO::StreamWriter^ f = gcnew System::IO::StreamWriter("pmon_thread_" + GetCurrentThreadId() + ".txt", false);
+        Pointer* next;
+        do
+        {
+            next = _hookStatThreads;
+            stat[HOOKSTAT_NEXT] = (Pointer)next;
+        }
+        while (InterlockedCompareExchangePointer(
+            (void* volatile*)&_hookStatThreads, stat, next) != next);
+        tls[TLS_STORAGE_HOOK_STATISTICS] = (Pointer)stat;
+    }
 
-	for (Pointer i = 0; i < count; i++)
-	{
-		Pointer * entry = (Pointer*)(*((Pointer*)(pmon[PMON_ENTRIES] + sizeof(Pointer) * PMONENTRY_SIZE * i)));
-		if (entry[PMONENTRY_TOTAL_INCLUSIVE] == 0)
-			continue;
-
-		System::Int64 addr = begin_t + i;
-		System::Int64 total_exc = pmon[PMONENTRY_TOTAL_EXCLUSIVE];
-		System::Int64 total_inc = pmon[PMONENTRY_TOTAL_INCLUSIVE];
-		f->WriteLine(addr.ToString("X") + " " + total_exc + " " + total_inc);
-	}
+    auto chunk = (Pointer*)stat[HOOKSTAT_CHUNKS + slot / HOOKSTAT_CHUNK_SIZE];
+    if (chunk == nullptr)
+    {
+        chunk = static_cast<Pointer*>(calloc(
+            HOOKSTAT_CHUNK_SIZE * HOOKSTATENTRY_SIZE, sizeof(Pointer)));
+        if (chunk == nullptr)
+            return;
+        InterlockedExchangePointer(
+            (void* volatile*)&stat[HOOKSTAT_CHUNKS + slot / HOOKSTAT_CHUNK_SIZE],
+            chunk);
+    }
+
+    Pointer* entry = chunk + (slot % HOOKSTAT_CHUNK_SIZE) * HOOKSTATENTRY_SIZE;
+    Pointer ticks = li.QuadPart - begin;
+
+    unsigned long bucket = 0;
+    if (ticks > 1)
+        _BitScanReverse64(&bucket, ticks);
+    if (bucket >= HOOKSTAT_BUCKETS)
+        bucket = HOOKSTAT_BUCKETS - 1;
+
+    entry[HOOKSTATENTRY_CALLS]++;
+    entry[HOOKSTATENTRY_TOTAL] += ticks;
+    if (ticks > entry[HOOKSTATENTRY_MAX])
+        entry[HOOKSTATENTRY_MAX] = ticks;
+    entry[HOOKSTATENTRY_BUCKETS + bucket]++;
+}
+
+// Called from the entry code of a monitored function. The return address of the
+// function is replaced so that we also get called when it exits.
+void PerformanceMonitorEnter(int slot, Pointer* returnAddress)
+{
+    if (_pmonEnabled == 0)
+        return;
+
+    DWORD lastError = GetLastError();
+    auto tls = static_cast<Pointer*>(TlsGetValue(dwTlsIndex));
+    Pointer* pmon = nullptr;
+    if (tls != nullptr)
+    {
+        pmon = (Pointer*)tls[TLS_STORAGE_PERFORMANCE_MONITOR];
+        if (pmon == nullptr)
+            pmon = _CreatePerformanceMonitor(tls);
+    }
+    SetLastError(lastError);
+
+    if (pmon == nullptr || pmon[PMON_DEPTH] >= PMONMAXSTACK)
+        return;
+
+    Pointer* frame = (Pointer*)pmon[PMON_STACK] + pmon[PMON_DEPTH] *
+        PMONFRAME_SIZE;
+    Pointer* entry = (Pointer*)pmon[PMON_ENTRIES] + slot * PMONENTRY_SIZE;
+
+    entry[PMONENTRY_DEPTH]++;
+    entry[PMONENTRY_CALLS]++;
+    pmon[PMON_DEPTH]++;
+
+    frame[PMONFRAME_SLOT] = slot;
+    frame[PMONFRAME_CHILD] = 0;
+    frame[PMONFRAME_RETURN] = *returnAddress;
+    *returnAddress = (Pointer)_pmonExitAddress;
+
+    LARGE_INTEGER li;
+    QueryPerformanceCounter(&li);
+    frame[PMONFRAME_BEGIN] = li.QuadPart;
+}
 
-	FreeC((void*)pmon[PMON_ENTRIES], false);
-	FreeC((void*)pmon[PMON_STACK], false);
-	FreeC((void*)pmon, false);
+// Called from the exit code when a monitored function returns. Returns the
+// original return address of the function.
+Pointer PerformanceMonitorExit()
+{
+    LARGE_INTEGER li;
+    QueryPerformanceCounter(&li);
+
+    DWORD lastError = GetLastError();
+    auto tls = static_cast<Pointer*>(TlsGetValue(dwTlsIndex));
+    SetLastError(lastError);
+
+    auto pmon = (Pointer*)tls[TLS_STORAGE_PERFORMANCE_MONITOR];
+    Pointer depth = --pmon[PMON_DEPTH];
+    Pointer* frame = (Pointer*)pmon[PMON_STACK] + depth * PMONFRAME_SIZE;
+    Pointer* entry = (Pointer*)pmon[PMON_ENTRIES] + frame[PMONFRAME_SLOT] *
+        PMONENTRY_SIZE;
 
-	tls[TLS_STORAGE_PERFORMANCE_MONITOR] = 0;
+    Pointer inclusive = li.QuadPart - frame[PMONFRAME_BEGIN];
+
+    // Recursive calls are already part of the outermost call.
+    if (--entry[PMONENTRY_DEPTH] == 0)
+        entry[PMONENTRY_TOTAL_INCLUSIVE] += inclusive;
+    entry[PMONENTRY_TOTAL_EXCLUSIVE] += inclusive - frame[PMONFRAME_CHILD];
+
+    if (depth > 0)
+        frame[PMONFRAME_CHILD - PMONFRAME_SIZE] += inclusive;
+
+    return frame[PMONFRAME_RETURN];
+}
 
-	f->Flush();
-	delete f;
-}*/
 
 extern "C" {
 EXPORT int64 GetTickCount64_Accurate()
@@ -693,6 +903,38 @@ EXPORT void* __stdcall InvokeCdeclD_addr()
     return InvokeCdeclD;
 }
 
+// Each record is function address, return type, argument count and then the
+// argument pairs prepared the same way as for InvokeCdecl.
+EXPORT int __stdcall InvokeBatch(Pointer* records, int count, Pointer* results)
+{
+    for (int i = 0; i < count; i++)
+    {
+        void* funcAddress = (void*)records[0];
+        Pointer returnType = records[1];
+        Pointer argCount = records[2];
+        void* argData = &records[3];
+        void* result;
+
+        switch (returnType)
+        {
+        case 1:
+            result = InvokeCdeclF(funcAddress, (void*)argCount, argData);
+            break;
+        case 2:
+            result = InvokeCdeclD(funcAddress, (void*)argCount, argData);
+            break;
+        default:
+            result = InvokeCdecl(funcAddress, (void*)argCount, argData);
+            break;
+        }
+
+        results[i] = (Pointer)result;
+        records += 3 + argCount * 2;
+    }
+
+    return count;
+}
+
 #pragma optimize( "", off )
 EXPORT void __stdcall ReadDQFrom(void* source, void* dest)
 {
@@ -1042,6 +1284,160 @@ EXPORT void* __stdcall GetCurrentTLSValue()
     return TlsGetValue(dwTlsIndex);
 }
 
+EXPORT void* __stdcall GetPerformanceMonitorEnterAddress()
+{
+    return PerformanceMonitorEnter;
+}
+
+EXPORT void* __stdcall GetPerformanceMonitorExitAddress()
+{
+    return PerformanceMonitorExit;
+}
+
+EXPORT void __stdcall SetPerformanceMonitorExitCode(void* address)
+{
+    _pmonExitAddress = address;
+}
+
+EXPORT int __stdcall AddPerformanceMonitorFunction(void* address)
+{
+    LONG slot = InterlockedIncrement(&_pmonFunctionCount) - 1;
+    if (slot >= PMONMAXFUNCTIONS)
+    {
+        InterlockedDecrement(&_pmonFunctionCount);
+        return -1;
+    }
+
+    _pmonFunctions[slot] = (Pointer)address;
+    return slot;
+}
+
+EXPORT void __stdcall SetPerformanceMonitorEnabled(bool enabled)
+{
+    InterlockedExchange(&_pmonEnabled, enabled ? 1 : 0);
+}
+
+// File layout, all values little endian:
+// "PMON", int version, int64 qpc frequency, int function count, int thread count,
+// int64 function address * function count,
+// per thread: int thread id, int entry count,
+//   per entry: int slot, int64 calls, int64 inclusive, int64 exclusive
+EXPORT int __stdcall WritePerformanceMonitor(const wchar_t* filePath)
+{
+    FILE* file = nullptr;
+    if (_wfopen_s(&file, filePath, L"wb") != 0 || file == nullptr)
+        return 0;
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    int version = PMONFILE_VERSION;
+    int functionCount = min(static_cast<int>(_pmonFunctionCount),
+                            PMONMAXFUNCTIONS);
+    int threadCount = 0;
+    for (auto pmon = _pmonThreads; pmon != nullptr; pmon = (Pointer*)pmon[
+             PMON_NEXT])
+        threadCount++;
+
+    fwrite("PMON", 1, 4, file);
+    fwrite(&version, sizeof(int), 1, file);
+    fwrite(&frequency.QuadPart, sizeof(int64), 1, file);
+    fwrite(&functionCount, sizeof(int), 1, file);
+    fwrite(&threadCount, sizeof(int), 1, file);
+    fwrite(_pmonFunctions, sizeof(Pointer), functionCount, file);
+
+    // Other threads may still be running monitored code, each value is read
+    // once so a record is at most one call behind.
+    auto pmon = _pmonThreads;
+    for (int i = 0; i < threadCount; i++, pmon = (Pointer*)pmon[PMON_NEXT])
+    {
+        auto entries = (Pointer*)pmon[PMON_ENTRIES];
+        int threadId = static_cast<int>(pmon[PMON_THREAD]);
+        int entryCount = 0;
+        for (int slot = 0; slot < functionCount; slot++)
+        {
+            if (entries[slot * PMONENTRY_SIZE + PMONENTRY_CALLS] != 0)
+                entryCount++;
+        }
+
+        fwrite(&threadId, sizeof(int), 1, file);
+        fwrite(&entryCount, sizeof(int), 1, file);
+        for (int slot = 0; slot < functionCount && entryCount > 0; slot++)
+        {
+            Pointer* entry = entries + slot * PMONENTRY_SIZE;
+            int64 values[3] = {
+                entry[PMONENTRY_CALLS], entry[PMONENTRY_TOTAL_INCLUSIVE],
+                entry[PMONENTRY_TOTAL_EXCLUSIVE]
+            };
+            if (values[0] == 0)
+                continue;
+
+            fwrite(&slot, sizeof(int), 1, file);
+            fwrite(values, sizeof(int64), 3, file);
+            entryCount--;
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+EXPORT void __stdcall SetHookStatisticsEnabled(bool enabled)
+{
+    InterlockedExchange(&_hookStatEnabled, enabled ? 1 : 0);
+}
+
+EXPORT int __stdcall GetHookStatisticsMaxHooks()
+{
+    return HOOKSTAT_MAX_HOOKS;
+}
+
+// Sums the statistics of a hook over all threads. Values are calls, total
+// ticks, max ticks and then the count of calls in each log2 tick bucket.
+EXPORT int __stdcall GetHookStatistics(int slot, int64* values, int count)
+{
+    if (slot < 0 || slot >= HOOKSTAT_MAX_HOOKS || count < HOOKSTATENTRY_SIZE)
+        return 0;
+
+    memset(values, 0, HOOKSTATENTRY_SIZE * sizeof(int64));
+    for (auto stat = _hookStatThreads; stat != nullptr; stat = (Pointer*)stat[
+             HOOKSTAT_NEXT])
+    {
+        auto chunk = (Pointer*)stat[HOOKSTAT_CHUNKS + slot / HOOKSTAT_CHUNK_SIZE];
+        if (chunk == nullptr)
+            continue;
+
+        Pointer* entry = chunk + (slot % HOOKSTAT_CHUNK_SIZE) *
+            HOOKSTATENTRY_SIZE;
+        for (int i = 0; i < HOOKSTATENTRY_SIZE; i++)
+        {
+            int64 value = entry[i];
+            if (i == HOOKSTATENTRY_MAX)
+                values[i] = max(values[i], value);
+            else
+                values[i] += value;
+        }
+    }
+
+    return HOOKSTATENTRY_SIZE;
+}
+
+EXPORT void __stdcall GetHookContextMemory(int64* committed, int64* reserved,
+                                           int64* highWater,
+                                           int64* totalCommitted,
+                                           int64* totalReserved)
+{
+    auto tls = static_cast<Pointer*>(TlsGetValue(dwTlsIndex));
+    *committed = tls != nullptr ? tls[TLS_STORAGE_HOOK_CONTEXT_COMMITTED] : 0;
+    *reserved = tls != nullptr && tls[TLS_STORAGE_HOOK_CONTEXT_BLOCK] != 0
+                    ? HOOK_CONTEXT_RESERVE_SIZE
+                    : 0;
+    *highWater = tls != nullptr ? tls[TLS_STORAGE_HOOK_HIGH_WATER] : 0;
+    *totalCommitted = InterlockedCompareExchange64(&_hookContextCommitted, 0,
+                                                   0);
+    *totalReserved = InterlockedCompareExchange64(&_hookContextReserved, 0, 0);
+}
+
 EXPORT int __stdcall MemoryCopy(unsigned char* source, int sourceIndex,
                                 unsigned char* destination,
                                 int destinationIndex, int length)
@@ -1069,6 +1465,37 @@ EXPORT int __stdcall MemoryCopy(unsigned char* source, int sourceIndex,
     return result;
 }
 
+// Entries are pairs of source address and size, the data of each entry is
+// written to destination right after the previous entry. Entries that can't be
+// read are zeroed and flagged in failed. Returns the count of failed entries.
+EXPORT int __stdcall MemoryGather(Pointer* entries, int count,
+                                  unsigned char* destination,
+                                  unsigned char* failed)
+{
+    int failedCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        auto source = (unsigned char*)entries[i * 2];
+        auto length = static_cast<size_t>(entries[i * 2 + 1]);
+
+        failed[i] = 0;
+        __try
+        {
+            memcpy(destination, source, length);
+        }
+        __except (1)
+        {
+            memset(destination, 0, length);
+            failed[i] = 1;
+            failedCount++;
+        }
+
+        destination += length;
+    }
+
+    return failedCount;
+}
+
 EXPORT int __stdcall MemoryReadInterlocked32(unsigned char* source,
                                              unsigned char* destination)
 {
@@ -1262,19 +1689,20 @@ void _ThreadStartTLS(bool allowEnterCLR)
         TLS_STORAGE_SIZE * sizeof(Pointer), 0));
     mainStorage[TLS_STORAGE_HOOK_CALL_COUNT] = 0;
 
-    void* contextBlock = AllocateC(
-        HOOK_CONTEXT_SIZE * (HOOK_MAX_CALLS + 1), 0);
-    for (Pointer i = 0; i < (HOOK_MAX_CALLS + 1); i++)
-    {
-        void* contextIndex = AddPtr(contextBlock,
-                                    (static_cast<int>(i) + 1) *
-                                    HOOK_CONTEXT_SIZE - sizeof(Pointer));
-        *static_cast<Pointer*>(contextIndex) = i;
-    }
+    // Only reserve here, HookContextFilter commits the pages and writes the
+    // verify indices when a hook first reaches them.
+    void* contextBlock = VirtualAlloc(nullptr, HOOK_CONTEXT_RESERVE_SIZE,
+                                      MEM_RESERVE, PAGE_READWRITE);
+    if (contextBlock != nullptr)
+        InterlockedAdd64(&_hookContextReserved, HOOK_CONTEXT_RESERVE_SIZE);
 
     mainStorage[TLS_STORAGE_HOOK_CONTEXT_BLOCK] = (Pointer)contextBlock;
+    mainStorage[TLS_STORAGE_HOOK_CONTEXT_COMMITTED] = 0;
+    mainStorage[TLS_STORAGE_HOOK_HIGH_WATER] = 0;
 
     mainStorage[TLS_STORAGE_EXCEPTION_DEPTH] = 0;
+    mainStorage[TLS_STORAGE_PERFORMANCE_MONITOR] = 0;
+    mainStorage[TLS_STORAGE_HOOK_STATISTICS] = 0;
 
     TlsSetValue(dwTlsIndex, mainStorage);
 
@@ -1294,7 +1722,15 @@ void _ThreadStopTLS(bool allowEnterCLR)
         void* contextBlock = (void*)mainStorage[
             TLS_STORAGE_HOOK_CONTEXT_BLOCK];
         if (contextBlock != nullptr)
-            FreeC(contextBlock, false);
+        {
+            InterlockedAdd64(&_hookContextCommitted,
+                             -mainStorage[TLS_STORAGE_HOOK_CONTEXT_COMMITTED]);
+            InterlockedAdd64(&_hookContextReserved,
+                             -HOOK_CONTEXT_RESERVE_SIZE);
+            VirtualFree(contextBlock, 0, MEM_RELEASE);
+            mainStorage[TLS_STORAGE_HOOK_CONTEXT_BLOCK] = 0;
+            mainStorage[TLS_STORAGE_HOOK_CONTEXT_COMMITTED] = 0;
+        }
     }
 }
 
@@ -2170,6 +2606,8 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved)
         {
             return FALSE;
         }
+        AddVectoredExceptionHandler(1, HookContextFilter);
+        crtti__CacheEnabled = crtti__InitializeCache();
         _ThreadStartTLS(false);
         break;
 
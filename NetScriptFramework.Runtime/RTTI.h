@@ -1,5 +1,6 @@
 #pragma once
 
+#pragma managed(push, off)
 #pragma pack (push, rttidata, 4)
 struct crtti__PMD
 {
@@ -41,17 +42,269 @@ const struct crtti__RTTICompleteObjectLocator
     int pBaseObject;
 };
 
+// Cast and explore results only depend on the vtable so they are cached by it.
+// Both tables are fixed size open addressing with a sequence lock per entry,
+// readers never wait and treat a torn or stale entry as a miss. Everything is
+// invalidated by bumping the generation when a module is loaded or unloaded
+// because vtable addresses may then be reused by a different type.
+#define RTTI_CACHE_BITS 14
+#define RTTI_CACHE_SIZE (1 << RTTI_CACHE_BITS)
+#define RTTI_EXPLORE_CACHE_BITS 11
+#define RTTI_EXPLORE_CACHE_SIZE (1 << RTTI_EXPLORE_CACHE_BITS)
+#define RTTI_EXPLORE_CACHE_MAX_BASES 32
+#define RTTI_CACHE_MAX_PROBE 8
+
+struct crtti__CastCacheEntry
+{
+    volatile LONG64 seq;
+    volatile LONG64 generation;
+    volatile Pointer vtable;
+    volatile Pointer module;
+    volatile LONG64 adjust;
+    volatile unsigned int target;
+    volatile int found;
+};
+
+struct crtti__ExploreCacheEntry
+{
+    volatile LONG64 seq;
+    volatile LONG64 generation;
+    volatile Pointer vtable;
+    volatile Pointer module;
+    volatile LONG64 baseAdjust;
+    volatile int count;
+    volatile unsigned int typeDescriptors[RTTI_EXPLORE_CACHE_MAX_BASES];
+    volatile int offsets[RTTI_EXPLORE_CACHE_MAX_BASES];
+};
+
+static crtti__CastCacheEntry crtti__CastCache[RTTI_CACHE_SIZE];
+static crtti__ExploreCacheEntry crtti__ExploreCache[RTTI_EXPLORE_CACHE_SIZE];
+static volatile LONG64 crtti__CacheGeneration = 1;
+
+typedef VOID (CALLBACK *crtti__DllNotificationFunction)(
+    ULONG reason, const void* data, PVOID context);
+typedef LONG (NTAPI *crtti__LdrRegisterDllNotification)(
+    ULONG flags, crtti__DllNotificationFunction callback, PVOID context,
+    PVOID* cookie);
+
+static VOID CALLBACK crtti__OnDllNotification(ULONG reason, const void* data,
+                                              PVOID context)
+{
+    // Runs under the loader lock, don't do anything else here.
+    InterlockedIncrement64(&crtti__CacheGeneration);
+}
+
+/*
+Registers for module load notifications so cached results are dropped when the
+address space changes. If this is not available the caches are never used.
+*/
+static bool crtti__InitializeCache()
+{
+    HMODULE ntdll = GetModuleHandleA("ntdll.dll");
+    if (ntdll == nullptr)
+        return false;
+
+    crtti__LdrRegisterDllNotification func = (
+        crtti__LdrRegisterDllNotification)GetProcAddress(
+        ntdll, "LdrRegisterDllNotification");
+    if (func == nullptr)
+        return false;
+
+    PVOID cookie = nullptr;
+    if (func(0, crtti__OnDllNotification, nullptr, &cookie) != 0)
+        return false;
+
+    return true;
+}
+
+static bool crtti__CacheEnabled = false;
+
+static unsigned int crtti__Hash(Pointer vtable, Pointer module,
+                                unsigned int target, int bits)
+{
+    unsigned __int64 key = (unsigned __int64)vtable ^ ((unsigned __int64)
+        module << 7) ^ ((unsigned __int64)target * 0x9E3779B9ull);
+    return (unsigned int)((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+static bool crtti__TryLock(volatile LONG64* seq, LONG64* prev)
+{
+    LONG64 s = *seq;
+    if ((s & 1) != 0)
+        return false;
+    if (InterlockedCompareExchange64(seq, s + 1, s) != s)
+        return false;
+    *prev = s;
+    return true;
+}
+
+static bool crtti__FindCast(Pointer vtable, unsigned int target, Pointer module,
+                            bool* found, LONG64* adjust)
+{
+    if (!crtti__CacheEnabled)
+        return false;
+
+    LONG64 generation = crtti__CacheGeneration;
+    unsigned int index = crtti__Hash(vtable, module, target, RTTI_CACHE_BITS);
+    for (int i = 0; i < RTTI_CACHE_MAX_PROBE; i++)
+    {
+        crtti__CastCacheEntry* e = &crtti__CastCache[(index + i) & (
+            RTTI_CACHE_SIZE - 1)];
+        LONG64 s = e->seq;
+        if (s == 0)
+            return false;
+        if ((s & 1) != 0)
+            continue;
+
+        bool match = e->vtable == vtable && e->target == target && e->module ==
+            module && e->generation == generation;
+        int f = e->found;
+        LONG64 a = e->adjust;
+        if (e->seq != s)
+            continue;
+        if (!match)
+            continue;
+
+        *found = f != 0;
+        *adjust = a;
+        return true;
+    }
+
+    return false;
+}
+
+static void crtti__StoreCast(Pointer vtable, unsigned int target,
+                             Pointer module, bool found, LONG64 adjust)
+{
+    if (!crtti__CacheEnabled)
+        return;
+
+    LONG64 generation = crtti__CacheGeneration;
+    unsigned int index = crtti__Hash(vtable, module, target, RTTI_CACHE_BITS);
+
+    // Prefer a free or stale slot in the probe window, otherwise evict the first.
+    crtti__CastCacheEntry* e = &crtti__CastCache[index];
+    for (int i = 0; i < RTTI_CACHE_MAX_PROBE; i++)
+    {
+        crtti__CastCacheEntry* c = &crtti__CastCache[(index + i) & (
+            RTTI_CACHE_SIZE - 1)];
+        if (c->seq == 0 || c->generation != generation)
+        {
+            e = c;
+            break;
+        }
+    }
+
+    LONG64 prev = 0;
+    if (!crtti__TryLock(&e->seq, &prev))
+        return;
+
+    e->vtable = vtable;
+    e->module = module;
+    e->target = target;
+    e->found = found ? 1 : 0;
+    e->adjust = adjust;
+    e->generation = generation;
+    InterlockedExchange64(&e->seq, prev + 2);
+}
+
+static bool crtti__FindExplore(Pointer vtable, Pointer obj, Pointer module,
+                               Pointer* baseObj, Pointer* data,
+                               int maxDataCount)
+{
+    if (!crtti__CacheEnabled)
+        return false;
+
+    LONG64 generation = crtti__CacheGeneration;
+    unsigned int index = crtti__Hash(vtable, module, 0,
+                                     RTTI_EXPLORE_CACHE_BITS);
+    for (int i = 0; i < RTTI_CACHE_MAX_PROBE; i++)
+    {
+        crtti__ExploreCacheEntry* e = &crtti__ExploreCache[(index + i) & (
+            RTTI_EXPLORE_CACHE_SIZE - 1)];
+        LONG64 s = e->seq;
+        if (s == 0)
+            return false;
+        if ((s & 1) != 0)
+            continue;
+        if (e->vtable != vtable || e->module != module || e->generation !=
+            generation)
+            continue;
+
+        // Same truncation behavior as the uncached explore.
+        int count = e->count;
+        if (count < 0 || count > RTTI_EXPLORE_CACHE_MAX_BASES)
+            continue;
+        bool truncated = count * 2 > maxDataCount;
+        int n = truncated ? maxDataCount / 2 : count;
+        for (int j = 0; j < n; j++)
+        {
+            data[j * 2] = e->typeDescriptors[j];
+            data[j * 2 + 1] = e->offsets[j];
+        }
+        LONG64 baseAdjust = e->baseAdjust;
+        if (e->seq != s)
+            continue;
+
+        *baseObj = truncated ? 0 : obj + (Pointer)baseAdjust;
+        return true;
+    }
+
+    return false;
+}
+
+static void crtti__StoreExplore(Pointer vtable, Pointer module,
+                                LONG64 baseAdjust, Pointer* data, int count)
+{
+    if (!crtti__CacheEnabled || count > RTTI_EXPLORE_CACHE_MAX_BASES)
+        return;
+
+    LONG64 generation = crtti__CacheGeneration;
+    unsigned int index = crtti__Hash(vtable, module, 0,
+                                     RTTI_EXPLORE_CACHE_BITS);
+
+    crtti__ExploreCacheEntry* e = &crtti__ExploreCache[index];
+    for (int i = 0; i < RTTI_CACHE_MAX_PROBE; i++)
+    {
+        crtti__ExploreCacheEntry* c = &crtti__ExploreCache[(index + i) & (
+            RTTI_EXPLORE_CACHE_SIZE - 1)];
+        if (c->seq == 0 || c->generation != generation)
+        {
+            e = c;
+            break;
+        }
+    }
+
+    LONG64 prev = 0;
+    if (!crtti__TryLock(&e->seq, &prev))
+        return;
+
+    e->vtable = vtable;
+    e->module = module;
+    e->baseAdjust = baseAdjust;
+    e->count = count;
+    for (int j = 0; j < count; j++)
+    {
+        e->typeDescriptors[j] = (unsigned int)data[j * 2];
+        e->offsets[j] = (int)data[j * 2 + 1];
+    }
+    e->generation = generation;
+    InterlockedExchange64(&e->seq, prev + 2);
+}
+
 /*
 _obj = actual pointer of object where *_obj is vtable
 _target = RTTI target value WITHOUT the base module address
 _module = base address of module we are looking in
 */
-void* crtti__RTDynamicCast(void* _obj, unsigned int _target, void* _module)
+static void* crtti__RTDynamicCastSlow(void* _obj, unsigned int _target,
+                                      void* _module, bool* resolved)
 {
     Pointer module = (Pointer)_module;
     Pointer obj = (Pointer)_obj;
 
     void* result = nullptr;
+    *resolved = false;
 
     __try
     {
@@ -101,6 +354,8 @@ void* crtti__RTDynamicCast(void* _obj, unsigned int _target, void* _module)
                 }
             }
         }
+
+        *resolved = true;
     }
     __except (1)
     {
@@ -109,12 +364,50 @@ void* crtti__RTDynamicCast(void* _obj, unsigned int _target, void* _module)
     return result;
 }
 
-void crtti__Explore(void* _obj, Pointer* baseObj, Pointer* data,
-                    int maxDataCount, void* _module)
+/*
+Same as crtti__RTDynamicCastSlow but the result is cached by vtable so repeated
+casts of the same type are a single hash probe. Only the vtable pointer of the
+object is read on a cache hit.
+*/
+void* crtti__RTDynamicCast(void* _obj, unsigned int _target, void* _module)
+{
+    Pointer vtable = 0;
+    __try
+    {
+        vtable = *((Pointer*)_obj);
+    }
+    __except (1)
+    {
+        return nullptr;
+    }
+
+    bool found = false;
+    LONG64 adjust = 0;
+    if (crtti__FindCast(vtable, _target, (Pointer)_module, &found, &adjust))
+        return found ? (void*)((Pointer)_obj + (Pointer)adjust) : nullptr;
+
+    bool resolved = false;
+    void* result = crtti__RTDynamicCastSlow(_obj, _target, _module, &resolved);
+    if (resolved)
+    {
+        crtti__StoreCast(vtable, _target, (Pointer)_module, result != nullptr,
+                         result != nullptr
+                             ? (LONG64)((Pointer)result - (Pointer)_obj)
+                             : 0);
+    }
+
+    return result;
+}
+
+static void crtti__ExploreSlow(void* _obj, Pointer* baseObj, Pointer* data,
+                              int maxDataCount, void* _module, int* count)
 {
     Pointer module = (Pointer)_module;
     Pointer obj = (Pointer)_obj;
 
+    // Stays -1 unless the whole hierarchy was written.
+    *count = -1;
+
     __try
     {
         Pointer vtable = *((Pointer*)obj);
@@ -138,6 +431,7 @@ void crtti__Explore(void* _obj, Pointer* baseObj, Pointer* data,
 
         *baseObj = obj;
 
+        int written = 0;
         if (loc->pClassDescriptor != 0)
         {
             int szEntry = 2;
@@ -166,14 +460,49 @@ void crtti__Explore(void* _obj, Pointer* baseObj, Pointer* data,
                         pTypeDescriptor;
                     data[i * szEntry + 1] = base->where.
                                                   mdisp;
+                    written++;
                 }
             }
         }
+
+        if (*baseObj != 0)
+            *count = written;
+    }
+    __except (1)
+    {
+        *baseObj = 0;
+    }
+}
+
+/*
+Same as crtti__ExploreSlow but the hierarchy is memoized by vtable.
+*/
+void crtti__Explore(void* _obj, Pointer* baseObj, Pointer* data,
+                    int maxDataCount, void* _module)
+{
+    Pointer vtable = 0;
+    __try
+    {
+        vtable = *((Pointer*)_obj);
     }
     __except (1)
     {
         *baseObj = 0;
+        return;
+    }
+
+    if (crtti__FindExplore(vtable, (Pointer)_obj, (Pointer)_module, baseObj,
+                           data, maxDataCount))
+        return;
+
+    int count = -1;
+    crtti__ExploreSlow(_obj, baseObj, data, maxDataCount, _module, &count);
+    if (count >= 0)
+    {
+        crtti__StoreExplore(vtable, (Pointer)_module,
+                            (LONG64)(*baseObj - (Pointer)_obj), data, count);
     }
 }
 
 #pragma pack (pop, rttidata)
+#pragma managed(pop)
@@ -1065,20 +1065,22 @@ namespace NetScriptFramework
                 Event<BarterMenuEventArgs ^> ^get() { return __handler_BarterMenu; }
             }
         private :
-            static BarterMenuEventArgs ^__before_BarterMenu_1(CPURegisters ^ctx)
+            static BarterMenuEventArgs ^__before_BarterMenu_1(CPURegisters ^ctx, BarterMenuEventArgs ^args)
             {
-                BarterMenuEventArgs ^args = gcnew BarterMenuEventArgs();
+                if(args == nullptr)
+                    args = gcnew BarterMenuEventArgs();
                 args->Entering            = true;
-                args->RefHandle           = Memory::ReadUInt32(__VIDS::VID519283.Value, false);
+                args->RefHandle           = MCH::ReadUInt32(__VIDS::VID519283.Value);
                 return args;
             }
 
         private :
-            static BarterMenuEventArgs ^__before_BarterMenu_2(CPURegisters ^ctx)
+            static BarterMenuEventArgs ^__before_BarterMenu_2(CPURegisters ^ctx, BarterMenuEventArgs ^args)
             {
-                BarterMenuEventArgs ^args = gcnew BarterMenuEventArgs();
+                if(args == nullptr)
+                    args = gcnew BarterMenuEventArgs();
                 args->Entering            = false;
-                args->RefHandle           = Memory::ReadUInt32(__VIDS::VID519283.Value, false);
+                args->RefHandle           = MCH::ReadUInt32(__VIDS::VID519283.Value);
                 return args;
             }
 
@@ -1097,13 +1099,14 @@ namespace NetScriptFramework
                 Event<CalculateDetectionEventArgs ^> ^get() { return __handler_CalculateDetection; }
             }
         private :
-            static CalculateDetectionEventArgs ^__before_CalculateDetection(CPURegisters ^ctx)
+            static CalculateDetectionEventArgs ^__before_CalculateDetection(CPURegisters ^ctx, CalculateDetectionEventArgs ^args)
             {
-                CalculateDetectionEventArgs ^args = gcnew CalculateDetectionEventArgs();
-                args->SourceActor                 = MemoryObject::FromAddress<Actor ^>(Memory::ReadPointer(ctx->SP + 0x70, false));
+                if(args == nullptr)
+                    args = gcnew CalculateDetectionEventArgs();
+                args->SourceActor                 = MemoryObject::FromAddress<Actor ^>(MCH::ReadPointer(ctx->SP + 0x70));
                 args->TargetActor                 = MemoryObject::FromAddress<Actor ^>(ctx->BX);
-                args->ResultValue                 = Memory::ReadInt32(ctx->BP + 0xD0, false);
-                args->Position                    = MemoryObject::FromAddress<NiPoint3 ^>(Memory::ReadPointer(ctx->BP - 0x68, false));
+                args->ResultValue                 = MCH::ReadInt32(ctx->BP + 0xD0);
+                args->Position                    = MemoryObject::FromAddress<NiPoint3 ^>(MCH::ReadPointer(ctx->BP - 0x68));
                 return args;
             }
 
@@ -1113,7 +1116,7 @@ namespace NetScriptFramework
                 int val = args->ResultValue;
                 if(val < -1000)
                     val = -1000;
-                Memory::WriteInt32(ctx->BP + 0xD0, val, false);
+                MCH::WriteInt32(ctx->BP + 0xD0, val);
             }
 
         private:
@@ -1131,9 +1134,10 @@ namespace NetScriptFramework
                 Event<CalculateFormGoldValueEventArgs ^> ^get() { return __handler_CalculateFormGoldValue; }
             }
         private :
-            static CalculateFormGoldValueEventArgs ^__before_CalculateFormGoldValue_1(CPURegisters ^ctx)
+            static CalculateFormGoldValueEventArgs ^__before_CalculateFormGoldValue_1(CPURegisters ^ctx, CalculateFormGoldValueEventArgs ^args)
             {
-                CalculateFormGoldValueEventArgs ^args = gcnew CalculateFormGoldValueEventArgs();
+                if(args == nullptr)
+                    args = gcnew CalculateFormGoldValueEventArgs();
                 args->Value                           = static_cast<int>(ctx->AX.ToInt64());
                 args->OriginalValue                   = args->Value;
                 args->Form                            = MemoryObject::FromAddress<TESForm ^>(ctx->BX);
@@ -1148,9 +1152,10 @@ namespace NetScriptFramework
             }
 
         private:
-            static CalculateFormGoldValueEventArgs ^__before_CalculateFormGoldValue_2(CPURegisters ^ctx)
+            static CalculateFormGoldValueEventArgs ^__before_CalculateFormGoldValue_2(CPURegisters ^ctx, CalculateFormGoldValueEventArgs ^args)
             {
-                CalculateFormGoldValueEventArgs ^args = gcnew CalculateFormGoldValueEventArgs();
+                if(args == nullptr)
+                    args = gcnew CalculateFormGoldValueEventArgs();
                 args->Value                           = static_cast<int>(ctx->AX.ToInt64());
                 args->OriginalValue                   = args->Value;
                 args->Form                            = MemoryObject::FromAddress<TESForm ^>(ctx->BX);
@@ -1165,9 +1170,10 @@ namespace NetScriptFramework
             }
 
         private:
-            static CalculateFormGoldValueEventArgs ^__before_CalculateFormGoldValue_3(CPURegisters ^ctx)
+            static CalculateFormGoldValueEventArgs ^__before_CalculateFormGoldValue_3(CPURegisters ^ctx, CalculateFormGoldValueEventArgs ^args)
             {
-                CalculateFormGoldValueEventArgs ^args = gcnew CalculateFormGoldValueEventArgs();
+                if(args == nullptr)
+                    args = gcnew CalculateFormGoldValueEventArgs();
                 args->Value                           = static_cast<int>(ctx->AX.ToInt64());
                 args->OriginalValue                   = args->Value;
                 args->Form                            = MemoryObject::FromAddress<TESForm ^>(ctx->BX);
@@ -1197,10 +1203,12 @@ namespace NetScriptFramework
                 Event<CameraStateChangingEventArgs ^> ^get() { return __handler_CameraStateChanging; }
             }
         private :
-            static CameraStateChangingEventArgs ^__before_CameraStateChanging(CPURegisters ^ctx)
+            static CameraStateChangingEventArgs ^__before_CameraStateChanging(CPURegisters ^ctx, CameraStateChangingEventArgs ^args)
             {
-                CameraStateChangingEventArgs ^args = gcnew CameraStateChangingEventArgs();
+                if(args == nullptr)
+                    args = gcnew CameraStateChangingEventArgs();
                 args->Camera                       = MemoryObject::FromAddress<TESCamera ^>(ctx->CX);
+                args->PreviousState                = nullptr;
                 if(args->Camera != nullptr)
                     args->PreviousState = args->Camera->State;
                 args->NextState = MemoryObject::FromAddress<TESCameraState ^>(ctx->DX);
@@ -1232,9 +1240,10 @@ namespace NetScriptFramework
                 Event<FrameEventArgs ^> ^get() { return __handler_Frame; }
             }
         private :
-            static FrameEventArgs ^__before_Frame(CPURegisters ^ctx)
+            static FrameEventArgs ^__before_Frame(CPURegisters ^ctx, FrameEventArgs ^args)
             {
-                FrameEventArgs ^args = gcnew FrameEventArgs();
+                if(args == nullptr)
+                    args = gcnew FrameEventArgs();
                 return args;
             }
 
@@ -1253,11 +1262,12 @@ namespace NetScriptFramework
                 Event<GainLevelXPEventArgs ^> ^get() { return __handler_GainLevelXP; }
             }
         private :
-            static GainLevelXPEventArgs ^__before_GainLevelXP(CPURegisters ^ctx)
+            static GainLevelXPEventArgs ^__before_GainLevelXP(CPURegisters ^ctx, GainLevelXPEventArgs ^args)
             {
-                GainLevelXPEventArgs ^args = gcnew GainLevelXPEventArgs();
+                if(args == nullptr)
+                    args = gcnew GainLevelXPEventArgs();
                 args->Skill                = static_cast<ActorValueIndices>(static_cast<int>(ctx->SI.ToInt64()));
-                auto fromPtr               = Memory::ReadPointer(ctx->SP + 0x178, false);
+                auto fromPtr               = MCH::ReadPointer(ctx->SP + 0x178);
                 args->IsFromTrainingOrBook = (fromPtr == __VIDS::VID40555.Value + 0x9E) || (fromPtr == GainSkillXPEventArgs::__uncapperCompatibility);
                 args->OriginalAmount       = ctx->XMM0f;
                 args->Amount               = args->OriginalAmount;
@@ -1286,9 +1296,10 @@ namespace NetScriptFramework
                 Event<GainSkillXPEventArgs ^> ^get() { return __handler_GainSkillXP; }
             }
         private :
-            static GainSkillXPEventArgs ^__before_GainSkillXP(CPURegisters ^ctx)
+            static GainSkillXPEventArgs ^__before_GainSkillXP(CPURegisters ^ctx, GainSkillXPEventArgs ^args)
             {
-                GainSkillXPEventArgs ^args = gcnew GainSkillXPEventArgs();
+                if(args == nullptr)
+                    args = gcnew GainSkillXPEventArgs();
                 if(!GainSkillXPEventArgs::__uncapperChecked)
                 {
                     GainSkillXPEventArgs::__uncapperChecked = true;
@@ -1309,12 +1320,12 @@ namespace NetScriptFramework
                     GainSkillXPEventArgs::__uncapperCompatibility = uncapperPtr;
                 }
 
-                args->BaseAmount           = Memory::ReadFloat(ctx->SP + 0x188, false);
+                args->BaseAmount           = MCH::ReadFloat(ctx->SP + 0x188);
                 args->Skill                = static_cast<ActorValueIndices>(static_cast<int>(ctx->SI.ToInt64()));
-                auto fromPtr               = Memory::ReadPointer(ctx->SP + 0x178, false);
+                auto fromPtr               = MCH::ReadPointer(ctx->SP + 0x178);
                 args->IsFromTrainingOrBook = (fromPtr == __VIDS::VID40555.Value + 0x9E) || (fromPtr == GainSkillXPEventArgs::__uncapperCompatibility);
                 Memory::InvokeCdecl(__VIDS::VID23073.Value, ctx->CX, ctx->DX, ctx->R8, ctx->R9);
-                args->OriginalAmount = Memory::ReadFloat(ctx->SP + 0x188, false);
+                args->OriginalAmount = MCH::ReadFloat(ctx->SP + 0x188);
                 args->Amount         = args->OriginalAmount;
                 return args;
             }
@@ -1323,7 +1334,7 @@ namespace NetScriptFramework
             static void __after_GainSkillXP(CPURegisters ^ctx, GainSkillXPEventArgs ^args)
             {
                 if(args->Amount != args->OriginalAmount)
-                    Memory::WriteFloat(ctx->SP + 0x188, args->Amount, false);
+                    MCH::WriteFloat(ctx->SP + 0x188, args->Amount);
             }
 
         private:
@@ -1341,9 +1352,10 @@ namespace NetScriptFramework
                 Event<InterruptCastEventArgs ^> ^get() { return __handler_InterruptCast; }
             }
         private :
-            static InterruptCastEventArgs ^__before_InterruptCast(CPURegisters ^ctx)
+            static InterruptCastEventArgs ^__before_InterruptCast(CPURegisters ^ctx, InterruptCastEventArgs ^args)
             {
-                InterruptCastEventArgs ^args = gcnew InterruptCastEventArgs();
+                if(args == nullptr)
+                    args = gcnew InterruptCastEventArgs();
                 args->Caster                 = MemoryObject::FromAddress<MagicCaster ^>(ctx->BX);
                 return args;
             }
@@ -1363,9 +1375,10 @@ namespace NetScriptFramework
                 Event<MagicCasterFireEventArgs ^> ^get() { return __handler_MagicCasterFire; }
             }
         private :
-            static MagicCasterFireEventArgs ^__before_MagicCasterFire(CPURegisters ^ctx)
+            static MagicCasterFireEventArgs ^__before_MagicCasterFire(CPURegisters ^ctx, MagicCasterFireEventArgs ^args)
             {
-                MagicCasterFireEventArgs ^args = gcnew MagicCasterFireEventArgs();
+                if(args == nullptr)
+                    args = gcnew MagicCasterFireEventArgs();
                 args->Caster                   = MemoryObject::FromAddress<MagicCaster ^>(ctx->DI);
                 args->Item                     = MemoryObject::FromAddress<MagicItem ^>(ctx->SI);
                 return args;
@@ -1389,17 +1402,19 @@ namespace NetScriptFramework
                 Event<MainMenuEventArgs ^> ^get() { return __handler_MainMenu; }
             }
         private :
-            static MainMenuEventArgs ^__before_MainMenu_1(CPURegisters ^ctx)
+            static MainMenuEventArgs ^__before_MainMenu_1(CPURegisters ^ctx, MainMenuEventArgs ^args)
             {
-                MainMenuEventArgs ^args = gcnew MainMenuEventArgs();
+                if(args == nullptr)
+                    args = gcnew MainMenuEventArgs();
                 args->Entering          = false;
                 return args;
             }
 
         private :
-            static MainMenuEventArgs ^__before_MainMenu_2(CPURegisters ^ctx)
+            static MainMenuEventArgs ^__before_MainMenu_2(CPURegisters ^ctx, MainMenuEventArgs ^args)
             {
-                MainMenuEventArgs ^args = gcnew MainMenuEventArgs();
+                if(args == nullptr)
+                    args = gcnew MainMenuEventArgs();
                 args->Entering          = true;
                 return args;
             }
@@ -1420,9 +1435,10 @@ namespace NetScriptFramework
                 Event<ReduceHUDAmmoCounterEventArgs ^> ^get() { return __handler_ReduceHUDAmmoCounter; }
             }
         private :
-            static ReduceHUDAmmoCounterEventArgs ^__before_ReduceHUDAmmoCounter(CPURegisters ^ctx)
+            static ReduceHUDAmmoCounterEventArgs ^__before_ReduceHUDAmmoCounter(CPURegisters ^ctx, ReduceHUDAmmoCounterEventArgs ^args)
             {
-                ReduceHUDAmmoCounterEventArgs ^args = gcnew ReduceHUDAmmoCounterEventArgs();
+                if(args == nullptr)
+                    args = gcnew ReduceHUDAmmoCounterEventArgs();
                 args->HasAmount                     = static_cast<int>(MCH::u(ctx->AX) & 0xFFFFFFFF);
                 args->Item                          = MemoryObject::FromAddress<ExtraContainerChanges::ItemEntry ^>(ctx->R14);
                 args->ReduceAmount                  = 1;
@@ -1452,9 +1468,10 @@ namespace NetScriptFramework
                 Event<RemoveMagicEffectsWithArchetypeEventArgs ^> ^get() { return __handler_RemoveMagicEffectsWithArchetype; }
             }
         private :
-            static RemoveMagicEffectsWithArchetypeEventArgs ^__before_RemoveMagicEffectsWithArchetype_1(CPURegisters ^ctx)
+            static RemoveMagicEffectsWithArchetypeEventArgs ^__before_RemoveMagicEffectsWithArchetype_1(CPURegisters ^ctx, RemoveMagicEffectsWithArchetypeEventArgs ^args)
             {
-                RemoveMagicEffectsWithArchetypeEventArgs ^args = gcnew RemoveMagicEffectsWithArchetypeEventArgs();
+                if(args == nullptr)
+                    args = gcnew RemoveMagicEffectsWithArchetypeEventArgs();
                 args->Owner                                    = MemoryObject::FromAddress<Actor ^>(ctx->BX);
                 args->Reason                                   = MagicEffectRemovalReasons::Unknown;
                 args->Archetype                                = static_cast<Archetypes>(MCH::u(ctx->DX) & 0xFFFFFFFF);
@@ -1462,7 +1479,7 @@ namespace NetScriptFramework
                 auto debug                                     = NetScriptFramework::Main::GameInfo;
                 if(debug != nullptr)
                 {
-                    auto fromPtr = Memory::ReadPointer(ctx->SP + 0x28, false);
+                    auto fromPtr = MCH::ReadPointer(ctx->SP + 0x28);
                     auto fn      = debug->GetFunctionInfo(fromPtr, true);
                     if(fn != nullptr)
                     {
@@ -1492,9 +1509,10 @@ namespace NetScriptFramework
             }
 
         private:
-            static RemoveMagicEffectsWithArchetypeEventArgs ^__before_RemoveMagicEffectsWithArchetype_2(CPURegisters ^ctx)
+            static RemoveMagicEffectsWithArchetypeEventArgs ^__before_RemoveMagicEffectsWithArchetype_2(CPURegisters ^ctx, RemoveMagicEffectsWithArchetypeEventArgs ^args)
             {
-                RemoveMagicEffectsWithArchetypeEventArgs ^args = gcnew RemoveMagicEffectsWithArchetypeEventArgs();
+                if(args == nullptr)
+                    args = gcnew RemoveMagicEffectsWithArchetypeEventArgs();
                 args->Owner                                    = MemoryObject::FromAddress<Actor ^>(ctx->BX);
                 args->Reason                                   = MagicEffectRemovalReasons::Unknown;
                 args->Archetype                                = static_cast<Archetypes>(MCH::u(ctx->DX) & 0xFFFFFFFF);
@@ -1502,7 +1520,7 @@ namespace NetScriptFramework
                 auto debug                                     = NetScriptFramework::Main::GameInfo;
                 if(debug != nullptr)
                 {
-                    auto fromPtr = Memory::ReadPointer(ctx->SP + 0x28, false);
+                    auto fromPtr = MCH::ReadPointer(ctx->SP + 0x28);
                     auto fn      = debug->GetFunctionInfo(fromPtr, true);
                     if(fn != nullptr)
                     {
@@ -1532,9 +1550,10 @@ namespace NetScriptFramework
             }
 
         private:
-            static RemoveMagicEffectsWithArchetypeEventArgs ^__before_RemoveMagicEffectsWithArchetype_3(CPURegisters ^ctx)
+            static RemoveMagicEffectsWithArchetypeEventArgs ^__before_RemoveMagicEffectsWithArchetype_3(CPURegisters ^ctx, RemoveMagicEffectsWithArchetypeEventArgs ^args)
             {
-                RemoveMagicEffectsWithArchetypeEventArgs ^args = gcnew RemoveMagicEffectsWithArchetypeEventArgs();
+                if(args == nullptr)
+                    args = gcnew RemoveMagicEffectsWithArchetypeEventArgs();
                 args->Owner                                    = MemoryObject::FromAddress<Actor ^>(ctx->DI);
                 args->Reason                                   = MagicEffectRemovalReasons::Attacked;
                 args->Archetype                                = static_cast<Archetypes>(MCH::u(ctx->DX) & 0xFFFFFFFF);
@@ -1564,9 +1583,11 @@ namespace NetScriptFramework
                 Event<ShadowCullingBeginEventArgs ^> ^get() { return __handler_ShadowCullingBegin; }
             }
         private :
-            static ShadowCullingBeginEventArgs ^__before_ShadowCullingBegin(CPURegisters ^ctx)
+            static ShadowCullingBeginEventArgs ^__before_ShadowCullingBegin(CPURegisters ^ctx, ShadowCullingBeginEventArgs ^args)
             {
-                ShadowCullingBeginEventArgs ^args = gcnew ShadowCullingBeginEventArgs();
+                if(args == nullptr)
+                    args = gcnew ShadowCullingBeginEventArgs();
+                args->Separate = false;
                 return args;
             }
 
@@ -1578,7 +1599,7 @@ namespace NetScriptFramework
                 else
                 {
                     ShadowCullingBeginEventArgs::__state = 0;
-                    auto ptr                             = Memory::ReadPointer(__VIDS::VID527999.Value, false);
+                    auto ptr                             = MCH::ReadPointer(__VIDS::VID527999.Value);
                     Memory::InvokeCdecl(__VIDS::VID67991.Value, ptr, 0, 0);
                 }
                 Memory::InvokeCdecl(__VIDS::VID100419.Value);
@@ -1599,9 +1620,10 @@ namespace NetScriptFramework
                 Event<ShadowCullingEndEventArgs ^> ^get() { return __handler_ShadowCullingEnd; }
             }
         private :
-            static ShadowCullingEndEventArgs ^__before_ShadowCullingEnd(CPURegisters ^ctx)
+            static ShadowCullingEndEventArgs ^__before_ShadowCullingEnd(CPURegisters ^ctx, ShadowCullingEndEventArgs ^args)
             {
-                ShadowCullingEndEventArgs ^args = gcnew ShadowCullingEndEventArgs();
+                if(args == nullptr)
+                    args = gcnew ShadowCullingEndEventArgs();
                 args->Separate                  = ShadowCullingBeginEventArgs::__state != 0;
                 return args;
             }
@@ -1609,7 +1631,7 @@ namespace NetScriptFramework
         private :
             static void __after_ShadowCullingEnd(CPURegisters ^ctx, ShadowCullingEndEventArgs ^args)
             {
-                auto ptr = Memory::ReadPointer(__VIDS::VID527999.Value, false);
+                auto ptr = MCH::ReadPointer(__VIDS::VID527999.Value);
                 if(args->Separate)
                     Memory::InvokeCdecl(__VIDS::VID67991.Value, ptr, 0, 0);
                 Memory::InvokeCdecl(__VIDS::VID67992.Value, ptr);
@@ -1630,9 +1652,10 @@ namespace NetScriptFramework
                 Event<SpendAmmoEventArgs ^> ^get() { return __handler_SpendAmmo; }
             }
         private :
-            static SpendAmmoEventArgs ^__before_SpendAmmo(CPURegisters ^ctx)
+            static SpendAmmoEventArgs ^__before_SpendAmmo(CPURegisters ^ctx, SpendAmmoEventArgs ^args)
             {
-                SpendAmmoEventArgs ^args = gcnew SpendAmmoEventArgs();
+                if(args == nullptr)
+                    args = gcnew SpendAmmoEventArgs();
                 args->Spender            = MemoryObject::FromAddress<Actor ^>(ctx->BX);
                 args->Weapon             = MemoryObject::FromAddress<TESObjectWEAP ^>(ctx->BP);
                 args->HasAmount          = static_cast<int>(MCH::u(ctx->DI) & 0xFFFFFFFF);
@@ -1647,14 +1670,14 @@ namespace NetScriptFramework
             {
                 if(args->Had && args->ReduceAmount <= 0)
                 {
-                    ctx->R14 = Memory::ReadPointer(ctx->AX, false);
+                    ctx->R14 = MCH::ReadPointer(ctx->AX);
                     ctx->IP  = __VIDS::VID37596.Value + 0x20A;
                     return;
                 }
                 ctx->SI = System::IntPtr(static_cast<long long>(static_cast<unsigned>(args->ReduceAmount)));
                 if(args->Force)
                 {
-                    ctx->R14 = Memory::ReadPointer(ctx->AX, false);
+                    ctx->R14 = MCH::ReadPointer(ctx->AX);
                     ctx->IP  = __VIDS::VID37596.Value + 0xD0;
                 }
             }
@@ -1675,9 +1698,10 @@ namespace NetScriptFramework
                 Event<SpendMagicCostEventArgs ^> ^get() { return __handler_SpendMagicCost; }
             }
         private :
-            static SpendMagicCostEventArgs ^__before_SpendMagicCost(CPURegisters ^ctx)
+            static SpendMagicCostEventArgs ^__before_SpendMagicCost(CPURegisters ^ctx, SpendMagicCostEventArgs ^args)
             {
-                SpendMagicCostEventArgs ^args = gcnew SpendMagicCostEventArgs();
+                if(args == nullptr)
+                    args = gcnew SpendMagicCostEventArgs();
                 args->Spender                 = MemoryObject::FromAddress<ActorMagicCaster ^>(ctx->BX);
                 args->Item                    = MemoryObject::FromAddress<MagicItem ^>(ctx->DI);
                 args->ActorValueIndex         = static_cast<int>(MCH::u(ctx->AX) & 0xFFFFFFFF);
@@ -1702,9 +1726,10 @@ namespace NetScriptFramework
                 Event<SpendPoisonEventArgs ^> ^get() { return __handler_SpendPoison; }
             }
         private :
-            static SpendPoisonEventArgs ^__before_SpendPoison_1(CPURegisters ^ctx)
+            static SpendPoisonEventArgs ^__before_SpendPoison_1(CPURegisters ^ctx, SpendPoisonEventArgs ^args)
             {
-                SpendPoisonEventArgs ^args = gcnew SpendPoisonEventArgs();
+                if(args == nullptr)
+                    args = gcnew SpendPoisonEventArgs();
                 args->Spender              = MemoryObject::FromAddress<Actor ^>(ctx->BX);
                 args->Item                 = MemoryObject::FromAddress<ExtraContainerChanges::ItemEntry ^>(ctx->DI);
                 args->Skip                 = false;
@@ -1719,9 +1744,10 @@ namespace NetScriptFramework
             }
 
         private:
-            static SpendPoisonEventArgs ^__before_SpendPoison_2(CPURegisters ^ctx)
+            static SpendPoisonEventArgs ^__before_SpendPoison_2(CPURegisters ^ctx, SpendPoisonEventArgs ^args)
             {
-                SpendPoisonEventArgs ^args = gcnew SpendPoisonEventArgs();
+                if(args == nullptr)
+                    args = gcnew SpendPoisonEventArgs();
                 args->Spender              = MemoryObject::FromAddress<Actor ^>(ctx->SI);
                 args->Item                 = MemoryObject::FromAddress<ExtraContainerChanges::ItemEntry ^>(ctx->DI);
                 args->Skip                 = false;
@@ -1750,9 +1776,10 @@ namespace NetScriptFramework
                 Event<UpdateCameraEventArgs ^> ^get() { return __handler_UpdateCamera; }
             }
         private :
-            static UpdateCameraEventArgs ^__before_UpdateCamera(CPURegisters ^ctx)
+            static UpdateCameraEventArgs ^__before_UpdateCamera(CPURegisters ^ctx, UpdateCameraEventArgs ^args)
             {
-                UpdateCameraEventArgs ^args = gcnew UpdateCameraEventArgs();
+                if(args == nullptr)
+                    args = gcnew UpdateCameraEventArgs();
                 args->Camera                = MemoryObject::FromAddress<TESCamera ^>(ctx->DI);
                 return args;
             }
@@ -1773,9 +1800,10 @@ namespace NetScriptFramework
                 Event<UpdatedPlayerHeadtrackEventArgs ^> ^get() { return __handler_UpdatedPlayerHeadtrack; }
             }
         private :
-            static UpdatedPlayerHeadtrackEventArgs ^__before_UpdatedPlayerHeadtrack(CPURegisters ^ctx)
+            static UpdatedPlayerHeadtrackEventArgs ^__before_UpdatedPlayerHeadtrack(CPURegisters ^ctx, UpdatedPlayerHeadtrackEventArgs ^args)
             {
-                UpdatedPlayerHeadtrackEventArgs ^args = gcnew UpdatedPlayerHeadtrackEventArgs();
+                if(args == nullptr)
+                    args = gcnew UpdatedPlayerHeadtrackEventArgs();
                 return args;
             }
 
@@ -1796,9 +1824,10 @@ namespace NetScriptFramework
                 Event<UpdatePlayerControlsEventArgs ^> ^get() { return __handler_UpdatePlayerControls; }
             }
         private :
-            static UpdatePlayerControlsEventArgs ^__before_UpdatePlayerControls(CPURegisters ^ctx)
+            static UpdatePlayerControlsEventArgs ^__before_UpdatePlayerControls(CPURegisters ^ctx, UpdatePlayerControlsEventArgs ^args)
             {
-                UpdatePlayerControlsEventArgs ^args = gcnew UpdatePlayerControlsEventArgs();
+                if(args == nullptr)
+                    args = gcnew UpdatePlayerControlsEventArgs();
                 args->Controls                      = MemoryObject::FromAddress<PlayerControls ^>(ctx->BX);
                 return args;
             }
@@ -1806,7 +1835,7 @@ namespace NetScriptFramework
         private :
             static void __after_UpdatePlayerControls(CPURegisters ^ctx, UpdatePlayerControlsEventArgs ^args)
             {
-                if(Memory::ReadUInt8(ctx->BX + 0x4F, false) == 0)
+                if(MCH::ReadUInt8(ctx->BX + 0x4F) == 0)
                     ctx->IP = __VIDS::VID41259.Value + 0x9A;
             }
 
@@ -1826,9 +1855,10 @@ namespace NetScriptFramework
                 Event<UpdatePlayerTurnToCameraEventArgs ^> ^get() { return __handler_UpdatePlayerTurnToCamera; }
             }
         private :
-            static UpdatePlayerTurnToCameraEventArgs ^__before_UpdatePlayerTurnToCamera(CPURegisters ^ctx)
+            static UpdatePlayerTurnToCameraEventArgs ^__before_UpdatePlayerTurnToCamera(CPURegisters ^ctx, UpdatePlayerTurnToCameraEventArgs ^args)
             {
-                UpdatePlayerTurnToCameraEventArgs ^args = gcnew UpdatePlayerTurnToCameraEventArgs();
+                if(args == nullptr)
+                    args = gcnew UpdatePlayerTurnToCameraEventArgs();
                 args->Target                            = MemoryObject::FromAddress<Actor ^>(ctx->AX);
                 args->FreeLook                          = MCH::b(ctx->DI);
                 args->Moving                            = MCH::b(ctx->DX);
@@ -1872,9 +1902,10 @@ namespace NetScriptFramework
                 Event<WeaponFireProjectilePositionEventArgs ^> ^get() { return __handler_WeaponFireProjectilePosition; }
             }
         private :
-            static WeaponFireProjectilePositionEventArgs ^__before_WeaponFireProjectilePosition(CPURegisters ^ctx)
+            static WeaponFireProjectilePositionEventArgs ^__before_WeaponFireProjectilePosition(CPURegisters ^ctx, WeaponFireProjectilePositionEventArgs ^args)
             {
-                WeaponFireProjectilePositionEventArgs ^args = gcnew WeaponFireProjectilePositionEventArgs();
+                if(args == nullptr)
+                    args = gcnew WeaponFireProjectilePositionEventArgs();
                 args->Attacker                              = MemoryObject::FromAddress<TESObjectREFR ^>(ctx->R13);
                 args->Node                                  = MemoryObject::FromAddress<NiAVObject ^>(ctx->AX);
                 args->Position                              = MemoryObject::FromAddress<NiPoint3 ^>(ctx->SP + 0x48);
@@ -1896,8 +1927,8 @@ namespace NetScriptFramework
                 __handler_BarterMenu = gcnew EventHook<BarterMenuEventArgs ^>(
                     EventHookFlags::None,
                     "BarterMenu",
-                    gcnew EventHookParameters<BarterMenuEventArgs ^>(__VIDS::VID49999.Value, 5, 5, "48 89 4C 24 08", gcnew System::Func<CPURegisters ^, BarterMenuEventArgs ^>(__before_BarterMenu_1), nullptr),
-                    gcnew EventHookParameters<BarterMenuEventArgs ^>(__VIDS::VID50066.Value + 0x19, 5, 5, "E8", gcnew System::Func<CPURegisters ^, BarterMenuEventArgs ^>(__before_BarterMenu_2), nullptr)
+                    gcnew EventHookParameters<BarterMenuEventArgs ^>(__VIDS::VID49999.Value, 5, 5, "48 89 4C 24 08", gcnew System::Func<CPURegisters ^, BarterMenuEventArgs ^, BarterMenuEventArgs ^>(__before_BarterMenu_1), nullptr),
+                    gcnew EventHookParameters<BarterMenuEventArgs ^>(__VIDS::VID50066.Value + 0x19, 5, 5, "E8", gcnew System::Func<CPURegisters ^, BarterMenuEventArgs ^, BarterMenuEventArgs ^>(__before_BarterMenu_2), nullptr)
                     );
                 __handler_CalculateDetection = gcnew EventHook<CalculateDetectionEventArgs ^>(
                     EventHookFlags::None,
@@ -1907,7 +1938,7 @@ namespace NetScriptFramework
                         6,
                         6,
                         "8B 95 D0 00 00 00",
-                        gcnew System::Func<CPURegisters ^, CalculateDetectionEventArgs ^>(__before_CalculateDetection),
+                        gcnew System::Func<CPURegisters ^, CalculateDetectionEventArgs ^, CalculateDetectionEventArgs ^>(__before_CalculateDetection),
                         gcnew System::Action<CPURegisters ^, CalculateDetectionEventArgs ^>(__after_CalculateDetection)
                         )
                     );
@@ -1919,7 +1950,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "48 83 C4 30 5B",
-                        gcnew System::Func<CPURegisters ^, CalculateFormGoldValueEventArgs ^>(__before_CalculateFormGoldValue_1),
+                        gcnew System::Func<CPURegisters ^, CalculateFormGoldValueEventArgs ^, CalculateFormGoldValueEventArgs ^>(__before_CalculateFormGoldValue_1),
                         gcnew System::Action<CPURegisters ^, CalculateFormGoldValueEventArgs ^>(__after_CalculateFormGoldValue_1)
                         ),
                     gcnew EventHookParameters<CalculateFormGoldValueEventArgs ^>(
@@ -1927,7 +1958,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "48 83 C4 30 5B",
-                        gcnew System::Func<CPURegisters ^, CalculateFormGoldValueEventArgs ^>(__before_CalculateFormGoldValue_2),
+                        gcnew System::Func<CPURegisters ^, CalculateFormGoldValueEventArgs ^, CalculateFormGoldValueEventArgs ^>(__before_CalculateFormGoldValue_2),
                         gcnew System::Action<CPURegisters ^, CalculateFormGoldValueEventArgs ^>(__after_CalculateFormGoldValue_2)
                         ),
                     gcnew EventHookParameters<CalculateFormGoldValueEventArgs ^>(
@@ -1935,7 +1966,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "48 83 C4 30 5B",
-                        gcnew System::Func<CPURegisters ^, CalculateFormGoldValueEventArgs ^>(__before_CalculateFormGoldValue_3),
+                        gcnew System::Func<CPURegisters ^, CalculateFormGoldValueEventArgs ^, CalculateFormGoldValueEventArgs ^>(__before_CalculateFormGoldValue_3),
                         gcnew System::Action<CPURegisters ^, CalculateFormGoldValueEventArgs ^>(__after_CalculateFormGoldValue_3)
                         )
                     );
@@ -1947,14 +1978,14 @@ namespace NetScriptFramework
                         5,
                         5,
                         "48 89 5C 24 08",
-                        gcnew System::Func<CPURegisters ^, CameraStateChangingEventArgs ^>(__before_CameraStateChanging),
+                        gcnew System::Func<CPURegisters ^, CameraStateChangingEventArgs ^, CameraStateChangingEventArgs ^>(__before_CameraStateChanging),
                         gcnew System::Action<CPURegisters ^, CameraStateChangingEventArgs ^>(__after_CameraStateChanging)
                         )
                     );
                 __handler_Frame = gcnew EventHook<FrameEventArgs ^>(
                     EventHookFlags::None,
                     "Frame",
-                    gcnew EventHookParameters<FrameEventArgs ^>(__VIDS::VID35565.Value + 0x1E, 5, 5, "E8", gcnew System::Func<CPURegisters ^, FrameEventArgs ^>(__before_Frame), nullptr)
+                    gcnew EventHookParameters<FrameEventArgs ^>(__VIDS::VID35565.Value + 0x1E, 5, 5, "E8", gcnew System::Func<CPURegisters ^, FrameEventArgs ^, FrameEventArgs ^>(__before_Frame), nullptr)
                     );
                 __handler_GainLevelXP = gcnew EventHook<GainLevelXPEventArgs ^>(
                     EventHookFlags::None,
@@ -1964,7 +1995,7 @@ namespace NetScriptFramework
                         6,
                         6,
                         "F3 0F 58 01 8B D6",
-                        gcnew System::Func<CPURegisters ^, GainLevelXPEventArgs ^>(__before_GainLevelXP),
+                        gcnew System::Func<CPURegisters ^, GainLevelXPEventArgs ^, GainLevelXPEventArgs ^>(__before_GainLevelXP),
                         gcnew System::Action<CPURegisters ^, GainLevelXPEventArgs ^>(__after_GainLevelXP)
                         )
                     );
@@ -1976,25 +2007,25 @@ namespace NetScriptFramework
                         5,
                         0,
                         "E8 ? ? ? ? 48 8B 05",
-                        gcnew System::Func<CPURegisters ^, GainSkillXPEventArgs ^>(__before_GainSkillXP),
+                        gcnew System::Func<CPURegisters ^, GainSkillXPEventArgs ^, GainSkillXPEventArgs ^>(__before_GainSkillXP),
                         gcnew System::Action<CPURegisters ^, GainSkillXPEventArgs ^>(__after_GainSkillXP)
                         )
                     );
                 __handler_InterruptCast = gcnew EventHook<InterruptCastEventArgs ^>(
                     EventHookFlags::None,
                     "InterruptCast",
-                    gcnew EventHookParameters<InterruptCastEventArgs ^>(__VIDS::VID33630.Value + 0x10, 6, 6, "48 8B 01 FF 50 40", gcnew System::Func<CPURegisters ^, InterruptCastEventArgs ^>(__before_InterruptCast), nullptr)
+                    gcnew EventHookParameters<InterruptCastEventArgs ^>(__VIDS::VID33630.Value + 0x10, 6, 6, "48 8B 01 FF 50 40", gcnew System::Func<CPURegisters ^, InterruptCastEventArgs ^, InterruptCastEventArgs ^>(__before_InterruptCast), nullptr)
                     );
                 __handler_MagicCasterFire = gcnew EventHook<MagicCasterFireEventArgs ^>(
                     EventHookFlags::None,
                     "MagicCasterFire",
-                    gcnew EventHookParameters<MagicCasterFireEventArgs ^>(__VIDS::VID33629.Value + 0xF7, 6, 6, "4C 8B 17 4C 8B CE", gcnew System::Func<CPURegisters ^, MagicCasterFireEventArgs ^>(__before_MagicCasterFire), nullptr)
+                    gcnew EventHookParameters<MagicCasterFireEventArgs ^>(__VIDS::VID33629.Value + 0xF7, 6, 6, "4C 8B 17 4C 8B CE", gcnew System::Func<CPURegisters ^, MagicCasterFireEventArgs ^, MagicCasterFireEventArgs ^>(__before_MagicCasterFire), nullptr)
                     );
                 __handler_MainMenu = gcnew EventHook<MainMenuEventArgs ^>(
                     EventHookFlags::None,
                     "MainMenu",
-                    gcnew EventHookParameters<MainMenuEventArgs ^>(__VIDS::VID51324.Value + 0x19, 5, 5, "E8", gcnew System::Func<CPURegisters ^, MainMenuEventArgs ^>(__before_MainMenu_1), nullptr),
-                    gcnew EventHookParameters<MainMenuEventArgs ^>(__VIDS::VID51236.Value, 5, 5, "48 89 4C 24 08", gcnew System::Func<CPURegisters ^, MainMenuEventArgs ^>(__before_MainMenu_2), nullptr)
+                    gcnew EventHookParameters<MainMenuEventArgs ^>(__VIDS::VID51324.Value + 0x19, 5, 5, "E8", gcnew System::Func<CPURegisters ^, MainMenuEventArgs ^, MainMenuEventArgs ^>(__before_MainMenu_1), nullptr),
+                    gcnew EventHookParameters<MainMenuEventArgs ^>(__VIDS::VID51236.Value, 5, 5, "48 89 4C 24 08", gcnew System::Func<CPURegisters ^, MainMenuEventArgs ^, MainMenuEventArgs ^>(__before_MainMenu_2), nullptr)
                     );
                 __handler_ReduceHUDAmmoCounter = gcnew EventHook<ReduceHUDAmmoCounterEventArgs ^>(
                     EventHookFlags::AlwaysRun,
@@ -2004,7 +2035,7 @@ namespace NetScriptFramework
                         7,
                         -5,
                         "E8 ?? ?? ?? ?? FF C8",
-                        gcnew System::Func<CPURegisters ^, ReduceHUDAmmoCounterEventArgs ^>(__before_ReduceHUDAmmoCounter),
+                        gcnew System::Func<CPURegisters ^, ReduceHUDAmmoCounterEventArgs ^, ReduceHUDAmmoCounterEventArgs ^>(__before_ReduceHUDAmmoCounter),
                         gcnew System::Action<CPURegisters ^, ReduceHUDAmmoCounterEventArgs ^>(__after_ReduceHUDAmmoCounter)
                         )
                     );
@@ -2016,7 +2047,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__before_RemoveMagicEffectsWithArchetype_1),
+                        gcnew System::Func<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__before_RemoveMagicEffectsWithArchetype_1),
                         gcnew System::Action<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__after_RemoveMagicEffectsWithArchetype_1)
                         ),
                     gcnew EventHookParameters<RemoveMagicEffectsWithArchetypeEventArgs ^>(
@@ -2024,7 +2055,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__before_RemoveMagicEffectsWithArchetype_2),
+                        gcnew System::Func<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__before_RemoveMagicEffectsWithArchetype_2),
                         gcnew System::Action<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__after_RemoveMagicEffectsWithArchetype_2)
                         ),
                     gcnew EventHookParameters<RemoveMagicEffectsWithArchetypeEventArgs ^>(
@@ -2032,7 +2063,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__before_RemoveMagicEffectsWithArchetype_3),
+                        gcnew System::Func<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__before_RemoveMagicEffectsWithArchetype_3),
                         gcnew System::Action<CPURegisters ^, RemoveMagicEffectsWithArchetypeEventArgs ^>(__after_RemoveMagicEffectsWithArchetype_3)
                         )
                     );
@@ -2044,7 +2075,7 @@ namespace NetScriptFramework
                         5,
                         0,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, ShadowCullingBeginEventArgs ^>(__before_ShadowCullingBegin),
+                        gcnew System::Func<CPURegisters ^, ShadowCullingBeginEventArgs ^, ShadowCullingBeginEventArgs ^>(__before_ShadowCullingBegin),
                         gcnew System::Action<CPURegisters ^, ShadowCullingBeginEventArgs ^>(__after_ShadowCullingBegin)
                         )
                     );
@@ -2056,7 +2087,7 @@ namespace NetScriptFramework
                         0x12,
                         0,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, ShadowCullingEndEventArgs ^>(__before_ShadowCullingEnd),
+                        gcnew System::Func<CPURegisters ^, ShadowCullingEndEventArgs ^, ShadowCullingEndEventArgs ^>(__before_ShadowCullingEnd),
                         gcnew System::Action<CPURegisters ^, ShadowCullingEndEventArgs ^>(__after_ShadowCullingEnd)
                         )
                     );
@@ -2068,7 +2099,7 @@ namespace NetScriptFramework
                         5,
                         -5,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, SpendAmmoEventArgs ^>(__before_SpendAmmo),
+                        gcnew System::Func<CPURegisters ^, SpendAmmoEventArgs ^, SpendAmmoEventArgs ^>(__before_SpendAmmo),
                         gcnew System::Action<CPURegisters ^, SpendAmmoEventArgs ^>(__after_SpendAmmo)
                         )
                     );
@@ -2080,7 +2111,7 @@ namespace NetScriptFramework
                         6,
                         6,
                         "44 8B F8 83 F8 FF",
-                        gcnew System::Func<CPURegisters ^, SpendMagicCostEventArgs ^>(__before_SpendMagicCost),
+                        gcnew System::Func<CPURegisters ^, SpendMagicCostEventArgs ^, SpendMagicCostEventArgs ^>(__before_SpendMagicCost),
                         gcnew System::Action<CPURegisters ^, SpendMagicCostEventArgs ^>(__after_SpendMagicCost)
                         )
                     );
@@ -2092,7 +2123,7 @@ namespace NetScriptFramework
                         5,
                         5,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, SpendPoisonEventArgs ^>(__before_SpendPoison_1),
+                        gcnew System::Func<CPURegisters ^, SpendPoisonEventArgs ^, SpendPoisonEventArgs ^>(__before_SpendPoison_1),
                         gcnew System::Action<CPURegisters ^, SpendPoisonEventArgs ^>(__after_SpendPoison_1)
                         ),
                     gcnew EventHookParameters<SpendPoisonEventArgs ^>(
@@ -2100,14 +2131,14 @@ namespace NetScriptFramework
                         5,
                         5,
                         "E8",
-                        gcnew System::Func<CPURegisters ^, SpendPoisonEventArgs ^>(__before_SpendPoison_2),
+                        gcnew System::Func<CPURegisters ^, SpendPoisonEventArgs ^, SpendPoisonEventArgs ^>(__before_SpendPoison_2),
                         gcnew System::Action<CPURegisters ^, SpendPoisonEventArgs ^>(__after_SpendPoison_2)
                         )
                     );
                 __handler_UpdateCamera = gcnew EventHook<UpdateCameraEventArgs ^>(
                     EventHookFlags::None,
                     "UpdateCamera",
-                    gcnew EventHookParameters<UpdateCameraEventArgs ^>(__VIDS::VID32289.Value + 0x4A, 5, 5, "48 8B 5C 24 40", gcnew System::Func<CPURegisters ^, UpdateCameraEventArgs ^>(__before_UpdateCamera), nullptr)
+                    gcnew EventHookParameters<UpdateCameraEventArgs ^>(__VIDS::VID32289.Value + 0x4A, 5, 5, "48 8B 5C 24 40", gcnew System::Func<CPURegisters ^, UpdateCameraEventArgs ^, UpdateCameraEventArgs ^>(__before_UpdateCamera), nullptr)
                     );
                 __handler_UpdatedPlayerHeadtrack = gcnew EventHook<UpdatedPlayerHeadtrackEventArgs ^>(
                     EventHookFlags::None,
@@ -2117,7 +2148,7 @@ namespace NetScriptFramework
                         8,
                         8,
                         "F3 0F 10 87 10 0A 00 00",
-                        gcnew System::Func<CPURegisters ^, UpdatedPlayerHeadtrackEventArgs ^>(__before_UpdatedPlayerHeadtrack),
+                        gcnew System::Func<CPURegisters ^, UpdatedPlayerHeadtrackEventArgs ^, UpdatedPlayerHeadtrackEventArgs ^>(__before_UpdatedPlayerHeadtrack),
                         nullptr
                         )
                     );
@@ -2129,7 +2160,7 @@ namespace NetScriptFramework
                         6,
                         0,
                         "80 7B 4F 00 74 0C",
-                        gcnew System::Func<CPURegisters ^, UpdatePlayerControlsEventArgs ^>(__before_UpdatePlayerControls),
+                        gcnew System::Func<CPURegisters ^, UpdatePlayerControlsEventArgs ^, UpdatePlayerControlsEventArgs ^>(__before_UpdatePlayerControls),
                         gcnew System::Action<CPURegisters ^, UpdatePlayerControlsEventArgs ^>(__after_UpdatePlayerControls)
                         )
                     );
@@ -2141,7 +2172,7 @@ namespace NetScriptFramework
                         7,
                         7,
                         "40 38 BB DC 00 00 00",
-                        gcnew System::Func<CPURegisters ^, UpdatePlayerTurnToCameraEventArgs ^>(__before_UpdatePlayerTurnToCamera),
+                        gcnew System::Func<CPURegisters ^, UpdatePlayerTurnToCameraEventArgs ^, UpdatePlayerTurnToCameraEventArgs ^>(__before_UpdatePlayerTurnToCamera),
                         gcnew System::Action<CPURegisters ^, UpdatePlayerTurnToCameraEventArgs ^>(__after_UpdatePlayerTurnToCamera)
                         )
                     );
@@ -2153,7 +2184,7 @@ namespace NetScriptFramework
                         7,
                         7,
                         "45 0F 57 DB 48 85 C0",
-                        gcnew System::Func<CPURegisters ^, WeaponFireProjectilePositionEventArgs ^>(__before_WeaponFireProjectilePosition),
+                        gcnew System::Func<CPURegisters ^, WeaponFireProjectilePositionEventArgs ^, WeaponFireProjectilePositionEventArgs ^>(__before_WeaponFireProjectilePosition),
                         gcnew System::Action<CPURegisters ^, WeaponFireProjectilePositionEventArgs ^>(__after_WeaponFireProjectilePosition)
                         )
                     );
@@ -117,16 +117,16 @@ void NiObjectLoadParameters::_RequestModelDirect(NiObjectLoadParameters ^p)
 	NetScriptFramework::Memory::WriteInt32(p->_alloc->Address + 0x18,
 	                                       0x1010001, false);
 
-	auto str = NetScriptFramework::Memory::AllocateString(
-		p->FileName, false);
+	auto scope = NetScriptFramework::Memory::BeginFrameScope();
 	try {
+		auto str = NetScriptFramework::FrameString(p->FileName, false);
 		result = (System::Int32)(
 			NetScriptFramework::Memory::InvokeCdecl(
-				__VIDS::VID74039.Value, str->Address,
+				__VIDS::VID74039.Value, str.Address,
 				p->_alloc->Address, p->_alloc->Address + 0x10).
 			ToInt64() & 0xFF);
 	} finally {
-		delete str;
+		scope.Dispose();
 	}
 
 	if ((result != 0 && result != 6) || !p->Process())
@@ -146,16 +146,16 @@ void NiObjectLoadParameters::_RequestModelAsync(NiObjectLoadParameters ^p)
 	NetScriptFramework::Memory::WriteInt32(p->_alloc->Address + 0x18,
 	                                       0x1010001, false);
 
-	auto str = NetScriptFramework::Memory::AllocateString(
-		p->FileName, false);
+	auto scope = NetScriptFramework::Memory::BeginFrameScope();
 	try {
+		auto str = NetScriptFramework::FrameString(p->FileName, false);
 		result = (System::Int32)(
 			NetScriptFramework::Memory::InvokeCdecl(
-				__VIDS::VID74038.Value, str->Address,
+				__VIDS::VID74038.Value, str.Address,
 				p->_alloc->Address, p->_alloc->Address + 0x10,
 				0).ToInt64() & 0xFF);
 	} finally {
-		delete str;
+		scope.Dispose();
 	}
 
 	if (result == 0 || result == 6) {
@@ -279,6 +279,11 @@ void NiObjectLoadParameters__OnFrame(FrameEventArgs ^e)
 	NiObjectLoadParameters::_UpdateRequestModel();
 }
 
+void FrameArena__OnFrame(FrameEventArgs ^e)
+{
+	NetScriptFramework::Memory::AdvanceFrame();
+}
+
 RayCastResult ^RayCastResult::GetClosestResult(array<float> ^source,
                                                System::Collections::Generic::List
                                                <RayCastResult ^> ^results,
@@ -356,8 +361,10 @@ System::Collections::Generic::List<RayCastResult ^> ^_Havok::RayCast(
 	if (end == nullptr)
 		end = gcnew array<float>(3);
 
-	auto havokWorldPtr = NetScriptFramework::Memory::InvokeCdecl(
-		__VIDS::VID18536.Value, p->Cell->Cast<TESObjectCELL ^>());
+	auto getHavokWorld = (_GetHavokWorldFromCell)__VIDS::VID18536.Value.
+		ToPointer();
+	auto havokWorldPtr = System::IntPtr(getHavokWorld(
+		p->Cell->Cast<TESObjectCELL ^>().ToPointer()));
 	if (havokWorldPtr == System::IntPtr::Zero)
 		return result;
 
@@ -396,14 +403,16 @@ System::Collections::Generic::List<RayCastResult ^> ^_Havok::RayCast(
 
 	auto vtable = NetScriptFramework::Memory::ReadPointer(
 		havokWorldPtr, false);
-	auto func51 = NetScriptFramework::Memory::ReadPointer(
-		vtable + 0x198, false);
-	System::IntPtr callfn = NetScriptFramework::Memory::InvokeCdecl(
-		func51, havokWorldPtr, System::IntPtr(args));
+	auto func51 = (_HavokWorldCastRay)NetScriptFramework::Memory::
+		ReadPointer(vtable + 0x198, false).ToPointer();
+	System::IntPtr callfn = System::IntPtr(func51(
+		havokWorldPtr.ToPointer(), (void *)args));
 
 	/*if ((callfn.ToInt64() & 0xFF) == 0)
 	return result;*/
 
+	auto getObject = (_GetObjectFromCollidable)__VIDS::VID76160.Value.
+		ToPointer();
 	auto n = collector.first;
 	while (n != 0) {
 		auto r = gcnew RayCastResult();
@@ -427,8 +436,7 @@ System::Collections::Generic::List<RayCastResult ^> ^_Havok::RayCast(
 		}
 		else*/
 		{
-			obj = NetScriptFramework::Memory::InvokeCdecl(
-				__VIDS::VID76160.Value, obj);
+			obj = System::IntPtr(getObject(obj.ToPointer()));
 		}
 		r->_obj = obj;
 
@@ -446,30 +454,27 @@ TESForm ^TESForm::LookupFormFromFile(System::UInt32 formId,
 	auto dataHandler = DataHandler::Instance;
 	if (dataHandler == nullptr)
 		return nullptr;
-	auto alloc =
-		NetScriptFramework::Memory::AllocateString(fileName, false);
-	auto alloc2 = NetScriptFramework::Memory::Allocate(0x10, 0, false);
+	auto scope = NetScriptFramework::Memory::BeginFrameScope();
 	try {
+		auto str = NetScriptFramework::FrameString(fileName, false);
+		auto buf = NetScriptFramework::Memory::AllocateFrame(0x10, 0);
 		auto filePtr = NetScriptFramework::Memory::InvokeCdecl(
 			__VIDS::VID13632.Value, dataHandler->Address,
-			alloc->Address);
+			str.Address);
 		if (filePtr == System::IntPtr::Zero)
 			return nullptr;
 		if ((MCH::u(NetScriptFramework::Memory::InvokeCdecl(
 			     __VIDS::VID13882.Value, filePtr)) & 0xFF) == 0)
 			return nullptr;
-		alloc2->Zero();
-		NetScriptFramework::Memory::WriteUInt32(
-			alloc2->Address, formId, false);
+		NetScriptFramework::Memory::WriteZero(buf, 0x10);
+		NetScriptFramework::Memory::WriteUInt32(buf, formId, false);
 		NetScriptFramework::Memory::InvokeCdecl(
-			__VIDS::VID13915.Value, filePtr, alloc2->Address);
-		formId = NetScriptFramework::Memory::ReadUInt32(
-			alloc2->Address, false);
-		return LookupFormById(formId);
+			__VIDS::VID13915.Value, filePtr, buf);
+		formId = NetScriptFramework::Memory::ReadUInt32(buf, false);
 	} finally {
-		delete alloc2;
-		delete alloc;
+		scope.Dispose();
 	}
+	return LookupFormById(formId);
 }
 
 void NiObject::LoadFromFile(NiObjectLoadParameters ^p)
@@ -504,6 +509,236 @@ System::Collections::Generic::List<RayCastResult ^> ^TESObjectCELL::RayCast(
 	return _Havok::RayCast(p);
 }
 
+#pragma managed(push, off)
+// NiAVObject and NiNode field offsets read by the snapshot walk.
+#define SCENE_SNAPSHOT_NAME 0x10
+#define SCENE_SNAPSHOT_LOCAL 0x48
+#define SCENE_SNAPSHOT_WORLD 0x7C
+#define SCENE_SNAPSHOT_FLAGS 0xF4
+#define SCENE_SNAPSHOT_CHILDREN 0x118
+#define SCENE_SNAPSHOT_CHILDREN_USED 0x122
+
+static unsigned int SceneSnapshot__Hash(const unsigned char *text)
+{
+	// FNV-1a of lower case text, must match SceneSnapshot::HashName.
+	unsigned int hash = 2166136261u;
+	if (text == nullptr)
+		return hash;
+	for (; *text != 0; text++) {
+		unsigned int c = *text;
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		hash = (hash ^ c) * 16777619u;
+	}
+	return hash;
+}
+
+static void SceneSnapshot__Walk(sceneSnapshotOutput *out, char *obj,
+                                int parent, int depth)
+{
+	out->current = obj;
+
+	unsigned int objFlags = *((unsigned int *)(obj + SCENE_SNAPSHOT_FLAGS));
+	if ((out->flags & 0x10) != 0 && (objFlags & 1) != 0)
+		return;
+
+	// Keep counting past capacity so the caller knows how much to grow.
+	int index = out->count++;
+	if (index < out->capacity) {
+		out->nodes[index] = obj;
+		out->parents[index] = parent;
+		if (out->names != nullptr)
+			out->names[index] = SceneSnapshot__Hash(
+				*((const unsigned char **)(obj +
+					SCENE_SNAPSHOT_NAME)));
+		if (out->world != nullptr) {
+			float *src = (float *)(obj + SCENE_SNAPSHOT_WORLD);
+			float *dst = out->world + index * 13;
+			for (int i = 0; i < 13; i++)
+				dst[i] = src[i];
+		}
+		if (out->local != nullptr) {
+			float *src = (float *)(obj + SCENE_SNAPSHOT_LOCAL);
+			float *dst = out->local + index * 13;
+			for (int i = 0; i < 13; i++)
+				dst[i] = src[i];
+		}
+		if (out->objectFlags != nullptr)
+			out->objectFlags[index] = objFlags;
+	}
+
+	if (depth >= 256)
+		return;
+
+	auto asNode = (_NiObjectAsNode)(*((void ***)obj))[3];
+	auto node = (char *)asNode(obj);
+	if (node == nullptr)
+		return;
+
+	auto children = *((char ***)(node + SCENE_SNAPSHOT_CHILDREN));
+	int used = *((unsigned short *)(node + SCENE_SNAPSHOT_CHILDREN_USED));
+	if (children == nullptr)
+		return;
+	for (int i = 0; i < used; i++) {
+		if (children[i] != nullptr)
+			SceneSnapshot__Walk(out, children[i], index, depth + 1);
+	}
+}
+
+// The scene graph can be modified by other threads while walking it, so a
+// freed or half built object must fail the walk instead of the process.
+static bool SceneSnapshot__TryWalk(sceneSnapshotOutput *out, char *root)
+{
+	__try {
+		SceneSnapshot__Walk(out, root, -1, 0);
+		return true;
+	} __except (EXCEPTION_EXECUTE_HANDLER) {
+		return false;
+	}
+}
+#pragma managed(pop)
+
+void SceneSnapshot::Reserve(int capacity)
+{
+	if (_nodes != nullptr && _nodes->Length >= capacity)
+		return;
+
+	_nodes = gcnew array<System::IntPtr>(capacity);
+	_parents = gcnew array<int>(capacity);
+	if (_names != nullptr)
+		_names = gcnew array<System::UInt32>(capacity);
+	if (_world != nullptr)
+		_world = gcnew array<float>(capacity * TransformStride);
+	if (_local != nullptr)
+		_local = gcnew array<float>(capacity * TransformStride);
+	if (_objectFlags != nullptr)
+		_objectFlags = gcnew array<System::UInt32>(capacity);
+}
+
+void SceneSnapshot::Recapture(NiAVObject ^root, SceneSnapshotFlags flags)
+{
+	_count = 0;
+	_flags = flags;
+
+	if (root == nullptr)
+		return;
+
+	int capacity = _nodes->Length;
+	if ((flags & SceneSnapshotFlags::NameHashes) !=
+	    SceneSnapshotFlags::None && _names == nullptr)
+		_names = gcnew array<System::UInt32>(capacity);
+	if ((flags & SceneSnapshotFlags::WorldTransform) !=
+	    SceneSnapshotFlags::None && _world == nullptr)
+		_world = gcnew array<float>(capacity * TransformStride);
+	if ((flags & SceneSnapshotFlags::LocalTransform) !=
+	    SceneSnapshotFlags::None && _local == nullptr)
+		_local = gcnew array<float>(capacity * TransformStride);
+	if ((flags & SceneSnapshotFlags::ObjectFlags) !=
+	    SceneSnapshotFlags::None && _objectFlags == nullptr)
+		_objectFlags = gcnew array<System::UInt32>(capacity);
+
+	auto rootPtr = (char *)root->Cast<NiAVObject ^>().ToPointer();
+	if (rootPtr == nullptr)
+		return;
+
+	// The subtree size is only known after walking it, if it didn't fit
+	// then grow the buffers and walk again.
+	while (true) {
+		pin_ptr<System::IntPtr> nodes = &_nodes[0];
+		pin_ptr<int> parents = &_parents[0];
+		pin_ptr<System::UInt32> names = nullptr;
+		pin_ptr<float> world = nullptr;
+		pin_ptr<float> local = nullptr;
+		pin_ptr<System::UInt32> objectFlags = nullptr;
+		if (_names != nullptr)
+			names = &_names[0];
+		if (_world != nullptr)
+			world = &_world[0];
+		if (_local != nullptr)
+			local = &_local[0];
+		if (_objectFlags != nullptr)
+			objectFlags = &_objectFlags[0];
+
+		sceneSnapshotOutput out;
+		out.capacity = _nodes->Length;
+		out.count = 0;
+		out.flags = (unsigned int)flags;
+		out.current = nullptr;
+		out.nodes = (void **)nodes;
+		out.parents = parents;
+		out.names = (flags & SceneSnapshotFlags::NameHashes) !=
+		            SceneSnapshotFlags::None
+			            ? (unsigned int *)names
+			            : nullptr;
+		out.world = (flags & SceneSnapshotFlags::WorldTransform) !=
+		            SceneSnapshotFlags::None
+			            ? (float *)world
+			            : nullptr;
+		out.local = (flags & SceneSnapshotFlags::LocalTransform) !=
+		            SceneSnapshotFlags::None
+			            ? (float *)local
+			            : nullptr;
+		out.objectFlags = (flags & SceneSnapshotFlags::ObjectFlags) !=
+		                  SceneSnapshotFlags::None
+			                  ? (unsigned int *)objectFlags
+			                  : nullptr;
+
+		if (!SceneSnapshot__TryWalk(&out, rootPtr))
+			throw gcnew NetScriptFramework::MemoryAccessException(
+				System::IntPtr(out.current));
+
+		if (out.count <= out.capacity) {
+			_count = out.count;
+			return;
+		}
+
+		Reserve(out.count + out.count / 4);
+	}
+}
+
+int SceneSnapshot::IndexOf(System::String ^name)
+{
+	if (name == nullptr)
+		throw gcnew System::ArgumentNullException("name");
+	if ((_flags & SceneSnapshotFlags::NameHashes) ==
+	    SceneSnapshotFlags::None)
+		throw gcnew System::InvalidOperationException(
+			"Names were not captured in this snapshot!");
+
+	auto hash = HashName(name);
+	for (int i = 0; i < _count; i++) {
+		if (_names[i] != hash)
+			continue;
+
+		// Different names may have the same hash.
+		auto textPtr = NetScriptFramework::Memory::ReadPointer(
+			_nodes[i] + SCENE_SNAPSHOT_NAME, false);
+		if (textPtr == System::IntPtr::Zero)
+			continue;
+		auto text = NetScriptFramework::Memory::ReadString(
+			textPtr, false, false);
+		if (text != nullptr && text->Equals(
+			    name, System::StringComparison::OrdinalIgnoreCase))
+			return i;
+	}
+	return -1;
+}
+
+System::UInt32 SceneSnapshot::HashName(System::String ^name)
+{
+	System::UInt32 hash = 2166136261u;
+	if (name == nullptr)
+		return hash;
+	auto bytes = System::Text::Encoding::UTF8->GetBytes(name);
+	for (int i = 0; i < bytes->Length; i++) {
+		System::UInt32 c = bytes[i];
+		if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		hash = (hash ^ c) * 16777619u;
+	}
+	return hash;
+}
+
 void SkyrimSEGame::Initialize()
 {
 	// Perform base class initialization.
@@ -528,6 +763,12 @@ void SkyrimSEGame::Initialize()
 		>::EventHandler(NiObjectLoadParameters__OnFrame), 0, 0,
 		NetScriptFramework::EventRegistrationFlags::None);
 
+	// Registered with highest priority so frame memory stays valid for every other handler.
+	Events::OnFrame->Register(
+		gcnew NetScriptFramework::Event<FrameEventArgs ^
+		>::EventHandler(FrameArena__OnFrame), System::Int32::MaxValue, 0,
+		NetScriptFramework::EventRegistrationFlags::None);
+
 	Events::OnMainMenu->Register(
 		gcnew NetScriptFramework::Event<MainMenuEventArgs ^
 		>::EventHandler(KeywordCache__Initialize), 0, 1,
@@ -102,6 +102,31 @@ private:
 public:
 	customRayHitCollectorResult *first;
 };
+
+// Called directly instead of through Memory::InvokeCdecl because these run for
+// every ray cast and every hit.
+typedef void *(*_GetHavokWorldFromCell)(void *cell);
+typedef void *(*_HavokWorldCastRay)(void *world, void *args);
+typedef void *(*_GetObjectFromCollidable)(void *collidable);
+
+// Output buffers of a scene snapshot walk. The arrays are pinned by the caller
+// and any of the optional ones may be null if not requested. The object that
+// was being read is kept in current so a failed walk can report it.
+struct sceneSnapshotOutput {
+	int capacity;
+	int count;
+	unsigned int flags;
+	void *current;
+	void **nodes;
+	int *parents;
+	unsigned int *names;
+	float *world;
+	float *local;
+	unsigned int *objectFlags;
+};
+
+// NiObject vtable index 3, returns the object itself if it's a NiNode.
+typedef void *(*_NiObjectAsNode)(void *obj);
 #pragma managed(pop)
 
 /// <summary>
@@ -596,6 +621,239 @@ public:
 	                                       ... array<NiAVObject ^> ^ignore);
 };
 
+/// <summary>
+/// Selects what is read for each object when capturing a scene snapshot.
+/// </summary>
+[System::Flags]
+public enum class SceneSnapshotFlags : System::UInt32 {
+	/// <summary>
+	/// Only the object addresses and parent indices are captured.
+	/// </summary>
+	None = 0,
+
+	/// <summary>
+	/// Capture the world transform of each object.
+	/// </summary>
+	WorldTransform = 1,
+
+	/// <summary>
+	/// Capture the local transform of each object.
+	/// </summary>
+	LocalTransform = 2,
+
+	/// <summary>
+	/// Capture the name hash of each object, see <see cref="SceneSnapshot::HashName"/>.
+	/// </summary>
+	NameHashes = 4,
+
+	/// <summary>
+	/// Capture the <see cref="NiAVObjectFlags"/> of each object.
+	/// </summary>
+	ObjectFlags = 8,
+
+	/// <summary>
+	/// Objects that have the hidden flag set are not captured and neither are their children.
+	/// </summary>
+	SkipHidden = 0x10,
+
+	/// <summary>
+	/// Capture everything.
+	/// </summary>
+	All = 0xF,
+};
+
+/// <summary>
+/// A snapshot of a scene graph subtree that is read in native code with a single depth first walk. Objects are stored in
+/// depth first order as a structure of arrays so they can be indexed directly without creating a wrapper for each object.
+/// The root object is always at index 0 and each transform takes <see cref="TransformStride"/> values laid out the same
+/// as NiTransform: a row major 3x3 rotation matrix, the position and then the scale.
+/// </summary>
+public ref class SceneSnapshot sealed {
+public:
+	/// <summary>
+	/// The count of values for each transform in <see cref="WorldTransforms"/> and <see cref="LocalTransforms"/>.
+	/// </summary>
+	literal int TransformStride = 13;
+
+	/// <summary>
+	/// The maximum depth of children that is walked from the root.
+	/// </summary>
+	literal int MaxDepth = 256;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="SceneSnapshot"/> class.
+	/// </summary>
+	/// <param name="capacity">The expected count of objects. Buffers grow as needed.</param>
+	SceneSnapshot(int capacity)
+	{
+		if (capacity < 16)
+			capacity = 16;
+		Reserve(capacity);
+	}
+
+	/// <summary>
+	/// Captures the subtree of root in a new snapshot.
+	/// </summary>
+	/// <param name="root">The root object.</param>
+	/// <param name="flags">What to capture for each object.</param>
+	/// <returns></returns>
+	/// <exception cref="NetScriptFramework::MemoryAccessException">An object in the subtree could not be read.</exception>
+	static SceneSnapshot ^Capture(NiAVObject ^root, SceneSnapshotFlags flags)
+	{
+		auto s = gcnew SceneSnapshot(256);
+		s->Recapture(root, flags);
+		return s;
+	}
+
+	/// <summary>
+	/// Captures the subtree of root again reusing the buffers of this snapshot. Previous values are discarded.
+	/// </summary>
+	/// <param name="root">The root object. If this is null the snapshot will be empty.</param>
+	/// <param name="flags">What to capture for each object.</param>
+	/// <exception cref="NetScriptFramework::MemoryAccessException">An object in the subtree could not be read, the snapshot is left empty.</exception>
+	void Recapture(NiAVObject ^root, SceneSnapshotFlags flags);
+
+	/// <summary>
+	/// Gets the count of captured objects.
+	/// </summary>
+	property int Count
+	{
+		int get()
+		{
+			return _count;
+		}
+	}
+
+	/// <summary>
+	/// Gets the flags that were used for the last capture.
+	/// </summary>
+	property SceneSnapshotFlags Flags
+	{
+		SceneSnapshotFlags get()
+		{
+			return _flags;
+		}
+	}
+
+	/// <summary>
+	/// Gets the addresses of captured objects. The array may be longer than <see cref="Count"/>.
+	/// </summary>
+	property array<System::IntPtr> ^Nodes
+	{
+		array<System::IntPtr> ^get()
+		{
+			return _nodes;
+		}
+	}
+
+	/// <summary>
+	/// Gets the index of parent for each captured object. This is -1 for the root.
+	/// </summary>
+	property array<int> ^ParentIndices
+	{
+		array<int> ^get()
+		{
+			return _parents;
+		}
+	}
+
+	/// <summary>
+	/// Gets the name hashes or null if they were not captured.
+	/// </summary>
+	property array<System::UInt32> ^NameHashes
+	{
+		array<System::UInt32> ^get()
+		{
+			return (_flags & SceneSnapshotFlags::NameHashes) !=
+			       SceneSnapshotFlags::None
+				       ? _names
+				       : nullptr;
+		}
+	}
+
+	/// <summary>
+	/// Gets the world transforms or null if they were not captured.
+	/// </summary>
+	property array<float> ^WorldTransforms
+	{
+		array<float> ^get()
+		{
+			return (_flags & SceneSnapshotFlags::WorldTransform) !=
+			       SceneSnapshotFlags::None
+				       ? _world
+				       : nullptr;
+		}
+	}
+
+	/// <summary>
+	/// Gets the local transforms or null if they were not captured.
+	/// </summary>
+	property array<float> ^LocalTransforms
+	{
+		array<float> ^get()
+		{
+			return (_flags & SceneSnapshotFlags::LocalTransform) !=
+			       SceneSnapshotFlags::None
+				       ? _local
+				       : nullptr;
+		}
+	}
+
+	/// <summary>
+	/// Gets the object flags or null if they were not captured.
+	/// </summary>
+	property array<System::UInt32> ^ObjectFlags
+	{
+		array<System::UInt32> ^get()
+		{
+			return (_flags & SceneSnapshotFlags::ObjectFlags) !=
+			       SceneSnapshotFlags::None
+				       ? _objectFlags
+				       : nullptr;
+		}
+	}
+
+	/// <summary>
+	/// Gets the captured object at index. This creates a wrapper so prefer the arrays for reading many objects.
+	/// </summary>
+	/// <param name="index">The index.</param>
+	/// <returns></returns>
+	NiAVObject ^GetNode(int index)
+	{
+		if (index < 0 || index >= _count)
+			throw gcnew System::ArgumentOutOfRangeException("index");
+
+		return NetScriptFramework::MemoryObject::FromAddress<
+			NiAVObject ^>(_nodes[index]);
+	}
+
+	/// <summary>
+	/// Finds the index of first captured object with the specified name. Names must have been captured.
+	/// </summary>
+	/// <param name="name">The name of object. This is not case sensitive.</param>
+	/// <returns>The index or -1 if not found.</returns>
+	int IndexOf(System::String ^name);
+
+	/// <summary>
+	/// Calculates the hash of object name the same way as it is captured. This is not case sensitive.
+	/// </summary>
+	/// <param name="name">The name.</param>
+	/// <returns></returns>
+	static System::UInt32 HashName(System::String ^name);
+
+private:
+	void Reserve(int capacity);
+
+	int _count = 0;
+	SceneSnapshotFlags _flags = SceneSnapshotFlags::None;
+	array<System::IntPtr> ^_nodes;
+	array<int> ^_parents;
+	array<System::UInt32> ^_names;
+	array<float> ^_world;
+	array<float> ^_local;
+	array<System::UInt32> ^_objectFlags;
+};
+
 /// <summary>
 /// Implements game string handling.
 /// </summary>
@@ -110,6 +110,75 @@ public:
 		throw gcnew System::ArgumentOutOfRangeException(typeName);
 	}
 
+	// Field accessors for generated implementations. When the library is
+	// built with NSF_UNCHECKED_FIELD_ACCESS these are plain native loads and
+	// stores that the JIT inlines into the caller, otherwise they go through
+	// the guarded memory functions of framework so a bad address throws
+	// MemoryAccessException instead of crashing. Use the checked build when
+	// debugging.
+#ifdef NSF_UNCHECKED_FIELD_ACCESS
+#define MCH_FIELD(Name, Type, NativeType)                                      \
+	static Type Read##Name(System::IntPtr ptr)                             \
+	{                                                                      \
+		return *static_cast<NativeType *>(ptr.ToPointer());            \
+	}                                                                      \
+	static void Write##Name(System::IntPtr ptr, Type value)                \
+	{                                                                      \
+		*static_cast<NativeType *>(ptr.ToPointer()) = value;           \
+	}
+#else
+#define MCH_FIELD(Name, Type, NativeType)                                      \
+	static Type Read##Name(System::IntPtr ptr)                             \
+	{                                                                      \
+		return NetScriptFramework::Memory::Read##Name(ptr, false);     \
+	}                                                                      \
+	static void Write##Name(System::IntPtr ptr, Type value)                \
+	{                                                                      \
+		NetScriptFramework::Memory::Write##Name(ptr, value, false);    \
+	}
+#endif
+
+	MCH_FIELD(Int8, System::SByte, signed char)
+	MCH_FIELD(UInt8, System::Byte, unsigned char)
+	MCH_FIELD(Int16, System::Int16, short)
+	MCH_FIELD(UInt16, System::UInt16, unsigned short)
+	MCH_FIELD(Int32, System::Int32, int)
+	MCH_FIELD(UInt32, System::UInt32, unsigned int)
+	MCH_FIELD(Int64, System::Int64, long long)
+	MCH_FIELD(UInt64, System::UInt64, unsigned long long)
+	MCH_FIELD(Float, System::Single, float)
+	MCH_FIELD(Double, System::Double, double)
+
+#undef MCH_FIELD
+
+	/// <summary>
+	/// Reads a pointer field.
+	/// </summary>
+	/// <param name="ptr">The address of field.</param>
+	/// <returns></returns>
+	static System::IntPtr ReadPointer(System::IntPtr ptr)
+	{
+#ifdef NSF_UNCHECKED_FIELD_ACCESS
+		return System::IntPtr(*static_cast<void **>(ptr.ToPointer()));
+#else
+		return NetScriptFramework::Memory::ReadPointer(ptr, false);
+#endif
+	}
+
+	/// <summary>
+	/// Writes a pointer field.
+	/// </summary>
+	/// <param name="ptr">The address of field.</param>
+	/// <param name="value">The value.</param>
+	static void WritePointer(System::IntPtr ptr, System::IntPtr value)
+	{
+#ifdef NSF_UNCHECKED_FIELD_ACCESS
+		*static_cast<void **>(ptr.ToPointer()) = value.ToPointer();
+#else
+		NetScriptFramework::Memory::WritePointer(ptr, value, false);
+#endif
+	}
+
 internal:
 	/// <summary>
 	/// Convert pointer to a convertible value.
@@ -0,0 +1,666 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Buffers.Binary;
+    using System.Collections.Concurrent;
+    using System.Collections.Generic;
+    using System.Numerics;
+    using System.Runtime.InteropServices;
+    using System.Runtime.Intrinsics;
+    using System.Runtime.Intrinsics.X86;
+
+    /// <summary>
+    ///     Byte pattern with wildcards that is parsed once and can be verified at an address or searched for in memory. The
+    ///     search functions that take a span don't depend on the process so they can also be used on a file dump of a module.
+    ///     This part only works on spans and has no dependencies on the rest of the framework, so tools can compile it in and
+    ///     run on any platform.
+    /// </summary>
+    public sealed partial class BytePattern
+    {
+        /// <summary>
+        ///     The parsed patterns by their text.
+        /// </summary>
+        private static readonly ConcurrentDictionary<string, BytePattern> Cache = new ConcurrentDictionary<string, BytePattern>(StringComparer.Ordinal);
+
+        /// <summary>
+        ///     The section characteristics flag of executable code.
+        /// </summary>
+        private const uint ImageScnMemExecute = 0x20000000;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="BytePattern" /> class.
+        /// </summary>
+        /// <param name="text">The text the pattern was parsed from.</param>
+        /// <param name="parsed">The parsed bytes, null is wildcard.</param>
+        private BytePattern(string text, List<byte?> parsed)
+        {
+            this.Text  = text;
+            this.bytes = new byte[parsed.Count];
+            this.mask  = new byte[parsed.Count];
+            this.first = -1;
+            this.last  = -1;
+
+            for ( var i = 0; i < parsed.Count; i++ )
+            {
+                if ( !parsed[i].HasValue )
+                {
+                    continue;
+                }
+
+                this.bytes[i] = parsed[i].Value;
+                this.mask[i]  = 0xFF;
+
+                if ( this.first < 0 )
+                {
+                    this.first = i;
+                }
+
+                this.last = i;
+            }
+        }
+
+        /// <summary>
+        ///     The bytes, wildcards are zero.
+        /// </summary>
+        private readonly byte[] bytes;
+
+        /// <summary>
+        ///     The mask, 0xFF for bytes that must match and zero for wildcards.
+        /// </summary>
+        private readonly byte[] mask;
+
+        /// <summary>
+        ///     The index of first and last byte that is not a wildcard or -1 if all are wildcards. These are compared first to
+        ///     find candidates.
+        /// </summary>
+        private readonly int first, last;
+
+        /// <summary>
+        ///     Gets the text this pattern was parsed from.
+        /// </summary>
+        /// <value>
+        ///     The text.
+        /// </value>
+        public string Text { get; }
+
+        /// <summary>
+        ///     Gets the length of pattern in bytes.
+        /// </summary>
+        /// <value>
+        ///     The length.
+        /// </value>
+        public int Length => this.bytes.Length;
+
+        /// <summary>
+        ///     Gets the bytes of pattern. Wildcards are zero.
+        /// </summary>
+        /// <value>
+        ///     The bytes.
+        /// </value>
+        public ReadOnlySpan<byte> Bytes => this.bytes;
+
+        /// <summary>
+        ///     Gets the mask of pattern. Bytes that must match are 0xFF and wildcards are zero.
+        /// </summary>
+        /// <value>
+        ///     The mask.
+        /// </value>
+        public ReadOnlySpan<byte> Mask => this.mask;
+
+        /// <summary>
+        ///     Gets the pattern of text. Patterns are cached so the same text is only parsed once.
+        /// </summary>
+        /// <param name="hex">The hexadecimal byte array, see <see cref="Parse" /> for format.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentNullException">hex</exception>
+        /// <exception cref="System.FormatException"></exception>
+        public static BytePattern Get(string hex)
+        {
+            if ( hex == null )
+            {
+                throw new ArgumentNullException(nameof(hex));
+            }
+
+            if ( Cache.TryGetValue(hex, out var result) )
+            {
+                return result;
+            }
+
+            return Cache.GetOrAdd(hex, Parse(hex));
+        }
+
+        /// <summary>
+        ///     Parses the pattern from text. Use ? or * or . symbol for wildcard. Either space or dash is allowed to be separator
+        ///     for bytes. Don't write 0x in front of bytes!
+        /// </summary>
+        /// <param name="hex">The hexadecimal byte array.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentNullException">hex</exception>
+        /// <exception cref="System.FormatException"></exception>
+        public static BytePattern Parse(string hex)
+        {
+            if ( hex == null )
+            {
+                throw new ArgumentNullException(nameof(hex));
+            }
+
+            var parsed = new List<byte?>(32);
+
+            {
+                byte cur_val = 0;
+                var  cur_i   = 0;
+                var  cur_w   = false;
+
+                var index = 0;
+                var len   = hex.Length;
+
+                while ( index < len )
+                {
+                    var c = hex[index];
+
+                    switch ( c )
+                    {
+                        case ' ' :
+                        case '-' :
+                        {
+                            if ( cur_i > 0 )
+                            {
+                                if ( cur_w )
+                                {
+                                    parsed.Add(null);
+                                }
+                                else
+                                {
+                                    parsed.Add(cur_val);
+                                }
+
+                                cur_i   = 0;
+                                cur_val = 0;
+                                cur_w   = false;
+                            }
+
+                            index++;
+                            continue;
+                        }
+
+                        case '*' :
+                        case '?' :
+                        case '.' :
+                        {
+                            if ( cur_i > 0 )
+                            {
+                                if ( cur_w && cur_i == 1 ) // ?[?]
+                                {
+                                    cur_i++;
+                                }
+                                else if ( cur_w && cur_i == 2 ) // ??[?]
+                                {
+                                    parsed.Add(null);
+                                    cur_i = 1;
+                                }
+                                else if ( !cur_w ) // n[?]
+                                {
+                                    parsed.Add(cur_val);
+                                    cur_w   = true;
+                                    cur_i   = 1;
+                                    cur_val = 0;
+                                }
+                            }
+                            else
+                            {
+                                cur_i = 1;
+                                cur_w = true;
+                            }
+
+                            index++;
+                            continue;
+                        }
+
+                        case '0' :
+                        case '1' :
+                        case '2' :
+                        case '3' :
+                        case '4' :
+                        case '5' :
+                        case '6' :
+                        case '7' :
+                        case '8' :
+                        case '9' :
+                        case 'a' :
+                        case 'b' :
+                        case 'c' :
+                        case 'd' :
+                        case 'e' :
+                        case 'f' :
+                        case 'A' :
+                        case 'B' :
+                        case 'C' :
+                        case 'D' :
+                        case 'E' :
+                        case 'F' :
+                        {
+                            byte val = 0;
+
+                            if ( c >= '0' && c <= '9' )
+                            {
+                                val = (byte)(c - '0');
+                            }
+                            else if ( c >= 'a' && c <= 'f' )
+                            {
+                                val = (byte)((c - 'a') + 10);
+                            }
+                            else if ( c >= 'A' && c <= 'F' )
+                            {
+                                val = (byte)((c - 'A') + 10);
+                            }
+
+                            if ( cur_i > 0 )
+                            {
+                                if ( cur_w )
+                                {
+                                    parsed.Add(null);
+                                    cur_i   = 1;
+                                    cur_w   = false;
+                                    cur_val = val;
+                                }
+                                else
+                                {
+                                    cur_val <<= 4;
+                                    cur_val |=  val;
+                                    parsed.Add(cur_val);
+
+                                    cur_val = 0;
+                                    cur_i   = 0;
+                                }
+                            }
+                            else
+                            {
+                                cur_i   = 1;
+                                cur_val = val;
+                            }
+
+                            index++;
+                            continue;
+                        }
+
+                        default : throw new FormatException("Unknown symbol in hex string: '" + c + "'!");
+                    }
+                }
+
+                if ( cur_i > 0 )
+                {
+                    if ( cur_w )
+                    {
+                        parsed.Add(null);
+                    }
+                    else
+                    {
+                        parsed.Add(cur_val);
+                    }
+                }
+            }
+
+            return new BytePattern(hex, parsed);
+        }
+
+        /// <summary>
+        ///     Determines whether the start of data matches this pattern.
+        /// </summary>
+        /// <param name="data">The data.</param>
+        /// <returns></returns>
+        public bool IsMatch(ReadOnlySpan<byte> data) => data.Length >= this.bytes.Length && this.IsMatchAt(data, 0);
+
+        /// <summary>
+        ///     Finds the first position of pattern in data.
+        /// </summary>
+        /// <param name="data">The data.</param>
+        /// <param name="start">The position to start searching from.</param>
+        /// <returns>The position or -1 if not found.</returns>
+        public int IndexOf(ReadOnlySpan<byte> data, int start = 0)
+        {
+            if ( start < 0 )
+            {
+                throw new ArgumentOutOfRangeException(nameof(start));
+            }
+
+            var end = data.Length - this.bytes.Length + 1;
+
+            if ( start >= end )
+            {
+                return -1;
+            }
+
+            if ( this.first < 0 )
+            {
+                return start;
+            }
+
+            var i  = start;
+            var df = this.first;
+            var dl = this.last;
+            var bf = this.bytes[df];
+            var bl = this.bytes[dl];
+
+            // Compare first and last byte of pattern for a whole vector of positions at once, only the positions where
+            // both match are checked fully.
+            if ( Avx2.IsSupported )
+            {
+                var vf = Vector256.Create(bf);
+                var vl = Vector256.Create(bl);
+
+                for ( ; i + Vector256<byte>.Count <= end; i += Vector256<byte>.Count )
+                {
+                    var a = MemoryMarshal.Read<Vector256<byte>>(data.Slice(i + df));
+                    var b = MemoryMarshal.Read<Vector256<byte>>(data.Slice(i + dl));
+                    var m = (uint)Avx2.MoveMask(Avx2.And(Avx2.CompareEqual(a, vf), Avx2.CompareEqual(b, vl)));
+
+                    while ( m != 0 )
+                    {
+                        var pos = i + BitOperations.TrailingZeroCount(m);
+
+                        if ( this.IsMatchAt(data, pos) )
+                        {
+                            return pos;
+                        }
+
+                        m &= m - 1;
+                    }
+                }
+            }
+            else if ( Sse2.IsSupported )
+            {
+                var vf = Vector128.Create(bf);
+                var vl = Vector128.Create(bl);
+
+                for ( ; i + Vector128<byte>.Count <= end; i += Vector128<byte>.Count )
+                {
+                    var a = MemoryMarshal.Read<Vector128<byte>>(data.Slice(i + df));
+                    var b = MemoryMarshal.Read<Vector128<byte>>(data.Slice(i + dl));
+                    var m = (uint)Sse2.MoveMask(Sse2.And(Sse2.CompareEqual(a, vf), Sse2.CompareEqual(b, vl)));
+
+                    while ( m != 0 )
+                    {
+                        var pos = i + BitOperations.TrailingZeroCount(m);
+
+                        if ( this.IsMatchAt(data, pos) )
+                        {
+                            return pos;
+                        }
+
+                        m &= m - 1;
+                    }
+                }
+            }
+
+            for ( ; i < end; i++ )
+            {
+                if ( data[i + df] == bf && data[i + dl] == bl && this.IsMatchAt(data, i) )
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        /// <summary>
+        ///     Finds all positions of pattern in data. Matches may overlap.
+        /// </summary>
+        /// <param name="data">The data.</param>
+        /// <param name="results">The positions are added here.</param>
+        public void FindAll(ReadOnlySpan<byte> data, List<int> results)
+        {
+            if ( results == null )
+            {
+                throw new ArgumentNullException(nameof(results));
+            }
+
+            var pos = this.IndexOf(data);
+
+            while ( pos >= 0 )
+            {
+                results.Add(pos);
+                pos = this.IndexOf(data, pos + 1);
+            }
+        }
+
+        /// <summary>
+        ///     Finds all positions of many patterns in data. Each pattern is searched with the vectorized scan of
+        ///     <see cref="IndexOf" />, which compares two bytes of pattern at once and is faster than looking up every byte of
+        ///     data in a table of patterns.
+        /// </summary>
+        /// <param name="patterns">The patterns. Each pattern must have at least one byte that is not a wildcard.</param>
+        /// <param name="data">The data.</param>
+        /// <param name="results">
+        ///     The index of pattern and position of match are added here, ordered by position. Entries already in the list are
+        ///     kept as they are.
+        /// </param>
+        /// <exception cref="System.ArgumentException">Pattern must have at least one byte that is not a wildcard!</exception>
+        public static void FindAll(IReadOnlyList<BytePattern> patterns, ReadOnlySpan<byte> data, List<KeyValuePair<int, int>> results)
+        {
+            if ( patterns == null )
+            {
+                throw new ArgumentNullException(nameof(patterns));
+            }
+
+            if ( results == null )
+            {
+                throw new ArgumentNullException(nameof(results));
+            }
+
+            FindAll(CheckPatterns(patterns), data, data.Length, results);
+        }
+
+        /// <summary>
+        ///     Gets the executable sections of a PE image, for example a module file read from disk or a dump of a loaded module.
+        ///     Only the headers are read, sections may reach past the end of image if it does not contain all of them.
+        /// </summary>
+        /// <param name="image">The image, at least the headers.</param>
+        /// <param name="mapped">
+        ///     Set to <c>true</c> if the image is laid out as it is in memory after loading, <c>false</c> if it is the file as
+        ///     it is on disk.
+        /// </param>
+        /// <returns>The offset from start of image and size of each section.</returns>
+        /// <exception cref="System.InvalidOperationException">Module does not have a valid PE header!</exception>
+        public static List<KeyValuePair<long, long>> GetCodeSections(ReadOnlySpan<byte> image, bool mapped)
+        {
+            var result = new List<KeyValuePair<long, long>>();
+            var nt     = image.Length >= 0x40 ? BinaryPrimitives.ReadInt32LittleEndian(image.Slice(0x3C)) : -1;
+
+            if ( nt < 0 || nt > image.Length - 24 || BinaryPrimitives.ReadUInt32LittleEndian(image.Slice(nt)) != 0x4550 )
+            {
+                throw new InvalidOperationException("Module does not have a valid PE header!");
+            }
+
+            var sectionCount = BinaryPrimitives.ReadUInt16LittleEndian(image.Slice(nt + 6));
+            var optionalSize = BinaryPrimitives.ReadUInt16LittleEndian(image.Slice(nt + 20));
+            var section      = nt + 24 + optionalSize;
+
+            if ( section + sectionCount * 40 > image.Length )
+            {
+                throw new InvalidOperationException("Module does not have a valid PE header!");
+            }
+
+            for ( var i = 0; i < sectionCount; i++, section += 40 )
+            {
+                var header = image.Slice(section, 40);
+
+                if ( (BinaryPrimitives.ReadUInt32LittleEndian(header.Slice(36)) & ImageScnMemExecute) == 0 )
+                {
+                    continue;
+                }
+
+                var virtualSize = BinaryPrimitives.ReadUInt32LittleEndian(header.Slice(8));
+                var rawSize     = BinaryPrimitives.ReadUInt32LittleEndian(header.Slice(16));
+                var offset      = BinaryPrimitives.ReadUInt32LittleEndian(header.Slice(mapped ? 12 : 20));
+
+                // Raw data of file is padded to file alignment, the padding is not part of the section.
+                var size = mapped ? virtualSize : virtualSize != 0 ? Math.Min(virtualSize, rawSize) : rawSize;
+
+                if ( size != 0 )
+                {
+                    result.Add(new KeyValuePair<long, long>(offset, size));
+                }
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Returns a <see cref="System.String" /> that represents this instance.
+        /// </summary>
+        /// <returns>
+        ///     A <see cref="System.String" /> that represents this instance.
+        /// </returns>
+        public override string ToString() => this.Text;
+
+        /// <summary>
+        ///     Determines whether data at position matches. Data must be long enough.
+        /// </summary>
+        /// <param name="data">The data.</param>
+        /// <param name="position">The position.</param>
+        /// <returns></returns>
+        private bool IsMatchAt(ReadOnlySpan<byte> data, int position)
+        {
+            var bytes = this.bytes;
+            var mask  = this.mask;
+
+            if ( data.Length - position < bytes.Length )
+            {
+                return false;
+            }
+
+            for ( var i = 0; i < bytes.Length; i++ )
+            {
+                if ( (data[position + i] & mask[i]) != bytes[i] )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        ///     Checks that each pattern has a byte to search for and copies them to an array.
+        /// </summary>
+        /// <param name="patterns">The patterns.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentException">Pattern must have at least one byte that is not a wildcard!</exception>
+        private static BytePattern[] CheckPatterns(IReadOnlyList<BytePattern> patterns)
+        {
+            var result = new BytePattern[patterns.Count];
+
+            for ( var i = 0; i < result.Length; i++ )
+            {
+                var x = patterns[i];
+
+                if ( x == null )
+                {
+                    throw new ArgumentNullException(nameof(patterns));
+                }
+
+                if ( x.first < 0 )
+                {
+                    throw new ArgumentException("Pattern must have at least one byte that is not a wildcard!", nameof(patterns));
+                }
+
+                result[i] = x;
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Finds all matches of patterns that begin before the accept position.
+        /// </summary>
+        /// <param name="patterns">The patterns.</param>
+        /// <param name="data">The data.</param>
+        /// <param name="accept">Matches must begin before this position.</param>
+        /// <param name="results">The results.</param>
+        private static void FindAll(BytePattern[] patterns, ReadOnlySpan<byte> data, int accept, List<KeyValuePair<int, int>> results)
+        {
+            var first = results.Count;
+            var runs  = new int[patterns.Length + 1];
+
+            for ( var i = 0; i < patterns.Length; i++ )
+            {
+                var x   = patterns[i];
+                var pos = x.IndexOf(data);
+
+                runs[i] = results.Count - first;
+
+                while ( pos >= 0 && pos < accept )
+                {
+                    results.Add(new KeyValuePair<int, int>(i, pos));
+                    pos = x.IndexOf(data, pos + 1);
+                }
+            }
+
+            runs[patterns.Length] = results.Count - first;
+
+            MergeByPosition(results, first, runs);
+        }
+
+        /// <summary>
+        ///     Merges the matches of each pattern, which are already ordered by position, so that all matches from index are
+        ///     ordered by position and then by pattern. Entries before index are left as they are.
+        /// </summary>
+        /// <param name="results">The results.</param>
+        /// <param name="index">The index of first match.</param>
+        /// <param name="runs">The offset of matches of each pattern from index and the count of all matches at the end.</param>
+        private static void MergeByPosition(List<KeyValuePair<int, int>> results, int index, int[] runs)
+        {
+            var count    = results.Count - index;
+            var runCount = runs.Length - 1;
+
+            if ( count < 2 || runCount < 2 )
+            {
+                return;
+            }
+
+            var source = new KeyValuePair<int, int>[count];
+            var target = new KeyValuePair<int, int>[count];
+
+            results.CopyTo(index, source, 0, count);
+
+            // Merge neighbouring runs until one is left, the left run goes first on equal positions so pattern order is kept.
+            while ( runCount > 1 )
+            {
+                var merged = 0;
+
+                for ( var r = 0; r < runCount; r += 2 )
+                {
+                    var begin = runs[r];
+                    var mid   = runs[Math.Min(r + 1, runCount)];
+                    var end   = runs[Math.Min(r + 2, runCount)];
+                    var i     = begin;
+                    var j     = mid;
+                    var k     = begin;
+
+                    while ( i < mid && j < end )
+                    {
+                        target[k++] = source[j].Value < source[i].Value ? source[j++] : source[i++];
+                    }
+
+                    Array.Copy(source, i, target, k, mid - i);
+                    Array.Copy(source, j, target, k + mid - i, end - j);
+
+                    runs[merged++] = begin;
+                }
+
+                runs[merged] = runs[runCount];
+                runCount     = merged;
+
+                var swap = source;
+                source = target;
+                target = swap;
+            }
+
+            for ( var i = 0; i < count; i++ )
+            {
+                results[index + i] = source[i];
+            }
+        }
+    }
+}
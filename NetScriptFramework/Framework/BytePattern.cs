@@ -0,0 +1,246 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Diagnostics;
+
+    /// <summary>
+    ///     The part of byte pattern that searches the memory of current process.
+    /// </summary>
+    public sealed partial class BytePattern
+    {
+        /// <summary>
+        ///     The count of bytes read from memory at once when searching.
+        /// </summary>
+        private const int ScanChunkSize = 0x100000;
+
+        /// <summary>
+        ///     Verifies the bytes at address.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <param name="protect">
+        ///     If set to <c>true</c> then change protection flags of memory page before reading and return after.
+        ///     Only set this true if you are sure you don't have read permissions!
+        /// </param>
+        /// <returns></returns>
+        public bool Verify(IntPtr address, bool protect = false)
+        {
+            if ( this.bytes.Length == 0 )
+            {
+                return true;
+            }
+
+            if ( protect )
+            {
+                return this.IsMatchAt(Memory.ReadBytes(address, this.bytes.Length, true), 0);
+            }
+
+            return this.IsMatchAt(Memory.ReadBytesSpan(address, this.bytes.Length), 0);
+        }
+
+        /// <summary>
+        ///     Finds the first position of pattern in memory.
+        /// </summary>
+        /// <param name="begin">The begin address.</param>
+        /// <param name="length">The length of memory to search.</param>
+        /// <returns></returns>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        public IntPtr? FindFirst(IntPtr begin, long length)
+        {
+            IntPtr? result = null;
+
+            ScanMemory(
+                begin,
+                length,
+                this.bytes.Length,
+                (chunk, offset, accept) =>
+                {
+                    var pos = this.IndexOf(chunk);
+
+                    if ( pos < 0 || pos >= accept )
+                    {
+                        return true;
+                    }
+
+                    result = new IntPtr(begin.ToInt64() + offset + pos);
+                    return false;
+                }
+            );
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Finds all positions of pattern in memory.
+        /// </summary>
+        /// <param name="begin">The begin address.</param>
+        /// <param name="length">The length of memory to search.</param>
+        /// <returns></returns>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        public List<IntPtr> FindAll(IntPtr begin, long length)
+        {
+            var result    = new List<IntPtr>();
+            var positions = new List<int>();
+
+            ScanMemory(
+                begin,
+                length,
+                this.bytes.Length,
+                (chunk, offset, accept) =>
+                {
+                    positions.Clear();
+                    this.FindAll(chunk, positions);
+
+                    foreach ( var pos in positions )
+                    {
+                        if ( pos < accept )
+                        {
+                            result.Add(new IntPtr(begin.ToInt64() + offset + pos));
+                        }
+                    }
+
+                    return true;
+                }
+            );
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Finds all positions of pattern in the executable sections of a module.
+        /// </summary>
+        /// <param name="module">The module or null for main targeted module.</param>
+        /// <returns></returns>
+        public List<IntPtr> FindAllInModule(ProcessModule module = null)
+        {
+            var result = new List<IntPtr>();
+
+            foreach ( var section in GetCodeSections((module ?? Main.GetMainTargetedModule()).BaseAddress) )
+            {
+                result.AddRange(this.FindAll(section.Key, section.Value));
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Finds all positions of many patterns in the executable sections of a module. Memory is read once and every
+        ///     pattern is searched in each chunk while it is in cache.
+        /// </summary>
+        /// <param name="patterns">The patterns. Each pattern must have at least one byte that is not a wildcard.</param>
+        /// <param name="module">The module or null for main targeted module.</param>
+        /// <returns>The pattern and address of each match, ordered by address.</returns>
+        /// <exception cref="System.ArgumentException">Pattern must have at least one byte that is not a wildcard!</exception>
+        public static List<KeyValuePair<BytePattern, IntPtr>> FindAllInModule(IReadOnlyList<BytePattern> patterns, ProcessModule module = null)
+        {
+            if ( patterns == null )
+            {
+                throw new ArgumentNullException(nameof(patterns));
+            }
+
+            var list      = CheckPatterns(patterns);
+            var maxLength = 0;
+
+            foreach ( var x in patterns )
+            {
+                maxLength = Math.Max(maxLength, x.Length);
+            }
+
+            var result  = new List<KeyValuePair<BytePattern, IntPtr>>();
+            var matches = new List<KeyValuePair<int, int>>();
+
+            foreach ( var section in GetCodeSections((module ?? Main.GetMainTargetedModule()).BaseAddress) )
+            {
+                var begin = section.Key;
+
+                ScanMemory(
+                    begin,
+                    section.Value,
+                    maxLength,
+                    (chunk, offset, accept) =>
+                    {
+                        matches.Clear();
+                        FindAll(list, chunk, accept, matches);
+
+                        foreach ( var x in matches )
+                        {
+                            result.Add(new KeyValuePair<BytePattern, IntPtr>(patterns[x.Key], new IntPtr(begin.ToInt64() + offset + x.Value)));
+                        }
+
+                        return true;
+                    }
+                );
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Gets the executable sections of a loaded module.
+        /// </summary>
+        /// <param name="moduleBase">The module base address.</param>
+        /// <returns>The begin address and size of each section.</returns>
+        /// <exception cref="System.InvalidOperationException">Module does not have a valid PE header!</exception>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        internal static List<KeyValuePair<IntPtr, long>> GetCodeSections(IntPtr moduleBase)
+        {
+            var result = new List<KeyValuePair<IntPtr, long>>();
+            var nt     = Memory.ReadInt32(moduleBase + 0x3C);
+
+            if ( nt < 0 || Memory.ReadUInt32(moduleBase + nt) != 0x4550 )
+            {
+                throw new InvalidOperationException("Module does not have a valid PE header!");
+            }
+
+            var headerSize = nt + 24 + Memory.ReadUInt16(moduleBase + nt + 20) + Memory.ReadUInt16(moduleBase + nt + 6) * 40;
+
+            foreach ( var x in GetCodeSections(Memory.ReadBytes(moduleBase, headerSize), true) )
+            {
+                result.Add(new KeyValuePair<IntPtr, long>(new IntPtr(moduleBase.ToInt64() + x.Key), x.Value));
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Callback for searching a chunk of memory.
+        /// </summary>
+        /// <param name="chunk">The chunk.</param>
+        /// <param name="offset">The offset of chunk from begin address.</param>
+        /// <param name="accept">Matches must begin before this position, later ones are found again in next chunk.</param>
+        /// <returns>True to continue searching.</returns>
+        private delegate bool ChunkScanner(ReadOnlySpan<byte> chunk, long offset, int accept);
+
+        /// <summary>
+        ///     Reads the memory in chunks that overlap by the pattern length so a match is never split between two chunks.
+        /// </summary>
+        /// <param name="begin">The begin address.</param>
+        /// <param name="length">The length.</param>
+        /// <param name="patternLength">The length of longest pattern.</param>
+        /// <param name="scanner">The scanner.</param>
+        private static void ScanMemory(IntPtr begin, long length, int patternLength, ChunkScanner scanner)
+        {
+            if ( length <= 0 )
+            {
+                return;
+            }
+
+            var overlap = Math.Max(0, patternLength - 1);
+            var buffer  = new byte[(int)Math.Min(length, ScanChunkSize + overlap)];
+
+            for ( long offset = 0; offset < length; offset += ScanChunkSize )
+            {
+                var size  = (int)Math.Min(length - offset, ScanChunkSize + overlap);
+                var chunk = new Span<byte>(buffer, 0, size);
+                Memory.ReadBytes(new IntPtr(begin.ToInt64() + offset), chunk);
+
+                var accept = offset + ScanChunkSize >= length ? size : ScanChunkSize;
+
+                if ( !scanner(chunk, offset, accept) )
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
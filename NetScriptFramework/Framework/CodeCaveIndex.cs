@@ -0,0 +1,419 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Numerics;
+    using System.Runtime.InteropServices;
+
+    /// <summary>
+    ///     Index of code caves in the executable sections of loaded modules. A code cave is a run of 0xCC padding bytes
+    ///     between functions. Each section is scanned once when a cave is first requested from it and caves are then handed
+    ///     out with best fit so that two hooks never get the same cave.
+    /// </summary>
+    public static class CodeCaveIndex
+    {
+        /// <summary>
+        ///     The smallest cave that is recorded, enough for a relative jump.
+        /// </summary>
+        public const int MinCaveSize = 5;
+
+        /// <summary>
+        ///     The count of bytes read from memory at once when scanning.
+        /// </summary>
+        private const int ScanChunkSize = 0x100000;
+
+        /// <summary>
+        ///     The locker.
+        /// </summary>
+        private static readonly object Locker = new object();
+
+        /// <summary>
+        ///     The scanned sections by begin address.
+        /// </summary>
+        private static readonly SortedList<long, CaveSection> Sections = new SortedList<long, CaveSection>();
+
+        /// <summary>
+        ///     Reserves the smallest free cave of at least the specified size in the executable section that contains the
+        ///     address. The cave is removed from index so it is never returned again.
+        /// </summary>
+        /// <param name="address">An address in the executable section of a module.</param>
+        /// <param name="size">The size of code to write.</param>
+        /// <returns>The address of reserved cave or zero if none was found.</returns>
+        public static IntPtr Reserve(IntPtr address, int size)
+        {
+            var section = GetSection(address);
+            return section != null ? Reserve(section, section.Begin, section.End, size) : IntPtr.Zero;
+        }
+
+        /// <summary>
+        ///     Reserves the smallest free cave of at least the specified size that is completely inside the range. The range must
+        ///     be in an executable section of a module.
+        /// </summary>
+        /// <param name="begin">The begin of range.</param>
+        /// <param name="end">The end of range.</param>
+        /// <param name="size">The size of code to write.</param>
+        /// <returns>The address of reserved cave or zero if none was found.</returns>
+        public static IntPtr Reserve(IntPtr begin, IntPtr end, int size)
+        {
+            var section = GetSection(begin);
+            return section != null ? Reserve(section, begin.ToInt64(), end.ToInt64(), size) : IntPtr.Zero;
+        }
+
+        /// <summary>
+        ///     Gets the addresses of all free caves of at least the specified size in the executable section that contains the
+        ///     address. Nothing is reserved.
+        /// </summary>
+        /// <param name="address">An address in the executable section of a module.</param>
+        /// <param name="size">The size.</param>
+        /// <returns></returns>
+        public static List<IntPtr> GetFree(IntPtr address, int size)
+        {
+            var result  = new List<IntPtr>();
+            var section = GetSection(address);
+
+            if ( section == null )
+            {
+                return result;
+            }
+
+            lock ( Locker )
+            {
+                foreach ( var x in section.ByAddress )
+                {
+                    if ( x.Length >= size )
+                    {
+                        result.Add(new IntPtr(x.Address));
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Determines whether the address is in an executable section of a loaded module.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <returns></returns>
+        internal static bool IsIndexed(IntPtr address) => GetSection(address) != null;
+
+        /// <summary>
+        ///     Reserves a cave in section.
+        /// </summary>
+        /// <param name="section">The section.</param>
+        /// <param name="begin">The begin of allowed range.</param>
+        /// <param name="end">The end of allowed range.</param>
+        /// <param name="size">The size.</param>
+        /// <returns></returns>
+        private static IntPtr Reserve(CaveSection section, long begin, long end, int size)
+        {
+            if ( size <= 0 )
+            {
+                throw new ArgumentOutOfRangeException(nameof(size));
+            }
+
+            lock ( Locker )
+            {
+                while ( true )
+                {
+                    Cave best = null;
+
+                    foreach ( var x in section.BySize.GetViewBetween(new Cave(0, size), new Cave(long.MaxValue, int.MaxValue)) )
+                    {
+                        if ( x.Address >= begin && x.Address + size <= end )
+                        {
+                            best = x;
+                            break;
+                        }
+                    }
+
+                    if ( best == null )
+                    {
+                        return IntPtr.Zero;
+                    }
+
+                    section.Remove(best);
+
+                    // Something other than the framework may have written here since the scan.
+                    var bytes = Memory.ReadBytesSpan(new IntPtr(best.Address), size);
+
+                    if ( IndexOfNotPadding(bytes) >= 0 )
+                    {
+                        continue;
+                    }
+
+                    if ( best.Length - size >= MinCaveSize )
+                    {
+                        section.Add(new Cave(best.Address + size, best.Length - size));
+                    }
+
+                    return new IntPtr(best.Address);
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Gets the scanned section that contains the address, scans it if needed.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <returns></returns>
+        private static CaveSection GetSection(IntPtr address)
+        {
+            var value = address.ToInt64();
+
+            lock ( Locker )
+            {
+                foreach ( var x in Sections.Values )
+                {
+                    if ( value >= x.Begin && value < x.End )
+                    {
+                        return x;
+                    }
+                }
+
+                var moduleBase = Memory.GetAllocationBase(address);
+
+                if ( moduleBase == IntPtr.Zero )
+                {
+                    return null;
+                }
+
+                List<KeyValuePair<IntPtr, long>> codeSections;
+
+                try
+                {
+                    codeSections = BytePattern.GetCodeSections(moduleBase);
+                }
+                catch ( Exception ex ) when ( ex is InvalidOperationException || ex is MemoryAccessException )
+                {
+                    return null;
+                }
+
+                foreach ( var x in codeSections )
+                {
+                    var begin = x.Key.ToInt64();
+
+                    if ( value < begin || value >= begin + x.Value )
+                    {
+                        continue;
+                    }
+
+                    var section = Scan(x.Key, x.Value);
+                    Sections[begin] = section;
+                    return section;
+                }
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        ///     Scans the section for runs of padding. A run that follows a return can be used from its first byte, otherwise the
+        ///     first padding byte is kept so the previous instruction is never extended.
+        /// </summary>
+        /// <param name="begin">The begin of section.</param>
+        /// <param name="length">The length of section.</param>
+        /// <returns></returns>
+        private static CaveSection Scan(IntPtr begin, long length)
+        {
+            var result   = new CaveSection(begin.ToInt64(), begin.ToInt64() + length);
+            var buffer   = new byte[(int)Math.Min(length, ScanChunkSize)];
+            var runStart = -1L;
+            var afterRet = false;
+            byte prev    = 0;
+
+            for ( long offset = 0; offset < length; offset += buffer.Length )
+            {
+                var size  = (int)Math.Min(length - offset, buffer.Length);
+                var chunk = new Span<byte>(buffer, 0, size);
+                Memory.ReadBytes(new IntPtr(result.Begin + offset), chunk);
+
+                var i = 0;
+
+                while ( i < size )
+                {
+                    if ( runStart < 0 )
+                    {
+                        var next = chunk.Slice(i).IndexOf((byte)0xCC);
+
+                        if ( next < 0 )
+                        {
+                            break;
+                        }
+
+                        i        += next;
+                        runStart =  offset + i;
+                        afterRet =  (i > 0 ? chunk[i - 1] : prev) == 0xC3;
+                    }
+
+                    var run = IndexOfNotPadding(chunk.Slice(i));
+
+                    if ( run < 0 )
+                    {
+                        i = size;
+                        break;
+                    }
+
+                    i += run;
+                    result.AddRun(runStart, offset + i, afterRet);
+                    runStart = -1;
+                }
+
+                prev = chunk[size - 1];
+            }
+
+            if ( runStart >= 0 )
+            {
+                result.AddRun(runStart, length, afterRet);
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Finds the first byte that is not 0xCC.
+        /// </summary>
+        /// <param name="data">The data.</param>
+        /// <returns>The index or -1 if all bytes are padding.</returns>
+        private static int IndexOfNotPadding(ReadOnlySpan<byte> data)
+        {
+            var i = 0;
+
+            if ( Vector.IsHardwareAccelerated )
+            {
+                var padding = new Vector<byte>(0xCC);
+
+                for ( ; i + Vector<byte>.Count <= data.Length; i += Vector<byte>.Count )
+                {
+                    if ( MemoryMarshal.Read<Vector<byte>>(data.Slice(i)) != padding )
+                    {
+                        break;
+                    }
+                }
+            }
+
+            for ( ; i < data.Length; i++ )
+            {
+                if ( data[i] != 0xCC )
+                {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        /// <summary>
+        ///     Free code cave.
+        /// </summary>
+        private sealed class Cave
+        {
+            /// <summary>
+            ///     Initializes a new instance of the <see cref="Cave" /> class.
+            /// </summary>
+            /// <param name="address">The address.</param>
+            /// <param name="length">The length.</param>
+            internal Cave(long address, int length)
+            {
+                this.Address = address;
+                this.Length  = length;
+            }
+
+            /// <summary>
+            ///     The address.
+            /// </summary>
+            internal readonly long Address;
+
+            /// <summary>
+            ///     The length.
+            /// </summary>
+            internal readonly int Length;
+        }
+
+        /// <summary>
+        ///     Free caves of one executable section, sorted both by address and by size.
+        /// </summary>
+        private sealed class CaveSection
+        {
+            /// <summary>
+            ///     Initializes a new instance of the <see cref="CaveSection" /> class.
+            /// </summary>
+            /// <param name="begin">The begin.</param>
+            /// <param name="end">The end.</param>
+            internal CaveSection(long begin, long end)
+            {
+                this.Begin = begin;
+                this.End   = end;
+            }
+
+            /// <summary>
+            ///     The begin address of section.
+            /// </summary>
+            internal readonly long Begin;
+
+            /// <summary>
+            ///     The end address of section.
+            /// </summary>
+            internal readonly long End;
+
+            /// <summary>
+            ///     The caves sorted by address.
+            /// </summary>
+            internal readonly SortedSet<Cave> ByAddress = new SortedSet<Cave>(Comparer<Cave>.Create((u, v) => u.Address.CompareTo(v.Address)));
+
+            /// <summary>
+            ///     The caves sorted by size and then address.
+            /// </summary>
+            internal readonly SortedSet<Cave> BySize = new SortedSet<Cave>(
+                Comparer<Cave>.Create(
+                    (u, v) =>
+                    {
+                        var c = u.Length.CompareTo(v.Length);
+                        return c != 0 ? c : u.Address.CompareTo(v.Address);
+                    }
+                )
+            );
+
+            /// <summary>
+            ///     Adds a run of padding found by scan.
+            /// </summary>
+            /// <param name="begin">The begin offset of run in section.</param>
+            /// <param name="end">The end offset of run in section.</param>
+            /// <param name="afterRet">Does the run follow a return instruction.</param>
+            internal void AddRun(long begin, long end, bool afterRet)
+            {
+                if ( !afterRet )
+                {
+                    begin++;
+                }
+
+                var length = end - begin;
+
+                if ( length >= MinCaveSize )
+                {
+                    this.Add(new Cave(this.Begin + begin, (int)Math.Min(length, int.MaxValue)));
+                }
+            }
+
+            /// <summary>
+            ///     Adds the cave.
+            /// </summary>
+            /// <param name="cave">The cave.</param>
+            internal void Add(Cave cave)
+            {
+                this.ByAddress.Add(cave);
+                this.BySize.Add(cave);
+            }
+
+            /// <summary>
+            ///     Removes the cave.
+            /// </summary>
+            /// <param name="cave">The cave.</param>
+            internal void Remove(Cave cave)
+            {
+                this.ByAddress.Remove(cave);
+                this.BySize.Remove(cave);
+            }
+        }
+    }
+}
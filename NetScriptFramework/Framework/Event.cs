@@ -4,6 +4,7 @@ namespace NetScriptFramework
     using System.Collections.Generic;
     using System.Linq;
     using System.Reflection;
+    using System.Threading;
 
     /// <summary>
     ///     Contains information about a single event registration.
@@ -51,6 +52,29 @@ namespace NetScriptFramework
         internal int TotalCount;
     }
 
+    /// <summary>
+    ///     Immutable view of registrations that is published to raising threads. A new snapshot is created each time the
+    ///     registrations change so raising an event never needs to lock.
+    /// </summary>
+    internal sealed class EventSnapshot
+    {
+        /// <summary>
+        ///     The combined handler of all registrations.
+        /// </summary>
+        internal Delegate Handler;
+
+        /// <summary>
+        ///     The registrations in order of priority. This is only set if any of them has a count limit, in that case the
+        ///     handlers are invoked one by one so each limit is exact even when raised from many threads.
+        /// </summary>
+        internal EventRegistration[] Counted;
+
+        /// <summary>
+        ///     Whether the registration at same index in <see cref="Counted" /> has its handler invoked.
+        /// </summary>
+        internal bool[] Invoke;
+    }
+
     /// <summary>
     ///     Options for an event registration.
     /// </summary>
@@ -84,7 +108,7 @@ namespace NetScriptFramework
         public readonly string Key;
 
         /// <summary>
-        ///     The locker for thread safety.
+        ///     The locker for changing registrations. Raising the event does not lock.
         /// </summary>
         internal readonly object Locker = new object();
 
@@ -94,9 +118,9 @@ namespace NetScriptFramework
         private readonly List<EventRegistration> Registrations = new List<EventRegistration>(32);
 
         /// <summary>
-        ///     The current handler.
+        ///     The current snapshot of registrations or null if there are no handlers.
         /// </summary>
-        private Delegate Handler;
+        private EventSnapshot Snapshot;
 
         /// <summary>
         ///     Initializes a new instance of the <see cref="EventBase" /> class.
@@ -122,10 +146,43 @@ namespace NetScriptFramework
         ///     may return a delegate or multi-cast delegate.
         /// </summary>
         /// <returns></returns>
-        protected internal Delegate _GetHandler() => this.Handler;
+        protected internal Delegate _GetHandler() => Volatile.Read(ref this.Snapshot)?.Handler;
+
+        /// <summary>
+        ///     Gets the current snapshot of registrations without locking.
+        /// </summary>
+        /// <returns></returns>
+        internal EventSnapshot _GetSnapshot() => Volatile.Read(ref this.Snapshot);
+
+        /// <summary>
+        ///     Removes registrations that have reached their count limit. This is called by the thread that used up the last
+        ///     count of a registration.
+        /// </summary>
+        internal void _RemoveExpired()
+        {
+            lock ( this.Locker )
+            {
+                var removed = false;
+
+                for ( var i = this.Registrations.Count - 1; i >= 0; i-- )
+                {
+                    var reg = this.Registrations[i];
+
+                    if ( reg.TotalCount > 0 && Volatile.Read(ref reg.CurrentCount) <= 0 && this._UnregisterByIndex(i) )
+                    {
+                        removed = true;
+                    }
+                }
+
+                if ( removed )
+                {
+                    this._Recalculate();
+                }
+            }
+        }
 
         /// <summary>
-        ///     Reduce counts of registrations.
+        ///     Reduce counts of registrations. The caller must hold <see cref="Locker" />.
         /// </summary>
         /// <param name="amount">The amount.</param>
         protected internal bool _ReduceCounts(int amount)
@@ -141,9 +198,7 @@ namespace NetScriptFramework
                     continue;
                 }
 
-                reg.CurrentCount -= amount;
-
-                if ( reg.CurrentCount <= 0 )
+                if ( Interlocked.Add(ref reg.CurrentCount, -amount) <= 0 )
                 {
                     if ( this._UnregisterByIndex(i) )
                     {
@@ -250,21 +305,28 @@ namespace NetScriptFramework
         }
 
         /// <summary>
-        ///     Forces a recalculation of the event handler delegate.
+        ///     Forces a recalculation of the event handler delegate. The caller must hold <see cref="Locker" />, the new
+        ///     snapshot is published atomically so raising threads see either the old or the new handlers.
         /// </summary>
         protected internal void _Recalculate()
         {
-            var had = this.Handler != null;
-            this.Handler = null;
+            EventSnapshot snapshot = null;
 
             if ( this.Registrations.Count != 0 )
             {
-                var list = new List<Delegate>();
+                var list    = new List<Delegate>();
+                var invoke  = new bool[this.Registrations.Count];
+                var counted = false;
 
                 for ( var i = 0; i < this.Registrations.Count; i++ )
                 {
                     var reg = this.Registrations[i];
 
+                    if ( reg.TotalCount > 0 )
+                    {
+                        counted = true;
+                    }
+
                     if ( reg.Handler == null )
                     {
                         continue;
@@ -276,22 +338,34 @@ namespace NetScriptFramework
                     }
 
                     list.Add(reg.Handler);
+                    invoke[i] = true;
                 }
 
-                if ( list.Count == 0 )
-                {
-                    this.Handler = null;
-                }
-                else if ( list.Count == 1 )
+                if ( list.Count != 0 )
                 {
-                    this.Handler = list[0];
-                }
-                else
-                {
-                    this.Handler = Delegate.Combine(list.ToArray());
+                    snapshot = new EventSnapshot
+                    {
+                        Handler = list.Count == 1 ? list[0] : Delegate.Combine(list.ToArray()),
+                        Counted = counted ? this.Registrations.ToArray() : null,
+                        Invoke  = counted ? invoke : null
+                    };
                 }
             }
+
+            var had = Interlocked.Exchange(ref this.Snapshot, snapshot) != null;
+
+            if ( had != (snapshot != null) )
+            {
+                this._OnHandlersChanged(snapshot != null);
+            }
         }
+
+        /// <summary>
+        ///     Called when the first handler is registered or the last handler is removed. The caller holds
+        ///     <see cref="Locker" />.
+        /// </summary>
+        /// <param name="hasHandlers">Whether the event has any handlers now.</param>
+        protected internal virtual void _OnHandlersChanged(bool hasHandlers) { }
     }
 
     /// <summary>
@@ -366,36 +440,86 @@ namespace NetScriptFramework
         ///     Raises the event with specified argument initializer. This initialize is only called if event has handlers
         ///     registered.
         ///     Returns the arguments after raising event, if no handlers were registered then null is returned.
+        ///     The event may be raised from many threads at once, handlers are not serialized.
         /// </summary>
         /// <param name="initArgs">The initialize arguments function.</param>
         /// <returns></returns>
         public virtual T Raise(Func<T> initArgs)
         {
-            lock ( this.Locker )
+            var snapshot = this._GetSnapshot();
+
+            if ( snapshot == null )
             {
-                var handlerBase = this._GetHandler();
+                return null;
+            }
 
-                if ( handlerBase == null )
+            var args = initArgs();
+            this.Invoke(snapshot, args);
+            return args;
+        }
+
+        /// <summary>
+        ///     Invokes the handlers of snapshot. Count limited registrations take one count each with an atomic decrement
+        ///     before their handler is invoked, a handler whose count was already used up by another thread is skipped.
+        /// </summary>
+        /// <param name="snapshot">The snapshot.</param>
+        /// <param name="args">The arguments.</param>
+        internal void Invoke(EventSnapshot snapshot, T args)
+        {
+            var counted = snapshot.Counted;
+
+            if ( counted == null )
+            {
+                ((EventHandler)snapshot.Handler)(args);
+                return;
+            }
+
+            var invoke  = snapshot.Invoke;
+            var expired = false;
+
+            // Counts that were used up are removed even if a handler throws, otherwise the registration would stay in every
+            // snapshot after this.
+            try
+            {
+                for ( var i = 0; i < counted.Length; i++ )
                 {
-                    return null;
-                }
+                    var reg = counted[i];
 
-                var handler = (EventHandler)handlerBase;
-                var args    = initArgs();
-                handler(args);
+                    if ( reg.TotalCount > 0 )
+                    {
+                        var left = Interlocked.Decrement(ref reg.CurrentCount);
 
-                if ( this._ReduceCounts(1) )
+                        if ( left < 0 )
+                        {
+                            continue;
+                        }
+
+                        if ( left == 0 )
+                        {
+                            expired = true;
+                        }
+                    }
+
+                    if ( invoke[i] )
+                    {
+                        ((EventHandler)reg.Handler)(args);
+                    }
+                }
+            }
+            finally
+            {
+                if ( expired )
                 {
-                    this._Recalculate();
+                    this._RemoveExpired();
                 }
-
-                return args;
             }
         }
     }
 
     /// <summary>
-    ///     Base event arguments for hooked event.
+    ///     Base event arguments for hooked event. If <see cref="EventHook{T}.PooledArgs" /> is enabled the same instance is
+    ///     refilled each time the event is raised on a thread, use <see cref="Copy" /> to keep the values after the handler
+    ///     returns.
     /// </summary>
     /// <seealso cref="System.EventArgs" />
     public class HookedEventArgs : EventArgs
@@ -407,6 +531,13 @@ namespace NetScriptFramework
         ///     The context.
         /// </value>
         public CPURegisters Context { get; internal set; }
+
+        /// <summary>
+        ///     Creates a shallow copy of the arguments that is not reused by the event. Game objects in the copy are only valid as
+        ///     long as the game keeps them alive and the context must not be used after the handler returns.
+        /// </summary>
+        /// <returns></returns>
+        public HookedEventArgs Copy() => (HookedEventArgs)this.MemberwiseClone();
     }
 
     /// <summary>
@@ -434,6 +565,36 @@ namespace NetScriptFramework
             this.AfterFunc     = afterFunc;
         }
 
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="EventHookParameters{T}" /> class with an argument function that can
+        ///     refill an existing arguments instance.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <param name="replaceLength">Length of the replace.</param>
+        /// <param name="includeLength">Length of the include.</param>
+        /// <param name="pattern">The expected pattern at location.</param>
+        /// <param name="fillFunc">
+        ///     The argument function. The second parameter is the instance to refill or null if a new instance must be
+        ///     created.
+        /// </param>
+        /// <param name="afterFunc">The after function.</param>
+        /// <exception cref="System.ArgumentNullException">fillFunc</exception>
+        public EventHookParameters(IntPtr address, int replaceLength, int includeLength, string pattern, Func<CPURegisters, T, T> fillFunc, Action<CPURegisters, T> afterFunc)
+        {
+            if ( fillFunc == null )
+            {
+                throw new ArgumentNullException(nameof(fillFunc));
+            }
+
+            this.Address       = address;
+            this.ReplaceLength = replaceLength;
+            this.IncludeLength = includeLength;
+            this.Pattern       = pattern;
+            this.FillFunc      = fillFunc;
+            this.ArgFunc       = ctx => fillFunc(ctx, null);
+            this.AfterFunc     = afterFunc;
+        }
+
         /// <summary>
         ///     Gets or sets the address.
         /// </summary>
@@ -474,6 +635,14 @@ namespace NetScriptFramework
         /// </value>
         public Func<CPURegisters, T> ArgFunc { get; internal set; }
 
+        /// <summary>
+        ///     Gets the argument function that refills an existing instance or null if the arguments can't be reused.
+        /// </summary>
+        /// <value>
+        ///     The fill function.
+        /// </value>
+        public Func<CPURegisters, T, T> FillFunc { get; internal set; }
+
         /// <summary>
         ///     Gets or sets the after function.
         /// </summary>
@@ -500,6 +669,16 @@ namespace NetScriptFramework
     /// <typeparam name="T">Type of event arguments.</typeparam>
     public sealed class EventHook <T> : Event<T> where T : HookedEventArgs
     {
+        /// <summary>
+        ///     The reusable arguments of current thread or null if taken by a raise in progress.
+        /// </summary>
+        [ ThreadStatic ]
+        private static T _pooledArgs;
+
+        /// <summary>
+        ///     Whether arguments are reused, negative if not read from configuration yet.
+        /// </summary>
+        private int _pooled = -1;
         /// <summary>
         ///     The arguments.
         /// </summary>
@@ -510,6 +689,11 @@ namespace NetScriptFramework
         /// </summary>
         private readonly EventHookFlags HookFlags;
 
+        /// <summary>
+        ///     The hooks of event, these are only active while the event has handlers unless it always runs.
+        /// </summary>
+        private readonly HookInfo[] Hooks;
+
         /// <summary>
         ///     Initializes a new instance of the <see cref="EventHook{T}" /> class.
         /// </summary>
@@ -532,6 +716,9 @@ namespace NetScriptFramework
             this.HookFlags = flags;
 
             this.Arguments = args.ToArray();
+            this.Hooks     = new HookInfo[this.Arguments.Length];
+
+            var alwaysRun = (flags & EventHookFlags.AlwaysRun) != EventHookFlags.None;
 
             for ( var i = 0; i < this.Arguments.Length; i++ )
             {
@@ -554,55 +741,118 @@ namespace NetScriptFramework
                 p.IncludeLength = Math.Abs(a.IncludeLength);
                 p.ReplaceLength = a.ReplaceLength;
 
-                Memory.WriteHook(p);
+                // Hooks are prepared now so conflicts are still found during initialization but the code at hooked address is
+                // left alone until a handler is registered.
+                this.Hooks[i] = Memory.PrepareHook(p);
+
+                if ( alwaysRun )
+                {
+                    Memory.SetHookActive(this.Hooks[i], true);
+                }
             }
         }
 
         /// <summary>
-        ///     The action to run in the hook, this will invoke the event.
+        ///     Writes the hooks when the first handler is registered and restores the original code when the last handler is
+        ///     removed, so a hooked address without handlers runs only game code.
         /// </summary>
-        /// <param name="ctx">The context of action.</param>
-        /// <param name="index">The index.</param>
-        private void EventHook_Action(CPURegisters ctx, int index)
+        /// <param name="hasHandlers">Whether the event has any handlers now.</param>
+        protected internal override void _OnHandlersChanged(bool hasHandlers)
         {
-            var a = this.Arguments[index];
+            if ( (this.HookFlags & EventHookFlags.AlwaysRun) != EventHookFlags.None )
+            {
+                return;
+            }
 
-            lock ( this.Locker )
+            for ( var i = 0; i < this.Hooks.Length; i++ )
+            {
+                Memory.SetHookActive(this.Hooks[i], hasHandlers);
+            }
+        }
+
+        /// <summary>
+        ///     Gets or sets a value indicating whether the event arguments are reused. When enabled each thread keeps one
+        ///     arguments instance that is refilled every time the event is raised so raising does not allocate. Handlers must not
+        ///     keep a reference to the arguments after they return, use <see cref="HookedEventArgs.Copy" /> instead. The default
+        ///     is read from configuration.
+        /// </summary>
+        /// <value>
+        ///     <c>true</c> if arguments are reused; otherwise, <c>false</c>.
+        /// </value>
+        public bool PooledArgs
+        {
+            get
             {
-                var valid       = true;
-                var handlerBase = this._GetHandler();
+                var pooled = this._pooled;
 
-                if ( handlerBase == null )
+                if ( pooled < 0 )
                 {
-                    if ( (this.HookFlags & EventHookFlags.AlwaysRun) == EventHookFlags.None )
+                    var config = Main.Config;
+
+                    if ( config == null )
                     {
-                        return;
+                        return false;
                     }
 
-                    valid = false;
+                    var vl = config.GetValue(Main._Config_Events_PooledArgs);
+                    var i  = 0;
+
+                    pooled       = vl != null && vl.TryToInt32(out i) && i > 0 ? 1 : 0;
+                    this._pooled = pooled;
                 }
 
-                var handler = valid ? (EventHandler)handlerBase : null;
-                var args    = a.ArgFunc(ctx);
+                return pooled != 0;
+            }
+            set => this._pooled = value ? 1 : 0;
+        }
 
-                if ( args != null )
-                {
-                    args.Context = ctx;
+        /// <summary>
+        ///     The action to run in the hook, this will invoke the event.
+        /// </summary>
+        /// <param name="ctx">The context of action.</param>
+        /// <param name="index">The index.</param>
+        private void EventHook_Action(CPURegisters ctx, int index)
+        {
+            var a        = this.Arguments[index];
+            var snapshot = this._GetSnapshot();
 
-                    if ( valid )
-                    {
-                        handler(args);
-                    }
+            if ( snapshot == null && (this.HookFlags & EventHookFlags.AlwaysRun) == EventHookFlags.None )
+            {
+                return;
+            }
 
-                    if ( a.AfterFunc != null )
-                    {
-                        a.AfterFunc(ctx, args);
-                    }
+            var pooled = a.FillFunc != null && this.PooledArgs;
+            T   args;
 
-                    if ( valid && this._ReduceCounts(1) )
-                    {
-                        this._Recalculate();
-                    }
+            if ( pooled )
+            {
+                // Take the instance so a nested raise on this thread creates its own.
+                var reuse = _pooledArgs;
+                _pooledArgs = null;
+                args        = a.FillFunc(ctx, reuse);
+            }
+            else
+            {
+                args = a.ArgFunc(ctx);
+            }
+
+            if ( args != null )
+            {
+                args.Context = ctx;
+
+                if ( snapshot != null )
+                {
+                    this.Invoke(snapshot, args);
+                }
+
+                if ( a.AfterFunc != null )
+                {
+                    a.AfterFunc(ctx, args);
+                }
+
+                if ( pooled )
+                {
+                    _pooledArgs = args;
                 }
             }
         }
@@ -0,0 +1,237 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Threading;
+
+    /// <summary>
+    ///     Per thread bump allocator for native memory that is only needed until the end of current frame. Memory is taken
+    ///     from blocks that are kept for the lifetime of the thread, when a new frame has started the next allocation on the
+    ///     thread reuses the blocks from the start so nothing is freed or allocated with the C allocator in steady state.
+    ///     Frames are only meaningful on the thread that advances them, other threads must allocate inside a
+    ///     <see cref="FrameScope" /> which is reset when the scope is disposed instead.
+    /// </summary>
+    internal sealed class FrameArena
+    {
+        /// <summary>
+        ///     The default size of a block.
+        /// </summary>
+        private const int BlockSize = 64 * 1024;
+
+        /// <summary>
+        ///     The default alignment of allocations.
+        /// </summary>
+        private const int DefaultAlign = 16;
+
+        /// <summary>
+        ///     The arena of current thread.
+        /// </summary>
+        [ ThreadStatic ]
+        private static FrameArena _current;
+
+        /// <summary>
+        ///     The current frame number.
+        /// </summary>
+        private static long _frame;
+
+        /// <summary>
+        ///     The managed thread id of the thread that last advanced the frame or zero if it was never advanced.
+        /// </summary>
+        private static int _frameThread;
+
+        /// <summary>
+        ///     The allocated blocks.
+        /// </summary>
+        private readonly List<IntPtr> Blocks = new List<IntPtr>();
+
+        /// <summary>
+        ///     The sizes of allocated blocks.
+        /// </summary>
+        private readonly List<int> BlockSizes = new List<int>();
+
+        /// <summary>
+        ///     The index of block that allocations are taken from.
+        /// </summary>
+        private int BlockIndex;
+
+        /// <summary>
+        ///     The used length of current block.
+        /// </summary>
+        private long BlockOffset;
+
+        /// <summary>
+        ///     The frame number of allocations in this arena.
+        /// </summary>
+        private long ArenaFrame;
+
+        /// <summary>
+        ///     The count of active scopes in this arena. While this is not zero the arena is not reset by a new frame.
+        /// </summary>
+        private int ScopeDepth;
+
+        /// <summary>
+        ///     Gets the current frame number.
+        /// </summary>
+        /// <value>
+        ///     The current frame number.
+        /// </value>
+        internal static long Frame => Volatile.Read(ref _frame);
+
+        /// <summary>
+        ///     Ends the current frame. Memory from the arenas of all threads is reused after this.
+        /// </summary>
+        internal static void Advance()
+        {
+            Volatile.Write(ref _frameThread, Environment.CurrentManagedThreadId);
+            Interlocked.Increment(ref _frame);
+        }
+
+        /// <summary>
+        ///     Allocates memory in the arena of current thread.
+        /// </summary>
+        /// <param name="size">The size.</param>
+        /// <param name="align">The alignment, must be a power of two or zero for default.</param>
+        /// <returns></returns>
+        /// <exception cref="System.InvalidOperationException">Frame memory was allocated on another thread outside of a scope!</exception>
+        internal static IntPtr Allocate(int size, int align)
+        {
+            var arena = GetArena();
+
+            if ( arena.ScopeDepth == 0 )
+            {
+                var owner = Volatile.Read(ref _frameThread);
+
+                if ( owner != 0 && owner != Environment.CurrentManagedThreadId )
+                {
+                    throw new InvalidOperationException("Frame memory can only be allocated on the thread that advances frames! Use Memory.BeginFrameScope on other threads.");
+                }
+            }
+
+            return arena.Take(size, align > 0 ? align : DefaultAlign);
+        }
+
+        /// <summary>
+        ///     Begins a scope in the arena of current thread.
+        /// </summary>
+        /// <returns></returns>
+        internal static FrameScope BeginScope()
+        {
+            var arena = GetArena();
+
+            if ( arena.ScopeDepth == 0 )
+            {
+                arena.Rewind(Volatile.Read(ref _frameThread) != Environment.CurrentManagedThreadId);
+            }
+
+            arena.ScopeDepth++;
+            return new FrameScope(arena, arena.BlockIndex, arena.BlockOffset);
+        }
+
+        /// <summary>
+        ///     Ends a scope and releases everything that was allocated in it.
+        /// </summary>
+        /// <param name="blockIndex">The block index when the scope began.</param>
+        /// <param name="blockOffset">The block offset when the scope began.</param>
+        /// <exception cref="System.InvalidOperationException">Frame scope was ended on another thread or more than once!</exception>
+        internal void EndScope(int blockIndex, long blockOffset)
+        {
+            if ( _current != this || this.ScopeDepth == 0 )
+            {
+                throw new InvalidOperationException("Frame scope was ended on another thread or more than once!");
+            }
+
+            this.ScopeDepth--;
+            this.BlockIndex  = blockIndex;
+            this.BlockOffset = blockOffset;
+        }
+
+        /// <summary>
+        ///     Gets or creates the arena of current thread.
+        /// </summary>
+        /// <returns></returns>
+        private static FrameArena GetArena()
+        {
+            var arena = _current;
+
+            if ( arena == null )
+            {
+                arena    = new FrameArena();
+                _current = arena;
+            }
+
+            return arena;
+        }
+
+        /// <summary>
+        ///     Reuses the blocks from the start if a new frame has started or if forced.
+        /// </summary>
+        /// <param name="force">If set to <c>true</c> then reuse the blocks even if the frame is the same.</param>
+        private void Rewind(bool force)
+        {
+            var frame = Volatile.Read(ref _frame);
+
+            if ( force || frame != this.ArenaFrame )
+            {
+                this.ArenaFrame  = frame;
+                this.BlockIndex  = 0;
+                this.BlockOffset = 0;
+            }
+        }
+
+        /// <summary>
+        ///     Takes memory from the blocks.
+        /// </summary>
+        /// <param name="size">The size.</param>
+        /// <param name="align">The alignment.</param>
+        /// <returns></returns>
+        /// <exception cref="System.OutOfMemoryException">Failed to allocate memory for frame arena!</exception>
+        private IntPtr Take(int size, int align)
+        {
+            if ( this.ScopeDepth == 0 )
+            {
+                this.Rewind(false);
+            }
+
+            while ( true )
+            {
+                if ( this.BlockIndex < this.Blocks.Count )
+                {
+                    var begin   = this.Blocks[this.BlockIndex].ToInt64();
+                    var address = (begin + this.BlockOffset + align - 1) & ~(long)(align - 1);
+
+                    if ( address + size <= begin + this.BlockSizes[this.BlockIndex] )
+                    {
+                        this.BlockOffset = address + size - begin;
+                        return new IntPtr(address);
+                    }
+
+                    this.BlockIndex++;
+                    this.BlockOffset = 0;
+                    continue;
+                }
+
+                var blockSize = Math.Max(BlockSize, size + align);
+                var block     = Memory.AllocateC(blockSize, 0);
+
+                if ( block == IntPtr.Zero )
+                {
+                    throw new OutOfMemoryException("Failed to allocate memory for frame arena! Requested size was " + size + ".");
+                }
+
+                this.Blocks.Add(block);
+                this.BlockSizes.Add(blockSize);
+            }
+        }
+
+        /// <summary>
+        ///     Finalizes an instance of the <see cref="FrameArena" /> class. This happens after the thread has exited.
+        /// </summary>
+        ~FrameArena()
+        {
+            for ( var i = 0; i < this.Blocks.Count; i++ )
+            {
+                Memory.FreeC(this.Blocks[i], false);
+            }
+        }
+    }
+}
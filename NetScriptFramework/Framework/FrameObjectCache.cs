@@ -0,0 +1,242 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Threading;
+
+    /// <summary>
+    ///     Per thread identity cache of memory object wrappers. Resolving the same object of the same type again during one
+    ///     frame returns the wrapper that was created the first time instead of allocating a new one. Entries are stamped
+    ///     with the frame number so the whole cache is cleared when <see cref="Memory.AdvanceFrame" /> is called without
+    ///     touching it.
+    /// </summary>
+    internal sealed class FrameObjectCache
+    {
+        /// <summary>
+        ///     The count of bits in entry index.
+        /// </summary>
+        private const int Bits = 10;
+
+        /// <summary>
+        ///     The cache of current thread.
+        /// </summary>
+        [ ThreadStatic ]
+        private static FrameObjectCache _current;
+
+        /// <summary>
+        ///     Is the cache enabled. Minus one if not read from configuration yet.
+        /// </summary>
+        private static int _enabled = -1;
+
+        /// <summary>
+        ///     The counters of current thread.
+        /// </summary>
+        [ ThreadStatic ]
+        private static Counters _counters;
+
+        /// <summary>
+        ///     The counters of all threads that have created a wrapper. Counters of exited threads are kept so the totals don't
+        ///     go down.
+        /// </summary>
+        private static readonly List<Counters> AllCounters = new List<Counters>();
+
+        /// <summary>
+        ///     Gets the count of wrappers that were created.
+        /// </summary>
+        /// <value>
+        ///     The count of created wrappers.
+        /// </value>
+        internal static long CreatedCount
+        {
+            get
+            {
+                long total = 0;
+
+                lock ( AllCounters )
+                {
+                    foreach ( var c in AllCounters )
+                    {
+                        total += Volatile.Read(ref c.Created);
+                    }
+                }
+
+                return total;
+            }
+        }
+
+        /// <summary>
+        ///     Gets the count of wrappers that were returned from cache.
+        /// </summary>
+        /// <value>
+        ///     The count of cache hits.
+        /// </value>
+        internal static long HitCount
+        {
+            get
+            {
+                long total = 0;
+
+                lock ( AllCounters )
+                {
+                    foreach ( var c in AllCounters )
+                    {
+                        total += Volatile.Read(ref c.Hits);
+                    }
+                }
+
+                return total;
+            }
+        }
+
+        /// <summary>
+        ///     The full type addresses, same index as objects.
+        /// </summary>
+        private readonly long[] Addresses = new long[1 << Bits];
+
+        /// <summary>
+        ///     The frame numbers when entries were added, same index as objects.
+        /// </summary>
+        private readonly long[] Frames = new long[1 << Bits];
+
+        /// <summary>
+        ///     The cached wrappers.
+        /// </summary>
+        private readonly MemoryObject[] Objects = new MemoryObject[1 << Bits];
+
+        /// <summary>
+        ///     The type descriptors of cached wrappers, same index as objects.
+        /// </summary>
+        private readonly TypeDescriptor[] Types = new TypeDescriptor[1 << Bits];
+
+        /// <summary>
+        ///     Gets or sets a value indicating whether the cache is enabled.
+        /// </summary>
+        /// <value>
+        ///     <c>true</c> if enabled; otherwise, <c>false</c>.
+        /// </value>
+        internal static bool Enabled
+        {
+            get
+            {
+                var enabled = _enabled;
+
+                if ( enabled < 0 )
+                {
+                    var config = Main.Config;
+
+                    if ( config == null )
+                    {
+                        return false;
+                    }
+
+                    var vl = config.GetValue(Main._Config_MemoryObject_FrameCache);
+                    var i  = 0;
+
+                    enabled  = vl != null && vl.TryToInt32(out i) && i > 0 ? 1 : 0;
+                    _enabled = enabled;
+                }
+
+                return enabled != 0;
+            }
+            set => _enabled = value ? 1 : 0;
+        }
+
+        /// <summary>
+        ///     Creates the wrapper or gets it from cache.
+        /// </summary>
+        /// <param name="td">The type descriptor.</param>
+        /// <param name="address">The address of object as the type of descriptor.</param>
+        /// <returns></returns>
+        internal static MemoryObject Create(TypeDescriptor td, IntPtr address)
+        {
+            address -= td.OffsetInFullType;
+
+            if ( !Enabled )
+            {
+                return CreateNew(td, address);
+            }
+
+            var cache = _current;
+
+            if ( cache == null )
+            {
+                cache    = new FrameObjectCache();
+                _current = cache;
+            }
+
+            var key   = address.ToInt64();
+            var frame = FrameArena.Frame;
+            var index = (int)((ulong)key * 0x9E3779B97F4A7C15UL >> (64 - Bits));
+
+            if ( cache.Frames[index] == frame && cache.Addresses[index] == key && ReferenceEquals(cache.Types[index], td) )
+            {
+                var counters = GetCounters();
+                Volatile.Write(ref counters.Hits, counters.Hits + 1);
+                return cache.Objects[index];
+            }
+
+            var mo = CreateNew(td, address);
+
+            cache.Addresses[index] = key;
+            cache.Frames[index]    = frame;
+            cache.Objects[index]   = mo;
+            cache.Types[index]     = td;
+
+            return mo;
+        }
+
+        /// <summary>
+        ///     Creates a new wrapper.
+        /// </summary>
+        /// <param name="td">The type descriptor.</param>
+        /// <param name="address">The address of full type.</param>
+        /// <returns></returns>
+        private static MemoryObject CreateNew(TypeDescriptor td, IntPtr address)
+        {
+            var mo = td.Creator();
+            mo.Address = address;
+
+            var counters = GetCounters();
+            Volatile.Write(ref counters.Created, counters.Created + 1);
+            return mo;
+        }
+
+        /// <summary>
+        ///     Gets or creates the counters of current thread.
+        /// </summary>
+        /// <returns></returns>
+        private static Counters GetCounters()
+        {
+            var counters = _counters;
+
+            if ( counters == null )
+            {
+                counters  = new Counters();
+                _counters = counters;
+
+                lock ( AllCounters )
+                {
+                    AllCounters.Add(counters);
+                }
+            }
+
+            return counters;
+        }
+
+        /// <summary>
+        ///     Wrapper counters of one thread. Only the owning thread writes these, so no interlocked operations are needed.
+        /// </summary>
+        private sealed class Counters
+        {
+            /// <summary>
+            ///     The count of wrappers that were created.
+            /// </summary>
+            internal long Created;
+
+            /// <summary>
+            ///     The count of wrappers that were returned from cache.
+            /// </summary>
+            internal long Hits;
+        }
+    }
+}
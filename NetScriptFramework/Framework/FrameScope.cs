@@ -0,0 +1,55 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+
+    /// <summary>
+    ///     A scope of frame memory on the current thread, see <see cref="Memory.BeginFrameScope" />. Memory returned by
+    ///     <see cref="Memory.AllocateFrame" /> inside the scope is valid until the scope is disposed, advancing the frame does
+    ///     not reuse it. Worker threads must allocate frame memory inside a scope.
+    /// </summary>
+    /// <example>
+    ///     <code>
+    ///     using ( Memory.BeginFrameScope() )
+    ///     {
+    ///         var str = new FrameString("meshes\\test.nif", false);
+    ///         ...
+    ///     }
+    ///     </code>
+    /// </example>
+    public readonly struct FrameScope : IDisposable
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="FrameScope" /> struct.
+        /// </summary>
+        /// <param name="arena">The arena.</param>
+        /// <param name="blockIndex">The block index when the scope began.</param>
+        /// <param name="blockOffset">The block offset when the scope began.</param>
+        internal FrameScope(FrameArena arena, int blockIndex, long blockOffset)
+        {
+            this.Arena       = arena;
+            this.BlockIndex  = blockIndex;
+            this.BlockOffset = blockOffset;
+        }
+
+        /// <summary>
+        ///     The arena.
+        /// </summary>
+        private readonly FrameArena Arena;
+
+        /// <summary>
+        ///     The block index when the scope began.
+        /// </summary>
+        private readonly int BlockIndex;
+
+        /// <summary>
+        ///     The block offset when the scope began.
+        /// </summary>
+        private readonly long BlockOffset;
+
+        /// <summary>
+        ///     Ends the scope. Memory allocated in the scope will be reused.
+        /// </summary>
+        /// <exception cref="System.InvalidOperationException">Frame scope was ended on another thread or more than once!</exception>
+        public void Dispose() => this.Arena?.EndScope(this.BlockIndex, this.BlockOffset);
+    }
+}
@@ -0,0 +1,88 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Runtime.InteropServices;
+
+    /// <summary>
+    ///     A null terminated ANSI or Unicode string in frame memory, see <see cref="Memory.AllocateFrame" />. Use this instead
+    ///     of <see cref="Memory.AllocateString" /> for strings that are only passed to a native function, the string does not
+    ///     need to be disposed and creating it does not allocate anything on the managed or native heap.
+    /// </summary>
+    public readonly struct FrameString
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="FrameString" /> struct.
+        /// </summary>
+        /// <param name="text">The text.</param>
+        /// <param name="wide">
+        ///     If set to <c>true</c> then write as Unicode (2 bytes per character), otherwise write as ANSI
+        ///     (1 byte per character).
+        /// </param>
+        /// <exception cref="System.ArgumentNullException">text</exception>
+        public FrameString(string text, bool wide)
+        {
+            if ( text == null )
+            {
+                throw new ArgumentNullException("text");
+            }
+
+            if ( wide )
+            {
+                var length = text.Length * 2;
+
+                this.Address = Memory.AllocateFrame(length + 2, 2);
+                this.Size    = length + 2;
+
+                if ( length != 0 )
+                {
+                    RtlMoveMemory(this.Address, text, new IntPtr(length));
+                }
+
+                Marshal.WriteInt16(this.Address + length, 0);
+            }
+            else
+            {
+                var length = text.Length != 0 ? WideCharToMultiByte(0, 0, text, text.Length, IntPtr.Zero, 0, IntPtr.Zero, IntPtr.Zero) : 0;
+
+                this.Address = Memory.AllocateFrame(length + 1, 1);
+                this.Size    = length + 1;
+
+                if ( length != 0 )
+                {
+                    WideCharToMultiByte(0, 0, text, text.Length, this.Address, length, IntPtr.Zero, IntPtr.Zero);
+                }
+
+                Marshal.WriteByte(this.Address + length, 0);
+            }
+        }
+
+        /// <summary>
+        ///     The address of string.
+        /// </summary>
+        public readonly IntPtr Address;
+
+        /// <summary>
+        ///     The size of string in bytes including the null terminator.
+        /// </summary>
+        public readonly int Size;
+
+        /// <summary>
+        ///     Performs an implicit conversion from <see cref="FrameString" /> to <see cref="IntPtr" />.
+        /// </summary>
+        /// <param name="str">The string.</param>
+        /// <returns>
+        ///     The address of string.
+        /// </returns>
+        public static implicit operator IntPtr(FrameString str) => str.Address;
+
+    #region Api calls
+
+        [ DllImport("kernel32.dll", CharSet = CharSet.Unicode) ]
+        private static extern void RtlMoveMemory(IntPtr destination, string source, IntPtr length);
+
+        [ DllImport("kernel32.dll", CharSet = CharSet.Unicode) ]
+        private static extern int WideCharToMultiByte(uint codePage, uint flags, string source, int sourceLength, IntPtr destination, int destinationLength, IntPtr defaultChar, IntPtr usedDefaultChar);
+
+    #endregion
+    }
+}
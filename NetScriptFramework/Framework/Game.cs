@@ -462,8 +462,7 @@
                     throw new ArgumentException("Multiple type registrations with same vtable address! (" + t.InterfaceType.Name + ")");
                 }
 
-                this.Types.TypesByVTable[vtable.Value] = t;
-                this.Types.TypesWithVTable.Add(t.InterfaceType);
+                this.Types.AddVTable(vtable.Value, t);
             }
             else
             {
@@ -510,6 +509,280 @@
         ///     The types with virtual function table.
         /// </summary>
         internal readonly HashSet<Type> TypesWithVTable = new HashSet<Type>();
+
+        /// <summary>
+        ///     The frozen lookup of types by virtual function table address. This is built on first lookup after types were
+        ///     registered.
+        /// </summary>
+        private volatile VTableIndex VTables;
+
+        /// <summary>
+        ///     Finds the type by virtual function table address. Returns null if not found.
+        /// </summary>
+        /// <param name="vtable">The virtual function table address.</param>
+        /// <returns></returns>
+        internal TypeDescriptor FindByVTable(IntPtr vtable)
+        {
+            var index = this.VTables;
+
+            if ( index == null )
+            {
+                index        = VTableIndex.Build(this.TypesByVTable);
+                this.VTables = index;
+            }
+
+            return index.Find(vtable);
+        }
+
+        /// <summary>
+        ///     Adds the type with virtual function table address.
+        /// </summary>
+        /// <param name="vtable">The virtual function table address.</param>
+        /// <param name="t">The type.</param>
+        internal void AddVTable(IntPtr vtable, TypeDescriptor t)
+        {
+            this.TypesByVTable[vtable] = t;
+            this.TypesWithVTable.Add(t.InterfaceType);
+            this.VTables = null;
+        }
+    }
+
+#endregion
+
+#region VTableIndex class
+
+    /// <summary>
+    ///     Immutable perfect hash of virtual function table addresses. Keys are hashed with one multiply, the high bits select
+    ///     a bucket and the bucket's displacement moves the slot so that no two keys share a slot. A lookup is a multiply,
+    ///     two shifts, one load of displacement and one compare.
+    /// </summary>
+    internal sealed class VTableIndex
+    {
+        /// <summary>
+        ///     The multiplier that is tried first.
+        /// </summary>
+        private const ulong DefaultMultiplier = 0x9E3779B97F4A7C15UL;
+
+        /// <summary>
+        ///     The average count of keys in a bucket.
+        /// </summary>
+        private const int KeysPerBucket = 4;
+
+        /// <summary>
+        ///     The count of multipliers to try before making the table larger.
+        /// </summary>
+        private const int AttemptsPerSize = 8;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="VTableIndex" /> class.
+        /// </summary>
+        /// <param name="keys">The keys by slot.</param>
+        /// <param name="values">The values by slot.</param>
+        /// <param name="displacements">The displacements by bucket.</param>
+        /// <param name="multiplier">The hash multiplier.</param>
+        /// <param name="bucketShift">The shift of hash to get bucket.</param>
+        private VTableIndex(long[] keys, TypeDescriptor[] values, int[] displacements, ulong multiplier, int bucketShift)
+        {
+            this.Keys          = keys;
+            this.Values        = values;
+            this.Displacements = displacements;
+            this.Multiplier    = multiplier;
+            this.BucketShift   = bucketShift;
+            this.Mask          = keys.Length - 1;
+        }
+
+        /// <summary>
+        ///     The keys by slot, zero means empty slot.
+        /// </summary>
+        private readonly long[] Keys;
+
+        /// <summary>
+        ///     The values by slot.
+        /// </summary>
+        private readonly TypeDescriptor[] Values;
+
+        /// <summary>
+        ///     The slot displacements by bucket.
+        /// </summary>
+        private readonly int[] Displacements;
+
+        /// <summary>
+        ///     The hash multiplier.
+        /// </summary>
+        private readonly ulong Multiplier;
+
+        /// <summary>
+        ///     The shift of hash to get bucket.
+        /// </summary>
+        private readonly int BucketShift;
+
+        /// <summary>
+        ///     The mask of slot.
+        /// </summary>
+        private readonly int Mask;
+
+        /// <summary>
+        ///     Finds the value by virtual function table address. Returns null if not found.
+        /// </summary>
+        /// <param name="vtable">The virtual function table address.</param>
+        /// <returns></returns>
+        internal TypeDescriptor Find(IntPtr vtable)
+        {
+            var key  = vtable.ToInt64();
+            var hash = (ulong)key * this.Multiplier;
+            var slot = ((int)(hash >> 32) + this.Displacements[(int)(hash >> this.BucketShift)]) & this.Mask;
+
+            return this.Keys[slot] == key && key != 0 ? this.Values[slot] : null;
+        }
+
+        /// <summary>
+        ///     Builds the index from types.
+        /// </summary>
+        /// <param name="types">The types by virtual function table address.</param>
+        /// <returns></returns>
+        internal static VTableIndex Build(Dictionary<IntPtr, TypeDescriptor> types)
+        {
+            var keys   = new long[types.Count];
+            var values = new TypeDescriptor[types.Count];
+            var n      = 0;
+
+            foreach ( var pair in types )
+            {
+                keys[n]   = pair.Key.ToInt64();
+                values[n] = pair.Value;
+                n++;
+            }
+
+            var bucketBits = 1;
+
+            while ( (1 << bucketBits) * KeysPerBucket < n )
+            {
+                bucketBits++;
+            }
+
+            var tableBits = 1;
+
+            while ( (1 << tableBits) < n * 2 )
+            {
+                tableBits++;
+            }
+
+            var random = new Random(n);
+
+            for ( var attempt = 0;; attempt++ )
+            {
+                if ( attempt != 0 && attempt % AttemptsPerSize == 0 )
+                {
+                    tableBits++;
+                }
+
+                var multiplier = attempt == 0 ? DefaultMultiplier : (((ulong)(uint)random.Next() << 32) | (uint)random.Next()) | 1;
+                var result     = TryBuild(keys, values, multiplier, bucketBits, tableBits);
+
+                if ( result != null )
+                {
+                    return result;
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Tries to build the index with specified parameters. Returns null if a bucket could not be placed.
+        /// </summary>
+        /// <param name="keys">The keys.</param>
+        /// <param name="values">The values.</param>
+        /// <param name="multiplier">The hash multiplier.</param>
+        /// <param name="bucketBits">The count of bits in bucket.</param>
+        /// <param name="tableBits">The count of bits in slot.</param>
+        /// <returns></returns>
+        private static VTableIndex TryBuild(long[] keys, TypeDescriptor[] values, ulong multiplier, int bucketBits, int tableBits)
+        {
+            var bucketShift = 64 - bucketBits;
+            var size        = 1 << tableBits;
+            var mask        = size - 1;
+            var buckets     = new List<int>[1 << bucketBits];
+
+            for ( var i = 0; i < keys.Length; i++ )
+            {
+                var b  = (int)(((ulong)keys[i] * multiplier) >> bucketShift);
+                var ls = buckets[b];
+
+                if ( ls == null )
+                {
+                    ls         = new List<int>(KeysPerBucket);
+                    buckets[b] = ls;
+                }
+
+                ls.Add(i);
+            }
+
+            // Place the largest buckets first while there is most room.
+            var order = Enumerable.Range(0, buckets.Length).Where(q => buckets[q] != null).OrderByDescending(q => buckets[q].Count).ToList();
+
+            var slotKeys      = new long[size];
+            var slotValues    = new TypeDescriptor[size];
+            var used          = new bool[size];
+            var displacements = new int[buckets.Length];
+            var slots         = new int[keys.Length];
+
+            foreach ( var b in order )
+            {
+                var ls     = buckets[b];
+                var placed = false;
+
+                for ( var d = 0; d < size && !placed; d++ )
+                {
+                    placed = true;
+
+                    for ( var j = 0; j < ls.Count; j++ )
+                    {
+                        var slot = ((int)(((ulong)keys[ls[j]] * multiplier) >> 32) + d) & mask;
+
+                        if ( used[slot] )
+                        {
+                            placed = false;
+                        }
+                        else
+                        {
+                            for ( var k = 0; k < j; k++ )
+                            {
+                                if ( slots[k] == slot )
+                                {
+                                    placed = false;
+                                    break;
+                                }
+                            }
+                        }
+
+                        if ( !placed )
+                        {
+                            break;
+                        }
+
+                        slots[j] = slot;
+                    }
+
+                    if ( placed )
+                    {
+                        for ( var j = 0; j < ls.Count; j++ )
+                        {
+                            used[slots[j]]       = true;
+                            slotKeys[slots[j]]   = keys[ls[j]];
+                            slotValues[slots[j]] = values[ls[j]];
+                        }
+
+                        displacements[b] = d;
+                    }
+                }
+
+                if ( !placed )
+                {
+                    return null;
+                }
+            }
+
+            return new VTableIndex(slotKeys, slotValues, displacements, multiplier, bucketShift);
+        }
     }
 
 #endregion
@@ -1073,5 +1346,86 @@
         public int? ValueSafe => this._value;
     }
 
+    /// <summary>
+    ///     A native function with a signature declared by a delegate type. The runtime generates a marshaling stub for the
+    ///     signature once so calls pass arguments directly in registers without boxing them into
+    ///     <see cref="InvokeArgument" />. Use blittable argument types (IntPtr, integers, float, double) so calls don't
+    ///     allocate.
+    /// </summary>
+    /// <typeparam name="TDelegate">
+    ///     The delegate type that declares the signature. Mark it with
+    ///     <see cref="System.Runtime.InteropServices.UnmanagedFunctionPointerAttribute" /> and
+    ///     <see cref="System.Runtime.InteropServices.CallingConvention.Cdecl" />.
+    /// </typeparam>
+    public sealed class NativeFunction<TDelegate> where TDelegate : Delegate
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="NativeFunction{TDelegate}" /> class.
+        /// </summary>
+        /// <param name="address">The address of function.</param>
+        /// <exception cref="System.ArgumentNullException">address</exception>
+        public NativeFunction(IntPtr address)
+        {
+            if ( address == IntPtr.Zero )
+            {
+                throw new ArgumentNullException(nameof(address));
+            }
+
+            this.Address = address;
+            this.Invoke  = System.Runtime.InteropServices.Marshal.GetDelegateForFunctionPointer<TDelegate>(address);
+        }
+
+        /// <summary>
+        ///     Gets the address of function.
+        /// </summary>
+        /// <value>
+        ///     The address.
+        /// </value>
+        public IntPtr Address { get; }
+
+        /// <summary>
+        ///     Gets the delegate that calls the function. Keep a reference to it instead of fetching it again for every call.
+        /// </summary>
+        /// <value>
+        ///     The delegate.
+        /// </value>
+        public TDelegate Invoke { get; }
+
+        /// <summary>
+        ///     Initializes the function by its version independent identifier. This will throw an exception if failed to find.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <param name="extraOffset">The extra offset.</param>
+        /// <param name="patternOffset">The pattern offset.</param>
+        /// <param name="pattern">The pattern.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentException">Unable to initialize function with unique ID of  + id + !</exception>
+        public static NativeFunction<TDelegate> Initialize(ulong id, int extraOffset = 0, int patternOffset = 0, string pattern = null)
+        {
+            var r = TryInitialize(id, extraOffset, patternOffset, pattern);
+
+            if ( r == null )
+            {
+                throw new ArgumentException("Unable to initialize function with unique ID of " + id + "!");
+            }
+
+            return r;
+        }
+
+        /// <summary>
+        ///     Tries to initialize the function by its version independent identifier. This will return null if failed to find.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <param name="extraOffset">The extra offset.</param>
+        /// <param name="patternOffset">The pattern offset.</param>
+        /// <param name="pattern">The pattern.</param>
+        /// <returns></returns>
+        public static NativeFunction<TDelegate> TryInitialize(ulong id, int extraOffset = 0, int patternOffset = 0, string pattern = null)
+        {
+            var r = Main.GameInfo != null ? Main.GameInfo.TryGetAddressOf(id, extraOffset, patternOffset, pattern) : null;
+            return r.HasValue && r.Value != IntPtr.Zero ? new NativeFunction<TDelegate>(r.Value) : null;
+        }
+    }
+
 #endregion
 }
@@ -4,6 +4,8 @@
     using System.Collections.Generic;
     using System.IO;
     using System.IO.Compression;
+    using System.Linq;
+    using System.Numerics;
     using System.Text;
 
     /// <summary>
@@ -86,11 +88,36 @@
         /// </summary>
         private readonly Dictionary<ulong, GameTypeInfo> vtTpMap = new Dictionary<ulong, GameTypeInfo>();
 
+        /// <summary>
+        ///     The memory mapped index if library was loaded from one.
+        /// </summary>
+        private GameInfoIndex index;
+
+        /// <summary>
+        ///     Are functions and globals lists filled from index.
+        /// </summary>
+        private bool indexListsLoaded;
+
+        /// <summary>
+        ///     Were functions added after loading the index. Searching by address then uses the functions list instead of index.
+        /// </summary>
+        private bool indexFunctionsAdded;
+
+        /// <summary>
+        ///     The function search index, created on first search.
+        /// </summary>
+        private volatile FunctionRangeIndex functionRanges;
+
         /// <summary>
         ///     The alias file version.
         /// </summary>
         internal int[] AliasFileVersion;
 
+        /// <summary>
+        ///     The library file the data was last read from. If the loaded file was an alias this is the file it pointed to.
+        /// </summary>
+        internal FileInfo DataFile;
+
         /// <summary>
         ///     The file version.
         /// </summary>
@@ -139,7 +166,14 @@
         /// <value>
         ///     The globals.
         /// </value>
-        public IReadOnlyList<GameGlobalInfo> Globals => this.globalsList;
+        public IReadOnlyList<GameGlobalInfo> Globals
+        {
+            get
+            {
+                this.LoadIndexLists();
+                return this.globalsList;
+            }
+        }
 
         /// <summary>
         ///     Gets the functions.
@@ -147,7 +181,14 @@
         /// <value>
         ///     The functions.
         /// </value>
-        public IReadOnlyList<GameFunctionInfo> Functions => this.functionsList;
+        public IReadOnlyList<GameFunctionInfo> Functions
+        {
+            get
+            {
+                this.LoadIndexLists();
+                return this.functionsList;
+            }
+        }
 
         /// <summary>
         ///     Gets the cached values.
@@ -165,7 +206,9 @@
         {
             using ( var sw = targetFileInfo.CreateText() )
             {
-                foreach ( var x in this.vidAddrMap )
+                IEnumerable<KeyValuePair<ulong, ulong>> vids = this.index != null ? this.index.GetVids().Concat(this.vidAddrMap) : this.vidAddrMap;
+
+                foreach ( var x in vids )
                 {
                     sw.Write(x.Key);
                     sw.Write("\t0x");
@@ -186,6 +229,11 @@
             {
                 GameFunctionInfo fi = null;
 
+                if ( this.index != null && (fi = this.index.GetFunctionById(id)) != null )
+                {
+                    return fi;
+                }
+
                 if ( this.vidFnMap.TryGetValue(id, out fi) )
                 {
                     return fi;
@@ -206,6 +254,11 @@
             {
                 GameGlobalInfo fi = null;
 
+                if ( this.index != null && (fi = this.index.GetGlobalById(id)) != null )
+                {
+                    return fi;
+                }
+
                 if ( this.vidGbMap.TryGetValue(id, out fi) )
                 {
                     return fi;
@@ -283,14 +336,15 @@
         }
 
         /// <summary>
-        ///     Adds the function information.
+        ///     Adds the function information. If the library was loaded from an index the function is searched together with the
+        ///     indexed functions.
         /// </summary>
         /// <param name="fi">The function info.</param>
         internal void AddFunctionInfo(GameFunctionInfo fi)
         {
             if ( fi.Id != 0 )
             {
-                if ( this.vidAddrMap.ContainsKey(fi.Id) )
+                if ( this.vidAddrMap.ContainsKey(fi.Id) || (this.index != null && this.index.TryGetOffset(fi.Id, out _)) )
                 {
                     throw new ArgumentException("An object with specified version independent identifier (" + fi.Id + ") was already registered!");
                 }
@@ -299,7 +353,14 @@
                 this.vidFnMap[fi.Id]   = fi;
             }
 
+            if ( this.index != null )
+            {
+                this.LoadIndexLists();
+                this.indexFunctionsAdded = true;
+            }
+
             this.functionsList.Add(fi);
+            this.functionRanges = null;
         }
 
         /// <summary>
@@ -310,7 +371,7 @@
         {
             if ( gb.Id != 0 )
             {
-                if ( this.vidAddrMap.ContainsKey(gb.Id) )
+                if ( this.vidAddrMap.ContainsKey(gb.Id) || (this.index != null && this.index.TryGetOffset(gb.Id, out _)) )
                 {
                     throw new ArgumentException("An object with specified version independent identifier (" + gb.Id + ") was already registered!");
                 }
@@ -319,6 +380,7 @@
                 this.vidGbMap[gb.Id]   = gb;
             }
 
+            this.LoadIndexLists();
             this.globalsList.Add(gb);
         }
 
@@ -350,6 +412,9 @@
                 throw new FileNotFoundException(file.FullName);
             }
 
+            // Reading an alias calls this again with the file it points to.
+            this.DataFile = file;
+
             using ( var stream = file.OpenRead() )
             {
                 using ( var comp = new GZipStream(stream, CompressionMode.Decompress) )
@@ -374,6 +439,7 @@
         /// <param name="file">The file.</param>
         internal void WriteToFile(FileInfo file)
         {
+            this.LoadIndexLists();
             this.functionsList.Sort((u, v) => u.Begin.CompareTo(v.Begin));
 
             using ( var stream = file.Create() )
@@ -382,10 +448,132 @@
                 {
                     using ( var writer = new BinaryWriter(comp) )
                     {
-                        this.WriteToStream(writer);
+                        this.WriteToStream(writer, true);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Reads from a memory mapped index file. This will clear previous info. Returns false if the index does not exist or
+        ///     was not created from the current library file, in that case the library file must be read instead.
+        /// </summary>
+        /// <param name="file">The index file.</param>
+        /// <param name="source">The library file the index was created from.</param>
+        /// <returns></returns>
+        internal bool ReadFromIndexFile(FileInfo file, FileInfo source)
+        {
+            this.Clear();
+
+            GameInfoIndex idx;
+
+            try
+            {
+                idx = GameInfoIndex.Open(file, source);
+            }
+            catch ( Exception ex ) when ( ex is IOException || ex is InvalidDataException || ex is UnauthorizedAccessException )
+            {
+                return false;
+            }
+
+            if ( idx == null )
+            {
+                return false;
+            }
+
+            try
+            {
+                using ( var stream = idx.OpenExtraStream() )
+                {
+                    using ( var reader = new BinaryReader(stream) )
+                    {
+                        this.ReadFromStream(reader, source, 0);
                     }
                 }
             }
+            catch ( Exception ex ) when ( ex is IOException || ex is InvalidDataException )
+            {
+                idx.Dispose();
+                this.Clear();
+                return false;
+            }
+
+            this.index = idx;
+            return true;
+        }
+
+        /// <summary>
+        ///     Writes a memory mapped index file of current info so that next time it can be loaded with
+        ///     <see cref="ReadFromIndexFile" /> instead of parsing the library file.
+        /// </summary>
+        /// <param name="file">The index file.</param>
+        /// <param name="source">The library file the current info was read from.</param>
+        internal void WriteIndexFile(FileInfo file, FileInfo source)
+        {
+            this.LoadIndexLists();
+
+            byte[] extra;
+
+            using ( var stream = new MemoryStream() )
+            {
+                using ( var writer = new BinaryWriter(stream) )
+                {
+                    this.WriteToStream(writer, false);
+                }
+
+                extra = stream.ToArray();
+            }
+
+            GameInfoIndex.Write(file, source, this.DataFile, this.functionsList, this.globalsList, extra);
+        }
+
+        /// <summary>
+        ///     Fills the functions and globals lists from index when they are first needed.
+        /// </summary>
+        private void LoadIndexLists()
+        {
+            var idx = this.index;
+
+            if ( idx == null || this.indexListsLoaded )
+            {
+                return;
+            }
+
+            lock ( idx )
+            {
+                if ( this.indexListsLoaded )
+                {
+                    return;
+                }
+
+                for ( var i = 0; i < idx.FunctionCount; i++ )
+                {
+                    this.functionsList.Add(idx.GetFunction(i));
+                }
+
+                for ( var i = 0; i < idx.GlobalCount; i++ )
+                {
+                    this.globalsList.Add(idx.GetGlobal(i));
+                }
+
+                this.indexListsLoaded = true;
+            }
+        }
+
+        /// <summary>
+        ///     Tries to get the offset of object by its version independent identifier.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <param name="offset">The offset.</param>
+        /// <returns></returns>
+        private bool TryGetOffset(ulong id, out ulong offset)
+        {
+            if ( this.index != null && this.index.TryGetOffset(id, out offset) )
+            {
+                return true;
+            }
+
+            return this.vidAddrMap.TryGetValue(id, out offset);
         }
 
         /// <summary>
@@ -393,6 +581,15 @@
         /// </summary>
         internal void Clear()
         {
+            if ( this.index != null )
+            {
+                this.index.Dispose();
+                this.index = null;
+            }
+
+            this.indexListsLoaded    = false;
+            this.indexFunctionsAdded = false;
+            this.functionRanges      = null;
             this.cachedValues.Clear();
             this.registrationList.Clear();
             this.typesList.Clear();
@@ -653,7 +850,8 @@
         ///     Writes to stream.
         /// </summary>
         /// <param name="stream">The stream.</param>
-        private void WriteToStream(BinaryWriter stream)
+        /// <param name="includeAddresses">If set to <c>false</c> then functions and globals are written as empty.</param>
+        private void WriteToStream(BinaryWriter stream, bool includeAddresses)
         {
             stream.Write(StreamVersion);
 
@@ -690,6 +888,7 @@
                 }
             }
 
+            if ( includeAddresses )
             {
                 stream.Write(this.functionsList.Count);
 
@@ -697,9 +896,7 @@
                 {
                     x.WriteToStream(stream);
                 }
-            }
 
-            {
                 stream.Write(this.globalsList.Count);
 
                 foreach ( var x in this.globalsList )
@@ -707,6 +904,11 @@
                     x.WriteToStream(stream);
                 }
             }
+            else
+            {
+                stream.Write(0);
+                stream.Write(0);
+            }
 
             {
                 stream.Write(this.registrationList.Count);
@@ -1899,55 +2101,141 @@
         }
 
         /// <summary>
-        ///     Comparer for function search.
+        ///     Function ranges in Eytzinger layout for searching by address. Begin offsets are stored inverted so that the search
+        ///     for the first key not less than the inverted address finds the last function that begins at or before the address.
         /// </summary>
-        private sealed class FunctionSearcher : IComparer<GameFunctionInfo>
+        private sealed class FunctionRangeIndex
         {
             /// <summary>
-            ///     Gets or sets the address.
+            ///     Initializes a new instance of the <see cref="FunctionRangeIndex" /> class.
             /// </summary>
-            /// <value>
-            ///     The address.
-            /// </value>
-            internal ulong Address { get; set; }
+            /// <param name="begins">The begin offsets sorted in ascending order.</param>
+            /// <param name="ends">The end offsets.</param>
+            /// <param name="functions">The functions in same order or null if they are resolved elsewhere.</param>
+            internal FunctionRangeIndex(ulong[] begins, ulong[] ends, GameFunctionInfo[] functions)
+            {
+                var count = begins.Length;
+                this.keys      = new ulong[count + 1];
+                this.ends      = new ulong[count + 1];
+                this.indices   = new int[count   + 1];
+                this.Functions = functions;
+
+                var next = count - 1;
+                this.Fill(begins, ends, ref next, 1);
+            }
 
             /// <summary>
-            ///     Compares two objects and returns a value indicating whether one is less than, equal to, or greater than the other.
+            ///     The inverted begin offsets, one based.
             /// </summary>
-            /// <param name="x">The first object to compare.</param>
-            /// <param name="y">The second object to compare.</param>
-            /// <returns>
-            ///     A signed integer that indicates the relative values of <paramref name="x" /> and <paramref name="y" />, as shown in
-            ///     the following table.Value Meaning Less than zero<paramref name="x" /> is less than <paramref name="y" />.Zero
-            ///     <paramref name="x" /> equals <paramref name="y" />.Greater than zero<paramref name="x" /> is greater than
-            ///     <paramref name="y" />.
-            /// </returns>
-            public int Compare(GameFunctionInfo x, GameFunctionInfo y)
+            private readonly ulong[] keys;
+
+            /// <summary>
+            ///     The end offsets, one based.
+            /// </summary>
+            private readonly ulong[] ends;
+
+            /// <summary>
+            ///     The indices in sorted order, one based.
+            /// </summary>
+            private readonly int[] indices;
+
+            /// <summary>
+            ///     The functions sorted by begin offset or null.
+            /// </summary>
+            internal readonly GameFunctionInfo[] Functions;
+
+            /// <summary>
+            ///     Finds the index of function in sorted order that contains the offset. Returns -1 if not found.
+            /// </summary>
+            /// <param name="offset">The offset from base of module.</param>
+            /// <returns></returns>
+            internal int Find(ulong offset)
             {
-                var v = this.Address;
-                var a = x;
-                var m = 1;
+                var keys = this.keys;
+                var x    = ~offset;
+                var k    = 1;
 
-                if ( a == null )
+                while ( k < keys.Length )
                 {
-                    a = y;
-                    m = -1;
+                    k = (2 * k) + (keys[k] < x ? 1 : 0);
                 }
 
-                if ( a.End <= v )
+                k >>= BitOperations.TrailingZeroCount(~k) + 1;
+
+                if ( k == 0 || this.ends[k] <= offset )
                 {
-                    return -m;
+                    return -1;
                 }
 
-                if ( a.Begin > v )
+                return this.indices[k];
+            }
+
+            /// <summary>
+            ///     Fills the layout with an in-order walk so that keys ascend, which means begin offsets descend.
+            /// </summary>
+            /// <param name="begins">The begin offsets.</param>
+            /// <param name="ends">The end offsets.</param>
+            /// <param name="next">The next sorted index.</param>
+            /// <param name="k">The position in layout.</param>
+            private void Fill(ulong[] begins, ulong[] ends, ref int next, int k)
+            {
+                if ( k >= this.keys.Length )
                 {
-                    return m;
+                    return;
                 }
 
-                return 0;
+                this.Fill(begins, ends, ref next, 2 * k);
+                this.keys[k]    = ~begins[next];
+                this.ends[k]    = ends[next];
+                this.indices[k] = next;
+                next--;
+                this.Fill(begins, ends, ref next, (2 * k) + 1);
             }
         }
 
+        /// <summary>
+        ///     Gets the function range index, creates it if needed.
+        /// </summary>
+        /// <returns></returns>
+        private FunctionRangeIndex GetFunctionRanges()
+        {
+            var ranges = this.functionRanges;
+
+            if ( ranges != null )
+            {
+                return ranges;
+            }
+
+            ulong[] begins;
+            ulong[] ends;
+            GameFunctionInfo[] functions = null;
+
+            if ( this.index != null && !this.indexFunctionsAdded )
+            {
+                begins = new ulong[this.index.FunctionCount];
+                ends   = new ulong[this.index.FunctionCount];
+                this.index.ReadFunctionRanges(begins, ends);
+            }
+            else
+            {
+                functions = this.functionsList.ToArray();
+                Array.Sort(functions, (u, v) => u.Begin.CompareTo(v.Begin));
+
+                begins = new ulong[functions.Length];
+                ends   = new ulong[functions.Length];
+
+                for ( var i = 0; i < functions.Length; i++ )
+                {
+                    begins[i] = functions[i].Begin;
+                    ends[i]   = functions[i].End;
+                }
+            }
+
+            ranges              = new FunctionRangeIndex(begins, ends, functions);
+            this.functionRanges = ranges;
+            return ranges;
+        }
+
         /// <summary>
         ///     Gets the function information.
         /// </summary>
@@ -1963,21 +2251,15 @@
                 v = unchecked(v - this.BaseOffset);
             }
 
-            /*foreach (var f in this.functionsList)
-            {
-                if (v >= f.Begin && v < f.End)
-                    return f;
-            }*/
-
-            var searcher = new FunctionSearcher { Address = v };
-            var result   = this.functionsList.BinarySearch(null, searcher);
+            var ranges = this.GetFunctionRanges();
+            var result = ranges.Find(v);
 
             if ( result < 0 )
             {
                 return null;
             }
 
-            return this.functionsList[result];
+            return ranges.Functions != null ? ranges.Functions[result] : this.index.GetFunction(result);
         }
     #endif
 
@@ -1997,7 +2279,7 @@
         {
             ulong offset = 0;
 
-            if ( id != 0 && this.vidAddrMap.TryGetValue(id, out offset) )
+            if ( id != 0 && this.TryGetOffset(id, out offset) )
             {
                 var    full = this.BaseOffset + offset;
                 IntPtr result;
@@ -2051,7 +2333,7 @@
         {
             ulong offset = 0;
 
-            if ( id != 0 && this.vidAddrMap.TryGetValue(id, out offset) )
+            if ( id != 0 && this.TryGetOffset(id, out offset) )
             {
                 var    full = this.BaseOffset + offset;
                 IntPtr result;
@@ -0,0 +1,667 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Collections.Generic;
+    using System.IO;
+    using System.IO.MemoryMappedFiles;
+    using System.Linq;
+    using System.Text;
+    using System.Threading;
+
+    /// <summary>
+    ///     Uncompressed version library that is memory mapped instead of parsed. Addresses, functions and globals are looked up
+    ///     directly in the mapped file and objects are only created for entries that are actually requested. Types and the
+    ///     rest of the library are stored as an uncompressed library stream and read normally.
+    /// </summary>
+    internal sealed class GameInfoIndex : IDisposable
+    {
+        /// <summary>
+        ///     The identifier at the start of the file, "NSFI".
+        /// </summary>
+        private const uint FileMagic = 0x4946534E;
+
+        /// <summary>
+        ///     The format version.
+        /// </summary>
+        private const int FormatVersion = 2;
+
+        /// <summary>
+        ///     The alignment of sections.
+        /// </summary>
+        private const int PageSize = 0x1000;
+
+        /// <summary>
+        ///     The size of header. The end of header has the path of alias target.
+        /// </summary>
+        private const int HeaderSize = 0x400;
+
+        /// <summary>
+        ///     The offset of alias target path in header.
+        /// </summary>
+        private const int TargetPathOffset = 0x74;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="GameInfoIndex" /> class.
+        /// </summary>
+        /// <param name="file">The mapped file.</param>
+        /// <param name="view">The view of whole file.</param>
+        private GameInfoIndex(MemoryMappedFile file, MemoryMappedViewAccessor view)
+        {
+            this._file = file;
+            this._view = view;
+        }
+
+        /// <summary>
+        ///     The mapped file.
+        /// </summary>
+        private readonly MemoryMappedFile _file;
+
+        /// <summary>
+        ///     The view of whole file.
+        /// </summary>
+        private readonly MemoryMappedViewAccessor _view;
+
+        /// <summary>
+        ///     The functions that have been created so far.
+        /// </summary>
+        private GameInfo.GameFunctionInfo[] _functions;
+
+        /// <summary>
+        ///     The globals that have been created so far.
+        /// </summary>
+        private GameInfo.GameGlobalInfo[] _globals;
+
+        /// <summary>
+        ///     The positions of arrays in the file.
+        /// </summary>
+        private long _vidIds, _vidOffsets, _vidRefs, _fnBegins, _fnEnds, _fnIds, _fnShortNames, _fnFullNames, _gbBegins, _gbIds, _gbShortNames, _gbTypeNames, _strOffsets, _strData, _extra, _extraLength;
+
+        /// <summary>
+        ///     Gets the count of version independent identifiers.
+        /// </summary>
+        /// <value>
+        ///     The count of version independent identifiers.
+        /// </value>
+        internal int VidCount { get; private set; }
+
+        /// <summary>
+        ///     Gets the count of functions.
+        /// </summary>
+        /// <value>
+        ///     The count of functions.
+        /// </value>
+        internal int FunctionCount { get; private set; }
+
+        /// <summary>
+        ///     Gets the count of globals.
+        /// </summary>
+        /// <value>
+        ///     The count of globals.
+        /// </value>
+        internal int GlobalCount { get; private set; }
+
+        /// <summary>
+        ///     Gets the count of strings.
+        /// </summary>
+        /// <value>
+        ///     The count of strings.
+        /// </value>
+        internal int StringCount { get; private set; }
+
+        /// <summary>
+        ///     Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.
+        /// </summary>
+        public void Dispose()
+        {
+            this._view.Dispose();
+            this._file.Dispose();
+        }
+
+        /// <summary>
+        ///     Opens the index file. Returns null if the file does not exist or was not created from the current source file. If
+        ///     the source file was an alias then the file it pointed to must also be unchanged.
+        /// </summary>
+        /// <param name="file">The index file.</param>
+        /// <param name="source">The library file the index was created from.</param>
+        /// <returns></returns>
+        /// <exception cref="System.IO.InvalidDataException">Index file is corrupted!</exception>
+        internal static GameInfoIndex Open(FileInfo file, FileInfo source)
+        {
+            if ( !file.Exists || file.Length < HeaderSize )
+            {
+                return null;
+            }
+
+            var                      mapped = MemoryMappedFile.CreateFromFile(file.FullName, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            MemoryMappedViewAccessor view   = null;
+
+            try
+            {
+                view = mapped.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+                if ( view.ReadUInt32(0) != FileMagic || view.ReadInt32(4) != FormatVersion || view.ReadInt64(8) != source.Length || view.ReadInt64(16) != source.LastWriteTimeUtc.Ticks || !IsTargetCurrent(view, source) )
+                {
+                    view.Dispose();
+                    mapped.Dispose();
+                    return null;
+                }
+
+                var result = new GameInfoIndex(mapped, view);
+                result.ReadHeader();
+                return result;
+            }
+            catch
+            {
+                view?.Dispose();
+                mapped.Dispose();
+                throw;
+            }
+        }
+
+        /// <summary>
+        ///     Checks that the alias target recorded in index has not changed since the index was written.
+        /// </summary>
+        /// <param name="view">The view of index file.</param>
+        /// <param name="source">The library file.</param>
+        /// <returns></returns>
+        private static bool IsTargetCurrent(MemoryMappedViewAccessor view, FileInfo source)
+        {
+            var pathLength = view.ReadInt32(TargetPathOffset - 4);
+
+            if ( pathLength < 0 || pathLength > HeaderSize - TargetPathOffset )
+            {
+                return false;
+            }
+
+            var target = source;
+
+            if ( pathLength != 0 )
+            {
+                var path = new byte[pathLength];
+                view.ReadArray(TargetPathOffset, path, 0, pathLength);
+                target = new FileInfo(Encoding.UTF8.GetString(path));
+            }
+
+            return target.Exists && view.ReadInt64(96) == target.Length && view.ReadInt64(104) == target.LastWriteTimeUtc.Ticks;
+        }
+
+        /// <summary>
+        ///     Writes a new index file. The file is written next to the target first and then moved over it.
+        /// </summary>
+        /// <param name="file">The index file.</param>
+        /// <param name="source">The library file that was loaded.</param>
+        /// <param name="target">The library file the data was read from, this is different from source if source is an alias.</param>
+        /// <param name="functions">The functions.</param>
+        /// <param name="globals">The globals.</param>
+        /// <param name="extra">The uncompressed library stream of everything else.</param>
+        /// <exception cref="System.IO.PathTooLongException">Path of alias target is too long to store in index!</exception>
+        internal static void Write(FileInfo file, FileInfo source, FileInfo target, IReadOnlyList<GameInfo.GameFunctionInfo> functions, IReadOnlyList<GameInfo.GameGlobalInfo> globals, byte[] extra)
+        {
+            if ( target == null )
+            {
+                target = source;
+            }
+
+            var targetPath = string.Equals(target.FullName, source.FullName, StringComparison.OrdinalIgnoreCase) ? new byte[0] : Encoding.UTF8.GetBytes(target.FullName);
+
+            if ( targetPath.Length > HeaderSize - TargetPathOffset )
+            {
+                throw new PathTooLongException("Path of alias target is too long to store in index!");
+            }
+
+            var fns       = functions.OrderBy(q => q.Begin).ToArray();
+            var gbs       = globals.ToArray();
+            var strings   = new List<byte[]>();
+            var stringMap = new Dictionary<string, int>(StringComparer.Ordinal);
+
+            int AddString(string str)
+            {
+                if ( str == null )
+                {
+                    return -1;
+                }
+
+                if ( !stringMap.TryGetValue(str, out var index) )
+                {
+                    index          = strings.Count;
+                    stringMap[str] = index;
+                    strings.Add(Encoding.UTF8.GetBytes(str));
+                }
+
+                return index;
+            }
+
+            var vids = new List<Tuple<ulong, ulong, int>>(fns.Length + gbs.Length);
+
+            for ( var i = 0; i < fns.Length; i++ )
+            {
+                if ( fns[i].Id != 0 )
+                {
+                    vids.Add(new Tuple<ulong, ulong, int>(fns[i].Id, fns[i].Begin, i));
+                }
+            }
+
+            for ( var i = 0; i < gbs.Length; i++ )
+            {
+                if ( gbs[i].Id != 0 )
+                {
+                    vids.Add(new Tuple<ulong, ulong, int>(gbs[i].Id, gbs[i].Begin, ~i));
+                }
+            }
+
+            vids.Sort((u, v) => u.Item1.CompareTo(v.Item1));
+
+            // Identifiers are stored in Eytzinger order so the search touches few pages near the start of the array.
+            var order = new int[vids.Count];
+            var next  = 0;
+            BuildEytzinger(order, ref next, 1);
+
+            var temp = new FileInfo(file.FullName + ".tmp");
+
+            using ( var writer = new BinaryWriter(temp.Create()) )
+            {
+                writer.Write(new byte[HeaderSize]);
+
+                var vidSection = Pad(writer, PageSize);
+
+                foreach ( var i in order )
+                {
+                    writer.Write(vids[i].Item1);
+                }
+
+                foreach ( var i in order )
+                {
+                    writer.Write(vids[i].Item2);
+                }
+
+                foreach ( var i in order )
+                {
+                    writer.Write(vids[i].Item3);
+                }
+
+                var fnSection = Pad(writer, PageSize);
+
+                foreach ( var x in fns )
+                {
+                    writer.Write(x.Begin);
+                }
+
+                foreach ( var x in fns )
+                {
+                    writer.Write(x.End);
+                }
+
+                foreach ( var x in fns )
+                {
+                    writer.Write(x.Id);
+                }
+
+                foreach ( var x in fns )
+                {
+                    writer.Write(AddString(x.ShortName));
+                }
+
+                Pad(writer, 8);
+
+                foreach ( var x in fns )
+                {
+                    writer.Write(AddString(x.FullName));
+                }
+
+                var gbSection = Pad(writer, PageSize);
+
+                foreach ( var x in gbs )
+                {
+                    writer.Write(x.Begin);
+                }
+
+                foreach ( var x in gbs )
+                {
+                    writer.Write(x.Id);
+                }
+
+                foreach ( var x in gbs )
+                {
+                    writer.Write(AddString(x.ShortName));
+                }
+
+                Pad(writer, 8);
+
+                foreach ( var x in gbs )
+                {
+                    writer.Write(AddString(x.TypeName));
+                }
+
+                var strSection = Pad(writer, PageSize);
+                var strOffset  = 0;
+
+                foreach ( var x in strings )
+                {
+                    writer.Write(strOffset);
+                    strOffset += x.Length;
+                }
+
+                writer.Write(strOffset);
+                Pad(writer, 8);
+
+                foreach ( var x in strings )
+                {
+                    writer.Write(x);
+                }
+
+                var extraSection = Pad(writer, PageSize);
+                writer.Write(extra);
+
+                writer.Seek(0, SeekOrigin.Begin);
+                writer.Write(FileMagic);
+                writer.Write(FormatVersion);
+                writer.Write(source.Length);
+                writer.Write(source.LastWriteTimeUtc.Ticks);
+                writer.Write(vids.Count);
+                writer.Write(fns.Length);
+                writer.Write(gbs.Length);
+                writer.Write(strings.Count);
+                writer.Write(vidSection);
+                writer.Write(fnSection);
+                writer.Write(gbSection);
+                writer.Write(strSection);
+                writer.Write((long)strOffset);
+                writer.Write(extraSection);
+                writer.Write((long)extra.Length);
+                writer.Write(target.Length);
+                writer.Write(target.LastWriteTimeUtc.Ticks);
+                writer.Write(targetPath.Length);
+                writer.Write(targetPath);
+            }
+
+            File.Move(temp.FullName, file.FullName, true);
+        }
+
+        /// <summary>
+        ///     Opens a stream of the uncompressed library data that is not indexed.
+        /// </summary>
+        /// <returns></returns>
+        internal Stream OpenExtraStream() => this._file.CreateViewStream(this._extra, this._extraLength, MemoryMappedFileAccess.Read);
+
+        /// <summary>
+        ///     Tries to get the offset of object by its version independent identifier.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <param name="offset">The offset.</param>
+        /// <returns></returns>
+        internal bool TryGetOffset(ulong id, out ulong offset)
+        {
+            var index = this.FindVid(id);
+
+            if ( index < 0 )
+            {
+                offset = 0;
+                return false;
+            }
+
+            offset = this._view.ReadUInt64(this._vidOffsets + ((long)index * 8));
+            return true;
+        }
+
+        /// <summary>
+        ///     Gets all version independent identifiers and their offsets.
+        /// </summary>
+        /// <returns></returns>
+        internal IEnumerable<KeyValuePair<ulong, ulong>> GetVids()
+        {
+            for ( var i = 0; i < this.VidCount; i++ )
+            {
+                yield return new KeyValuePair<ulong, ulong>(this._view.ReadUInt64(this._vidIds + ((long)i * 8)), this._view.ReadUInt64(this._vidOffsets + ((long)i * 8)));
+            }
+        }
+
+        /// <summary>
+        ///     Gets the function by its version independent identifier.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <returns></returns>
+        internal GameInfo.GameFunctionInfo GetFunctionById(ulong id)
+        {
+            var index = this.FindVid(id);
+
+            if ( index < 0 )
+            {
+                return null;
+            }
+
+            var r = this._view.ReadInt32(this._vidRefs + ((long)index * 4));
+            return r >= 0 ? this.GetFunction(r) : null;
+        }
+
+        /// <summary>
+        ///     Gets the global by its version independent identifier.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <returns></returns>
+        internal GameInfo.GameGlobalInfo GetGlobalById(ulong id)
+        {
+            var index = this.FindVid(id);
+
+            if ( index < 0 )
+            {
+                return null;
+            }
+
+            var r = this._view.ReadInt32(this._vidRefs + ((long)index * 4));
+            return r < 0 ? this.GetGlobal(~r) : null;
+        }
+
+        /// <summary>
+        ///     Reads the begin and end offsets of all functions.
+        /// </summary>
+        /// <param name="begins">The begin offsets, sorted in ascending order.</param>
+        /// <param name="ends">The end offsets.</param>
+        internal void ReadFunctionRanges(ulong[] begins, ulong[] ends)
+        {
+            this._view.ReadArray(this._fnBegins, begins, 0, this.FunctionCount);
+            this._view.ReadArray(this._fnEnds,   ends,   0, this.FunctionCount);
+        }
+
+        /// <summary>
+        ///     Gets the function at index. Functions are sorted by their begin offset.
+        /// </summary>
+        /// <param name="index">The index.</param>
+        /// <returns></returns>
+        internal GameInfo.GameFunctionInfo GetFunction(int index)
+        {
+            var result = this._functions[index];
+
+            if ( result != null )
+            {
+                return result;
+            }
+
+            var i = (long)index;
+            result = new GameInfo.GameFunctionInfo(
+                this._view.ReadUInt64(this._fnIds    + (i * 8)),
+                this._view.ReadUInt64(this._fnBegins + (i * 8)),
+                this._view.ReadUInt64(this._fnEnds   + (i * 8)),
+                this.ReadString(this._view.ReadInt32(this._fnShortNames + (i * 4))),
+                this.ReadString(this._view.ReadInt32(this._fnFullNames  + (i * 4)))
+            );
+
+            return Interlocked.CompareExchange(ref this._functions[index], result, null) ?? result;
+        }
+
+        /// <summary>
+        ///     Gets the global at index.
+        /// </summary>
+        /// <param name="index">The index.</param>
+        /// <returns></returns>
+        internal GameInfo.GameGlobalInfo GetGlobal(int index)
+        {
+            var result = this._globals[index];
+
+            if ( result != null )
+            {
+                return result;
+            }
+
+            var i = (long)index;
+            result = new GameInfo.GameGlobalInfo(
+                this._view.ReadUInt64(this._gbIds    + (i * 8)),
+                this._view.ReadUInt64(this._gbBegins + (i * 8)),
+                this.ReadString(this._view.ReadInt32(this._gbShortNames + (i * 4))),
+                this.ReadString(this._view.ReadInt32(this._gbTypeNames  + (i * 4)))
+            );
+
+            return Interlocked.CompareExchange(ref this._globals[index], result, null) ?? result;
+        }
+
+        /// <summary>
+        ///     Reads the header and verifies that all sections are inside the file.
+        /// </summary>
+        /// <exception cref="System.IO.InvalidDataException">Index file is corrupted!</exception>
+        private void ReadHeader()
+        {
+            this.VidCount      = this._view.ReadInt32(24);
+            this.FunctionCount = this._view.ReadInt32(28);
+            this.GlobalCount   = this._view.ReadInt32(32);
+            this.StringCount   = this._view.ReadInt32(36);
+
+            var vidSection = this._view.ReadInt64(40);
+            var fnSection  = this._view.ReadInt64(48);
+            var gbSection  = this._view.ReadInt64(56);
+            var strSection = this._view.ReadInt64(64);
+            var strLength  = this._view.ReadInt64(72);
+            this._extra       = this._view.ReadInt64(80);
+            this._extraLength = this._view.ReadInt64(88);
+
+            if ( this.VidCount < 0 || this.FunctionCount < 0 || this.GlobalCount < 0 || this.StringCount < 0 || strLength < 0 || this._extraLength < 0 )
+            {
+                throw new InvalidDataException("Index file is corrupted!");
+            }
+
+            this._vidIds     = vidSection;
+            this._vidOffsets = this._vidIds     + ((long)this.VidCount * 8);
+            this._vidRefs    = this._vidOffsets + ((long)this.VidCount * 8);
+            var vidEnd = this._vidRefs + ((long)this.VidCount * 4);
+
+            this._fnBegins     = fnSection;
+            this._fnEnds       = this._fnBegins     + ((long)this.FunctionCount * 8);
+            this._fnIds        = this._fnEnds       + ((long)this.FunctionCount * 8);
+            this._fnShortNames = this._fnIds        + ((long)this.FunctionCount * 8);
+            this._fnFullNames  = Align(this._fnShortNames + ((long)this.FunctionCount * 4), 8);
+            var fnEnd = this._fnFullNames + ((long)this.FunctionCount * 4);
+
+            this._gbBegins     = gbSection;
+            this._gbIds        = this._gbBegins     + ((long)this.GlobalCount * 8);
+            this._gbShortNames = this._gbIds        + ((long)this.GlobalCount * 8);
+            this._gbTypeNames  = Align(this._gbShortNames + ((long)this.GlobalCount * 4), 8);
+            var gbEnd = this._gbTypeNames + ((long)this.GlobalCount * 4);
+
+            this._strOffsets = strSection;
+            this._strData    = Align(this._strOffsets + (((long)this.StringCount + 1) * 4), 8);
+            var strEnd = this._strData + strLength;
+
+            var capacity = this._view.Capacity;
+
+            if ( vidEnd > capacity || fnEnd > capacity || gbEnd > capacity || strEnd > capacity || this._extra < 0 || this._extra + this._extraLength > capacity )
+            {
+                throw new InvalidDataException("Index file is corrupted!");
+            }
+
+            this._functions = new GameInfo.GameFunctionInfo[this.FunctionCount];
+            this._globals   = new GameInfo.GameGlobalInfo[this.GlobalCount];
+        }
+
+        /// <summary>
+        ///     Finds the position of version independent identifier in the Eytzinger ordered arrays.
+        /// </summary>
+        /// <param name="id">The identifier.</param>
+        /// <returns></returns>
+        private int FindVid(ulong id)
+        {
+            var k = 1;
+
+            while ( k <= this.VidCount )
+            {
+                var v = this._view.ReadUInt64(this._vidIds + ((long)(k - 1) * 8));
+
+                if ( v == id )
+                {
+                    return k - 1;
+                }
+
+                k = (2 * k) + (v < id ? 1 : 0);
+            }
+
+            return -1;
+        }
+
+        /// <summary>
+        ///     Reads the string from string table.
+        /// </summary>
+        /// <param name="index">The index of string or -1 for null.</param>
+        /// <returns></returns>
+        private string ReadString(int index)
+        {
+            if ( index < 0 || index >= this.StringCount )
+            {
+                return null;
+            }
+
+            var begin = this._view.ReadInt32(this._strOffsets + ((long)index * 4));
+            var end   = this._view.ReadInt32(this._strOffsets + (((long)index + 1) * 4));
+
+            if ( end <= begin )
+            {
+                return string.Empty;
+            }
+
+            var data = new byte[end - begin];
+            this._view.ReadArray(this._strData + begin, data, 0, data.Length);
+            return Encoding.UTF8.GetString(data);
+        }
+
+        /// <summary>
+        ///     Fills the order of sorted entries in Eytzinger layout.
+        /// </summary>
+        /// <param name="order">The order.</param>
+        /// <param name="next">The next sorted index.</param>
+        /// <param name="k">The one based position in layout.</param>
+        private static void BuildEytzinger(int[] order, ref int next, int k)
+        {
+            if ( k > order.Length )
+            {
+                return;
+            }
+
+            BuildEytzinger(order, ref next, 2 * k);
+            order[k - 1] = next++;
+            BuildEytzinger(order, ref next, (2 * k) + 1);
+        }
+
+        /// <summary>
+        ///     Writes zeros until the position is aligned.
+        /// </summary>
+        /// <param name="writer">The writer.</param>
+        /// <param name="alignment">The alignment.</param>
+        /// <returns>The aligned position.</returns>
+        private static long Pad(BinaryWriter writer, int alignment)
+        {
+            var position = writer.BaseStream.Position;
+            var aligned  = Align(position, alignment);
+
+            if ( aligned != position )
+            {
+                writer.Write(new byte[aligned - position]);
+            }
+
+            return aligned;
+        }
+
+        /// <summary>
+        ///     Aligns the value up.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <param name="alignment">The alignment.</param>
+        /// <returns></returns>
+        private static long Align(long value, int alignment) => (value + alignment - 1) / alignment * alignment;
+    }
+}
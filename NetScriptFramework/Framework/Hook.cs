@@ -208,6 +208,44 @@
 
     #endregion
 
+    #region Context tracking
+
+        /// <summary>
+        ///     Writes code that records the deepest hook context reached on the current thread. Expects rcx to be the thread
+        ///     storage and rax the index of the context being allocated, rdx is overwritten.
+        /// </summary>
+        /// <param name="ms">The stream.</param>
+        protected internal static void WriteContextHighWater(BinaryWriter ms)
+        {
+            if ( !TrackContextDepth )
+            {
+                return;
+            }
+
+            ms.Write(new byte[] { 0x48, 0x8D, 0x50, 0x01 }); // lea rdx, [rax+1]
+            ms.Write(new byte[] { 0x48, 0x3B, 0x51, 0x20 }); // cmp rdx, [rcx+0x20]
+            ms.Write(new byte[] { 0x76, 0x04 });             // jbe +4
+            ms.Write(new byte[] { 0x48, 0x89, 0x51, 0x20 }); // mov [rcx+0x20], rdx
+        }
+
+        /// <summary>
+        ///     Value indicating whether hooks record the high-water mark of their context depth.
+        /// </summary>
+        internal static readonly bool TrackContextDepth = GetTrackContextDepth();
+
+        /// <summary>
+        ///     Reads the context depth tracking setting.
+        /// </summary>
+        /// <returns></returns>
+        private static bool GetTrackContextDepth()
+        {
+            var vl      = Main.Config?.GetValue(Main._Config_Debug_Hook_TrackDepth);
+            var enabled = 0;
+            return vl != null && vl.TryToInt32(out enabled) && enabled > 0;
+        }
+
+    #endregion
+
     #region Imports
 
         [ DllImport("NetScriptFramework.Runtime.dll") ]
@@ -322,6 +360,7 @@
                                 ms.Write(new byte[] { 0xFF, 0xD0 });       // call rax
                                 // AllocateOk:
                                 ms.Write(new byte[] { 0x48, 0xFF, 0x01 }); // inc qword ptr [rcx]
+                                WriteContextHighWater(ms);
                                 ms.Write(new byte[] { 0x48, 0x69, 0xC0 });
                                 ms.Write(GetHookContextSize());                  // imul rax, HOOK_CONTEXT_SIZE
                                 ms.Write(new byte[] { 0x48, 0x8B, 0x49, 0x08 }); // mov rcx, [rcx+8]
@@ -492,26 +531,6 @@
             include1 = this.Include(hookIncludeLength > 0 ? Memory.ReadBytes(hookIncludeBase, hookIncludeLength) : null, hookIncludeBase, this._Address_PostInclude);
         }
 
-        /// <summary>
-        ///     Compares the bytes.
-        /// </summary>
-        /// <param name="data">The data.</param>
-        /// <param name="pattern">The pattern.</param>
-        /// <param name="index">The index.</param>
-        /// <returns></returns>
-        private static bool CompareBytes(byte[] data, byte[] pattern, int index)
-        {
-            for ( var i = 0; i < pattern.Length; i++, index++ )
-            {
-                if ( pattern[i] != data[index] )
-                {
-                    return false;
-                }
-            }
-
-            return true;
-        }
-
         /// <summary>
         ///     Gets the near hook address.
         /// </summary>
@@ -582,53 +601,19 @@
                 info = new ModuleNearJumpHook(Memory.ReadPointer(alloc.Address + 0x20), Memory.ReadPointer(alloc.Address), Memory.ReadPointer(alloc.Address + 0x10));
             }
 
-            var begin   = info.BeginAddress.ToUInt64();
-            var end     = info.EndAddress.ToUInt64();
-            var ptr     = begin;
-            var pattern = new byte[13] { 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC };
-            var plen    = pattern.Length + 1;
-            var found   = IntPtr.Zero;
-            var stop    = false;
+            // Size of the jump code written below.
+            var caveSize = 13;
+            var found    = CodeCaveIndex.Reserve(info.BeginAddress, info.EndAddress, caveSize);
 
-            while ( ptr < end && !stop )
+            // No room in module, use executable memory allocated within near jump distance of it instead.
+            if ( found == IntPtr.Zero )
             {
-                var size    = end  - ptr;
-                var maxSize = 4000 + (ulong)plen;
-
-                if ( size > maxSize )
-                {
-                    size = maxSize;
-                }
-                else
-                {
-                    stop = true;
-                }
-
-                var addr  = new IntPtr(unchecked((long)ptr));
-                var chunk = Memory.ReadBytes(addr, (int)size);
-
-                var highIndex = chunk.Length - plen;
-
-                for ( var i = 0; i < highIndex; i++ )
-                {
-                    var b = chunk[i];
-
-                    if ( b != 0xC3 && b != 0xCC )
-                    {
-                        continue;
-                    }
-
-                    if ( CompareBytes(chunk, pattern, i + 1) )
-                    {
-                        found = addr + i;
-                        stop  = true;
-                        break;
-                    }
-                }
+                var near = Memory.AllocateCodeNear(caveSize, info.BeginAddress, info.EndAddress);
 
-                if ( !stop )
+                if ( near != null )
                 {
-                    ptr += maxSize - (ulong)plen;
+                    near.Pin();
+                    found = near.Address;
                 }
             }
 
@@ -637,9 +622,6 @@
                 throw new InvalidOperationException("Didn't find a code cave for near jump setup!");
             }
 
-            // ret was part of the pattern so skip 1 byte to skip it.
-            found = found + 1;
-
             // Bad.
             if ( this._Address_EnterHook == IntPtr.Zero )
             {
@@ -663,7 +645,7 @@
                     }
                 }
 
-                if ( data.Length > plen - 1 )
+                if ( data.Length > caveSize )
                 {
                     throw new InvalidOperationException("Failed to write near jump code! Not enough memory in specified code cave.");
                 }
@@ -892,6 +874,7 @@
                             ms.Write(new byte[] { 0xFF, 0xD0 });       // call rax
                             // AllocateOk:
                             ms.Write(new byte[] { 0x48, 0xFF, 0x01 }); // inc qword ptr [rcx]
+                            WriteContextHighWater(ms);
                             ms.Write(new byte[] { 0x48, 0x69, 0xC0 });
                             ms.Write(GetHookContextSize());                  // imul rax, HOOK_CONTEXT_SIZE
                             ms.Write(new byte[] { 0x48, 0x8B, 0x49, 0x08 }); // mov rcx, [rcx+8]
@@ -1016,36 +999,16 @@
 
             if ( isLongJump )
             {
-                target = this.GetFarHookAddress(hookSourceBase, alloc_do.Address);
+                target = GetFarHookAddress(hookSourceBase, alloc_do.Address);
             }
             else
             {
-                target = this.GetNearHookAddress(hookSourceBase, alloc_do.Address);
+                target = GetNearHookAddress(hookSourceBase, alloc_do.Address);
             }
 
             include2 = this._Address_PostInclude;
         }
 
-        /// <summary>
-        ///     Compares the bytes.
-        /// </summary>
-        /// <param name="data">The data.</param>
-        /// <param name="pattern">The pattern.</param>
-        /// <param name="index">The index.</param>
-        /// <returns></returns>
-        private static bool CompareBytes(byte[] data, byte[] pattern, int index)
-        {
-            for ( var i = 0; i < pattern.Length; i++, index++ )
-            {
-                if ( pattern[i] != data[index] )
-                {
-                    return false;
-                }
-            }
-
-            return true;
-        }
-
         /// <summary>
         ///     Gets the near hook address.
         /// </summary>
@@ -1066,11 +1029,11 @@
         /// </exception>
         /// <exception cref="System.ArgumentOutOfRangeException"></exception>
         /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
-        private IntPtr GetNearHookAddress(IntPtr hookAddress, IntPtr targetAddress)
+        internal static IntPtr GetNearHookAddress(IntPtr hookAddress, IntPtr targetAddress)
         {
             if ( !Main.Is64Bit )
             {
-                return this.GetFarHookAddress(hookAddress, targetAddress);
+                return GetFarHookAddress(hookAddress, targetAddress);
             }
 
             ModuleNearJumpHook info = null;
@@ -1107,45 +1070,19 @@
                 info = new ModuleNearJumpHook(Memory.ReadPointer(alloc.Address + 0x20), Memory.ReadPointer(alloc.Address), Memory.ReadPointer(alloc.Address + 0x10));
             }
 
-            var begin   = info.BeginAddress.ToUInt64();
-            var end     = info.EndAddress.ToUInt64();
-            var ptr     = begin;
-            var pattern = new byte[14] { 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC };
-            var found   = IntPtr.Zero;
-            var stop    = false;
+            // Size of the jump code written below.
+            var caveSize = 13;
+            var found    = CodeCaveIndex.Reserve(info.BeginAddress, info.EndAddress, caveSize);
 
-            while ( ptr < end && !stop )
+            // No room in module, use executable memory allocated within near jump distance of it instead.
+            if ( found == IntPtr.Zero )
             {
-                var size    = end  - ptr;
-                var maxSize = 4000 + (ulong)pattern.Length;
+                var near = Memory.AllocateCodeNear(caveSize, info.BeginAddress, info.EndAddress);
 
-                if ( size > maxSize )
+                if ( near != null )
                 {
-                    size = maxSize;
-                }
-                else
-                {
-                    stop = true;
-                }
-
-                var addr  = new IntPtr(unchecked((long)ptr));
-                var chunk = Memory.ReadBytes(addr, (int)size);
-
-                var highIndex = chunk.Length - pattern.Length;
-
-                for ( var i = 0; i < highIndex; i++ )
-                {
-                    if ( CompareBytes(chunk, pattern, i) )
-                    {
-                        found = addr + i;
-                        stop  = true;
-                        break;
-                    }
-                }
-
-                if ( !stop )
-                {
-                    ptr += maxSize - (ulong)pattern.Length;
+                    near.Pin();
+                    found = near.Address;
                 }
             }
 
@@ -1154,9 +1091,6 @@
                 throw new InvalidOperationException("Didn't find a code cave for near jump setup!");
             }
 
-            // ret was part of the pattern so skip 1 byte to skip it.
-            found = found + 1;
-
             // Bad.
             if ( targetAddress == IntPtr.Zero )
             {
@@ -1180,7 +1114,7 @@
                     }
                 }
 
-                if ( data.Length > pattern.Length - 1 )
+                if ( data.Length > caveSize )
                 {
                     throw new InvalidOperationException("Failed to write near jump code! Not enough memory in specified code cave.");
                 }
@@ -1198,7 +1132,7 @@
         /// <param name="hookAddress">The hook address (source).</param>
         /// <param name="targetAddress">The target address.</param>
         /// <returns></returns>
-        private IntPtr GetFarHookAddress(IntPtr hookAddress, IntPtr targetAddress)
+        internal static IntPtr GetFarHookAddress(IntPtr hookAddress, IntPtr targetAddress)
         {
             // Bad.
             if ( targetAddress == IntPtr.Zero )
@@ -1325,6 +1259,7 @@
                                 ms.Write(new byte[] { 0xFF, 0xD0 });       // call rax
                                 // AllocateOk:
                                 ms.Write(new byte[] { 0x48, 0xFF, 0x01 }); // inc qword ptr [rcx]
+                                WriteContextHighWater(ms);
                                 ms.Write(new byte[] { 0x48, 0x69, 0xC0 });
                                 ms.Write(GetHookContextSize());                  // imul rax, HOOK_CONTEXT_SIZE
                                 ms.Write(new byte[] { 0x48, 0x8B, 0x49, 0x08 }); // mov rcx, [rcx+8]
@@ -1590,26 +1525,6 @@
             include2 = this._Address_PostInclude2;
         }
 
-        /// <summary>
-        ///     Compares the bytes.
-        /// </summary>
-        /// <param name="data">The data.</param>
-        /// <param name="pattern">The pattern.</param>
-        /// <param name="index">The index.</param>
-        /// <returns></returns>
-        private static bool CompareBytes(byte[] data, byte[] pattern, int index)
-        {
-            for ( var i = 0; i < pattern.Length; i++, index++ )
-            {
-                if ( pattern[i] != data[index] )
-                {
-                    return false;
-                }
-            }
-
-            return true;
-        }
-
         /// <summary>
         ///     Gets the near hook address.
         /// </summary>
@@ -1680,45 +1595,19 @@
                 info = new ModuleNearJumpHook(Memory.ReadPointer(alloc.Address + 0x20), Memory.ReadPointer(alloc.Address), Memory.ReadPointer(alloc.Address + 0x10));
             }
 
-            var begin   = info.BeginAddress.ToUInt64();
-            var end     = info.EndAddress.ToUInt64();
-            var ptr     = begin;
-            var pattern = new byte[14] { 0xC3, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC };
-            var found   = IntPtr.Zero;
-            var stop    = false;
+            // Size of the jump code written below.
+            var caveSize = 13;
+            var found    = CodeCaveIndex.Reserve(info.BeginAddress, info.EndAddress, caveSize);
 
-            while ( ptr < end && !stop )
+            // No room in module, use executable memory allocated within near jump distance of it instead.
+            if ( found == IntPtr.Zero )
             {
-                var size    = end  - ptr;
-                var maxSize = 4000 + (ulong)pattern.Length;
-
-                if ( size > maxSize )
-                {
-                    size = maxSize;
-                }
-                else
-                {
-                    stop = true;
-                }
-
-                var addr  = new IntPtr(unchecked((long)ptr));
-                var chunk = Memory.ReadBytes(addr, (int)size);
+                var near = Memory.AllocateCodeNear(caveSize, info.BeginAddress, info.EndAddress);
 
-                var highIndex = chunk.Length - pattern.Length;
-
-                for ( var i = 0; i < highIndex; i++ )
+                if ( near != null )
                 {
-                    if ( CompareBytes(chunk, pattern, i) )
-                    {
-                        found = addr + i;
-                        stop  = true;
-                        break;
-                    }
-                }
-
-                if ( !stop )
-                {
-                    ptr += maxSize - (ulong)pattern.Length;
+                    near.Pin();
+                    found = near.Address;
                 }
             }
 
@@ -1727,9 +1616,6 @@
                 throw new InvalidOperationException("Didn't find a code cave for near jump setup!");
             }
 
-            // ret was part of the pattern so skip 1 byte to skip it.
-            found = found + 1;
-
             // Bad.
             if ( this._Address_EnterHook == IntPtr.Zero )
             {
@@ -1753,7 +1639,7 @@
                     }
                 }
 
-                if ( data.Length > pattern.Length - 1 )
+                if ( data.Length > caveSize )
                 {
                     throw new InvalidOperationException("Failed to write near jump code! Not enough memory in specified code cave.");
                 }
@@ -1816,92 +1702,186 @@
         }
     }
 
-    /*/// <summary>
-    /// Performance monitor hook.
+    /// <summary>
+    ///     Performance monitor hook. Entry and exit of the monitored function is timed in native code without entering CLR.
     /// </summary>
     /// <seealso cref="NetScriptFramework.Tools._Internal.HookBase" />
     internal sealed class HookPerformance : HookBase
     {
         /// <summary>
-        /// Prevents a default instance of the <see cref="HookPerformance"/> class from being created.
+        ///     The instance of this type of hook setup.
+        /// </summary>
+        internal static readonly HookPerformance Instance = new HookPerformance();
+
+        /// <summary>
+        ///     The address where monitored functions return to instead of their caller.
+        /// </summary>
+        private readonly IntPtr _Address_Exit = IntPtr.Zero;
+
+        /// <summary>
+        ///     Prevents a default instance of the <see cref="HookPerformance" /> class from being created.
         /// </summary>
         private HookPerformance()
         {
-            // Setup.
+            // Setup the exit point.
             {
                 byte[] data = null;
 
-                // [rsp+0] = called from return address
-                if (Main.Is64Bit)
+                // [rsp+0x00] = caller of the monitored function has already been popped, rax and xmm0 hold the return value
+                if ( Main.Is64Bit )
                 {
-                    using (MemoryStream stream = new MemoryStream())
+                    using ( var stream = new MemoryStream() )
                     {
-                        using (BinaryWriter ms = new BinaryWriter(stream))
+                        using ( var ms = new BinaryWriter(stream) )
                         {
-                            int psize = 8;
-
-                            ms.Write(new byte[] { 0x51 }); // push rcx
-                            ms.Write(new byte[] { 0x50 }); // push rax
-                            ms.Write(new byte[] { 0x52 }); // push rdx
-
-                            ms.Write(new byte[] { 0x9C }); // pushfq
-                            {
-                                int tls = GetTLSIndex();
-                                ms.Write(new byte[] { 0x48, 0xB9 }); ms.Write((long)tls); // mov rcx, TlsIndex
-                                if (tls < 0x40)
-                                    ms.Write(new byte[] { 0x65, 0x48, 0x8B, 0x04, 0xCD, 0x80, 0x14, 0x00, 0x00 }); // mov rax, gs:[rcx*8 + 0x1480]
-                                else
-                                {
-                                    ms.Write(new byte[] { 0x65, 0x48, 0x8B, 0x04, 0x25, 0x80, 0x17, 0x00, 0x00 }); // mov rax, gs:0x1780
-                                    ms.Write(new byte[] { 0x48, 0x8B, 0x84, 0xC8, 0x00, 0xFE, 0xFF, 0xFF }); // mov rax, [rax+rcx*8-0x200]
-                                }
-                                ms.Write(new byte[] { 0x48, 0x89, 0xC1 }); // mov rcx, rax
-                                ms.Write(new byte[] { 0x48, 0x8B, 0x49, (byte)(psize * 3) }); // mov rcx, [rcx+p*3]
-
-                                // pmon base alloc is rcx
-                                TODO();
-                            }
-                            ms.Write(new byte[] { 0x9D }); // popfq
-
-                            ms.Write(new byte[] { 0x5A }); // pop rdx
-                            ms.Write(new byte[] { 0x58 }); // pop rax
-
-                            // get correct address to go to from return address, maybe also in TLS
-                            TODO();
-
-                            // change the return address to come back here instead of where we were
-                            TODO();
-
-                            // jump there without disturbing registers
-                            TODO();
-
-                            // get tls again and dec depth, if 0 then add up to total-inclusive, iterate upwards in stack and reduce total-exc for all by the diff, get real return from stack and jump back to continue execution
+                            ms.Write(new byte[] { 0x48, 0x83, 0xEC, 0x08 });             // sub rsp, 8
+                            ms.Write(new byte[] { 0x50 });                               // push rax
+                            ms.Write(new byte[] { 0x52 });                               // push rdx
+                            ms.Write(new byte[] { 0x49, 0x89, 0xE3 });                   // mov r11, rsp
+                            ms.Write(new byte[] { 0x48, 0x83, 0xE4, 0xF0 });             // and rsp, 0xFFFFFFFFFFFFFFF0
+                            ms.Write(new byte[] { 0x48, 0x83, 0xEC, 0x40 });             // sub rsp, 0x40
+                            ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x44, 0x24, 0x20 }); // movdqu [rsp+0x20], xmm0
+                            ms.Write(new byte[] { 0x4C, 0x89, 0x5C, 0x24, 0x30 });       // mov [rsp+0x30], r11
+                            ms.Write(new byte[] { 0x48, 0xB8 });
+                            ms.Write(GetPerformanceMonitorExitAddress().ToInt64());      // mov rax, PerformanceMonitorExit
+                            ms.Write(new byte[] { 0xFF, 0xD0 });                         // call rax
+                            ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x44, 0x24, 0x20 }); // movdqu xmm0, [rsp+0x20]
+                            ms.Write(new byte[] { 0x48, 0x8B, 0x64, 0x24, 0x30 });       // mov rsp, [rsp+0x30]
+                            ms.Write(new byte[] { 0x48, 0x89, 0x44, 0x24, 0x10 });       // mov [rsp+0x10], rax
+                            ms.Write(new byte[] { 0x5A });                               // pop rdx
+                            ms.Write(new byte[] { 0x58 });                               // pop rax
+                            ms.Write(new byte[] { 0xC3 });                               // ret
 
                             data = stream.ToArray();
                         }
                     }
                 }
                 else
+                {
                     throw new NotImplementedException();
+                }
 
                 var alloc_do = Memory.Allocate(data.Length + 0x10, 0, true);
                 alloc_do.Pin();
-                this._Address_PostInclude2 = alloc_do.Address;
-                Memory.WriteBytes(this._Address_PostInclude2, data);
+                this._Address_Exit = alloc_do.Address;
+                Memory.WriteBytes(this._Address_Exit, data);
+                SetPerformanceMonitorExitCode(this._Address_Exit);
             }
         }
 
-        internal override void BuildHook(IntPtr hookSourceBase, int hookReplaceLength, IntPtr hookIncludeBase, int hookIncludeLength, bool isLongJump, ref IntPtr target, ref IntPtr include1, ref IntPtr include2)
+        /// <summary>
+        ///     Not used, performance hooks are built with <see cref="BuildMonitor" /> because they need the slot of the function.
+        /// </summary>
+        internal override void BuildHook(IntPtr hookSourceBase, int hookReplaceLength, IntPtr hookIncludeBase, int hookIncludeLength, bool isLongJump, ref IntPtr target, ref IntPtr include1, ref IntPtr include2) =>
+            throw new NotSupportedException();
+
+        /// <summary>
+        ///     Builds the entry code of a monitored function.
+        /// </summary>
+        /// <param name="hookSourceBase">The address of monitored function.</param>
+        /// <param name="hookReplaceLength">Length of the code that is replaced and included.</param>
+        /// <param name="slot">The slot of function in the native performance monitor.</param>
+        /// <param name="isLongJump">Is this long jump or short.</param>
+        /// <returns>The target that the hook must call.</returns>
+        internal IntPtr BuildMonitor(IntPtr hookSourceBase, int hookReplaceLength, int slot, bool isLongJump)
         {
-            if (hookReplaceLength != 5 || hookIncludeLength != 5 || isLongJump)
-                throw new ArgumentOutOfRangeException();
+            byte[] data = null;
 
+            // Used for temporary offsets.
+            var tempBack = new List<KeyValuePair<long, long>>();
 
+            // [stack+0x10] = return address of monitored function
+            // [stack+0x08] = hook_source + (5/13)
+            // [stack+0x00] = rcx
+            if ( Main.Is64Bit )
+            {
+                using ( var stream = new MemoryStream() )
+                {
+                    using ( var ms = new BinaryWriter(stream) )
+                    {
+                        ms.Write(new byte[] { 0x59 });                                     // pop rcx
+                        ms.Write(new byte[] { 0x50 });                                     // push rax
+                        ms.Write(new byte[] { 0x51 });                                     // push rcx
+                        ms.Write(new byte[] { 0x52 });                                     // push rdx
+                        ms.Write(new byte[] { 0x41, 0x50 });                               // push r8
+                        ms.Write(new byte[] { 0x41, 0x51 });                               // push r9
+                        ms.Write(new byte[] { 0x41, 0x52 });                               // push r10
+                        ms.Write(new byte[] { 0x41, 0x53 });                               // push r11
+                        ms.Write(new byte[] { 0x9C });                                     // pushfq
+                        ms.Write(new byte[] { 0x49, 0x89, 0xE3 });                         // mov r11, rsp
+                        ms.Write(new byte[] { 0x48, 0x83, 0xE4, 0xF0 });                   // and rsp, 0xFFFFFFFFFFFFFFF0
+                        ms.Write(new byte[] { 0x48, 0x81, 0xEC, 0x90, 0x00, 0x00, 0x00 }); // sub rsp, 0x90
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x44, 0x24, 0x20 });       // movdqu [rsp+0x20], xmm0
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x4C, 0x24, 0x30 });       // movdqu [rsp+0x30], xmm1
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x54, 0x24, 0x40 });       // movdqu [rsp+0x40], xmm2
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x5C, 0x24, 0x50 });       // movdqu [rsp+0x50], xmm3
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x64, 0x24, 0x60 });       // movdqu [rsp+0x60], xmm4
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x7F, 0x6C, 0x24, 0x70 });       // movdqu [rsp+0x70], xmm5
+                        ms.Write(new byte[] { 0x4C, 0x89, 0x9C, 0x24, 0x80, 0x00, 0x00, 0x00 }); // mov [rsp+0x80], r11
+                        ms.Write(new byte[] { 0xB9 });
+                        ms.Write(slot);                                  // mov ecx, slot
+                        ms.Write(new byte[] { 0x49, 0x8D, 0x53, 0x48 }); // lea rdx, [r11+0x48] (return address)
+                        ms.Write(new byte[] { 0x48, 0xB8 });
+                        ms.Write(GetPerformanceMonitorEnterAddress().ToInt64());                 // mov rax, PerformanceMonitorEnter
+                        ms.Write(new byte[] { 0xFF, 0xD0 });                                     // call rax
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x44, 0x24, 0x20 });             // movdqu xmm0, [rsp+0x20]
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x4C, 0x24, 0x30 });             // movdqu xmm1, [rsp+0x30]
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x54, 0x24, 0x40 });             // movdqu xmm2, [rsp+0x40]
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x5C, 0x24, 0x50 });             // movdqu xmm3, [rsp+0x50]
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x64, 0x24, 0x60 });             // movdqu xmm4, [rsp+0x60]
+                        ms.Write(new byte[] { 0xF3, 0x0F, 0x6F, 0x6C, 0x24, 0x70 });             // movdqu xmm5, [rsp+0x70]
+                        ms.Write(new byte[] { 0x48, 0x8B, 0xA4, 0x24, 0x80, 0x00, 0x00, 0x00 }); // mov rsp, [rsp+0x80]
+                        ms.Write(new byte[] { 0x9D });                                           // popfq
+                        ms.Write(new byte[] { 0x41, 0x5B });                                     // pop r11
+                        ms.Write(new byte[] { 0x41, 0x5A });                                     // pop r10
+                        ms.Write(new byte[] { 0x41, 0x59 });                                     // pop r9
+                        ms.Write(new byte[] { 0x41, 0x58 });                                     // pop r8
+                        ms.Write(new byte[] { 0x5A });                                           // pop rdx
+                        ms.Write(new byte[] { 0x59 });                                           // pop rcx
+                        ms.Write(new byte[] { 0x58 });                                           // pop rax
+                        ms.Write(new byte[] { 0x48, 0x8D, 0x64, 0x24, 0x08 });                   // lea rsp, [rsp+8]
+
+                        // Include
+                        var code = Memory.ReadBytes(hookSourceBase, hookReplaceLength);
+                        this.WriteConvertedCode(code, ms, hookSourceBase, 0, tempBack);
+
+                        ms.Write(new byte[] { 0xFF, 0x25, 0x00, 0x00, 0x00, 0x00 }); // jmp [rip]
+                        ms.Write((hookSourceBase + hookReplaceLength).ToInt64());
+
+                        data = stream.ToArray();
+                    }
+                }
+            }
+            else
+            {
+                throw new NotImplementedException();
+            }
+
+            var alloc_do = Memory.Allocate(data.Length + 0x10, 0, true);
+            alloc_do.Pin();
+            Memory.WriteBytes(alloc_do.Address, data);
+
+            foreach ( var x in tempBack )
+            {
+                var afterAddr  = alloc_do.Address + (int)x.Value;
+                var afterBytes = BitConverter.GetBytes(afterAddr.ToInt64());
+                Memory.WriteBytes(alloc_do.Address + (int)x.Key, afterBytes);
+            }
+
+            return isLongJump ? HookAfter.GetFarHookAddress(hookSourceBase, alloc_do.Address) : HookAfter.GetNearHookAddress(hookSourceBase, alloc_do.Address);
         }
 
-        /// <summary>
-        /// The instance of this type of hook setup.
-        /// </summary>
-        internal static readonly HookPerformance Instance = new HookPerformance();
-    }*/
+    #region Imports
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern IntPtr GetPerformanceMonitorEnterAddress();
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern IntPtr GetPerformanceMonitorExitAddress();
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern void SetPerformanceMonitorExitCode(IntPtr address);
+
+    #endregion
+    }
 }
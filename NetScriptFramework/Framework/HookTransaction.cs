@@ -0,0 +1,404 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Runtime.InteropServices;
+    using System.Threading;
+
+    using Tools._Internal;
+
+    /// <summary>
+    ///     Collects code hooks and protected memory writes and applies all of them at once. While a transaction is active on
+    ///     the current thread, <see cref="Memory.WriteHook(HookParameters)" />,
+    ///     <see cref="Memory.WriteBytes(IntPtr, byte[], bool)" /> with protection and other protected writes are recorded
+    ///     instead of written. On commit other threads are suspended once, protection of each touched page is changed once,
+    ///     all patches are written and the instruction cache is flushed once. If a suspended thread is stopped inside the
+    ///     bytes of a patch the threads are resumed and suspended again until none is, so no thread continues in the middle
+    ///     of a rewritten instruction. Either every patch is written or none of them are, if the transaction is disposed
+    ///     without committing then the recorded hooks are removed again. Removed hooks don't release their trampoline code
+    ///     or the code caves that were reserved for them, so a rolled back transaction leaks that memory.
+    /// </summary>
+    /// <example>
+    ///     <code>
+    ///     using ( var transaction = new HookTransaction() )
+    ///     {
+    ///         Memory.WriteHook(...);
+    ///         Memory.WriteHook(...);
+    ///         transaction.Commit();
+    ///     }
+    ///     </code>
+    /// </example>
+    public sealed class HookTransaction : IDisposable
+    {
+        /// <summary>
+        ///     The active transaction of current thread.
+        /// </summary>
+        [ ThreadStatic ]
+        private static HookTransaction _current;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="HookTransaction" /> class and makes it active on the current thread.
+        /// </summary>
+        /// <exception cref="System.InvalidOperationException">A hook transaction is already active on this thread!</exception>
+        public HookTransaction()
+        {
+            if ( _current != null )
+            {
+                throw new InvalidOperationException("A hook transaction is already active on this thread!");
+            }
+
+            _current = this;
+        }
+
+        /// <summary>
+        ///     The recorded patches in the order they were written.
+        /// </summary>
+        private readonly List<Patch> Patches = new List<Patch>();
+
+        /// <summary>
+        ///     The hooks that were registered during this transaction.
+        /// </summary>
+        private readonly HashSet<HookInfo> Hooks = new HashSet<HookInfo>();
+
+        /// <summary>
+        ///     The hooks whose code is switched by this transaction and whether they will be active after commit.
+        /// </summary>
+        private readonly Dictionary<HookInfo, bool> Activations = new Dictionary<HookInfo, bool>();
+
+        /// <summary>
+        ///     Is this transaction committed or rolled back.
+        /// </summary>
+        private bool IsDone;
+
+        /// <summary>
+        ///     How many times threads are suspended again if one was inside a patch before giving up.
+        /// </summary>
+        private const int MaxSuspendAttempts = 100;
+
+        /// <summary>
+        ///     Gets the active transaction of current thread or null if there is none.
+        /// </summary>
+        /// <value>
+        ///     The active transaction.
+        /// </value>
+        public static HookTransaction Current => _current;
+
+        /// <summary>
+        ///     Gets the count of recorded patches.
+        /// </summary>
+        /// <value>
+        ///     The count of recorded patches.
+        /// </value>
+        public int PatchCount => this.Patches.Count;
+
+        /// <summary>
+        ///     Writes all recorded patches. If any page can't be made writable then nothing is written, the recorded hooks are
+        ///     removed and an exception is thrown.
+        /// </summary>
+        /// <exception cref="System.InvalidOperationException">Hook transaction was already committed or rolled back!</exception>
+        /// <exception cref="NetScriptFramework.MemoryAccessException">A page could not be made writable.</exception>
+        public void Commit()
+        {
+            this.End();
+
+            try
+            {
+                this.Apply();
+            }
+            catch
+            {
+                Memory.RemoveHooks(this.Hooks);
+                throw;
+            }
+
+            foreach ( var pair in this.Activations )
+            {
+                pair.Key.IsActive = pair.Value;
+            }
+        }
+
+        /// <summary>
+        ///     Discards all recorded patches and removes the recorded hooks.
+        /// </summary>
+        /// <exception cref="System.InvalidOperationException">Hook transaction was already committed or rolled back!</exception>
+        public void Rollback()
+        {
+            this.End();
+            Memory.RemoveHooks(this.Hooks);
+        }
+
+        /// <summary>
+        ///     Rolls back the transaction if it was not committed.
+        /// </summary>
+        public void Dispose()
+        {
+            if ( !this.IsDone )
+            {
+                this.Rollback();
+            }
+        }
+
+        /// <summary>
+        ///     Records a protected write.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <param name="buffer">The buffer.</param>
+        /// <param name="index">The index in buffer.</param>
+        /// <param name="length">The length.</param>
+        internal void AddPatch(IntPtr address, byte[] buffer, int index, int length)
+        {
+            if ( length <= 0 )
+            {
+                return;
+            }
+
+            var data = new byte[length];
+            Buffer.BlockCopy(buffer, index, data, 0, length);
+            this.Patches.Add(new Patch(address, data));
+        }
+
+        /// <summary>
+        ///     Records a registered hook so it can be removed on rollback.
+        /// </summary>
+        /// <param name="hook">The hook.</param>
+        internal void AddHook(HookInfo hook) => this.Hooks.Add(hook);
+
+        /// <summary>
+        ///     Records that the code of hook is switched, <see cref="HookInfo.IsActive" /> is only changed once the transaction
+        ///     is committed.
+        /// </summary>
+        /// <param name="hook">The hook.</param>
+        /// <param name="active">Whether the hook is active after commit.</param>
+        internal void SetActive(HookInfo hook, bool active) => this.Activations[hook] = active;
+
+        /// <summary>
+        ///     Gets whether the hook will be active after this transaction is committed.
+        /// </summary>
+        /// <param name="hook">The hook.</param>
+        /// <returns></returns>
+        internal bool IsActive(HookInfo hook)
+        {
+            bool active;
+
+            if ( this.Activations.TryGetValue(hook, out active) )
+            {
+                return active;
+            }
+
+            return hook.IsActive;
+        }
+
+        /// <summary>
+        ///     Ends the transaction on current thread.
+        /// </summary>
+        /// <exception cref="System.InvalidOperationException">Hook transaction was already committed or rolled back!</exception>
+        private void End()
+        {
+            if ( this.IsDone )
+            {
+                throw new InvalidOperationException("Hook transaction was already committed or rolled back!");
+            }
+
+            this.IsDone = true;
+
+            if ( _current == this )
+            {
+                _current = null;
+            }
+        }
+
+        /// <summary>
+        ///     Writes the patches. Everything is allocated before other threads are suspended because a suspended thread may
+        ///     hold a lock that allocating needs.
+        /// </summary>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        private void Apply()
+        {
+            if ( this.Patches.Count == 0 )
+            {
+                return;
+            }
+
+            var pageSize = (long)Environment.SystemPageSize;
+            var pageList = new List<long>();
+            var min      = long.MaxValue;
+            var max      = long.MinValue;
+
+            foreach ( var p in this.Patches )
+            {
+                var begin = p.Address.ToInt64();
+                var end   = begin + p.Data.Length;
+
+                for ( var page = begin / pageSize * pageSize; page < end; page += pageSize )
+                {
+                    pageList.Add(page);
+                }
+
+                min = Math.Min(min, begin);
+                max = Math.Max(max, end);
+            }
+
+            pageList.Sort();
+
+            var pages          = new List<long>(pageList.Count);
+            var protects       = new uint[pageList.Count];
+            var protectedCount = 0;
+            var failed         = -1;
+
+            foreach ( var page in pageList )
+            {
+                if ( pages.Count == 0 || pages[pages.Count - 1] != page )
+                {
+                    pages.Add(page);
+                }
+            }
+
+            var context = RTHandler.AllocateContext();
+
+            try
+            {
+                lock ( Memory.ProtectedMemoryLocker )
+                {
+                    var threads = this.SuspendOutsidePatches(context);
+
+                    try
+                    {
+                        for ( ; protectedCount < pages.Count; protectedCount++ )
+                        {
+                            if ( !VirtualProtect(new IntPtr(pages[protectedCount]), new IntPtr(pageSize), 0x40, out protects[protectedCount]) )
+                            {
+                                failed = protectedCount;
+                                break;
+                            }
+                        }
+
+                        if ( failed < 0 )
+                        {
+                            for ( var i = 0; i < this.Patches.Count; i++ )
+                            {
+                                var p = this.Patches[i];
+                                Marshal.Copy(p.Data, 0, p.Address, p.Data.Length);
+                            }
+
+                            FlushInstructionCache(GetCurrentProcess(), new IntPtr(min), new IntPtr(max - min));
+                        }
+                    }
+                    finally
+                    {
+                        for ( var i = 0; i < protectedCount; i++ )
+                        {
+                            uint old;
+                            VirtualProtect(new IntPtr(pages[i]), new IntPtr(pageSize), protects[i], out old);
+                        }
+
+                        RTHandler.ResumeThreads(threads);
+                        RTHandler.CloseThreads(threads);
+                    }
+                }
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(context);
+            }
+
+            if ( failed >= 0 )
+            {
+                throw new MemoryAccessException(new IntPtr(pages[failed]), (int)pageSize, -1);
+            }
+        }
+
+        /// <summary>
+        ///     Suspends all other threads so that none of them is stopped inside the bytes of a patch. A thread at the first byte
+        ///     of a patch is fine because it will run the new instruction from the start. The thread handles and instruction
+        ///     pointer array are allocated before threads are suspended, nothing is allocated while they are.
+        /// </summary>
+        /// <param name="context">The buffer for reading thread context.</param>
+        /// <returns>The suspended threads, resume and close them when done.</returns>
+        /// <exception cref="System.InvalidOperationException">A thread kept running inside the code that is patched!</exception>
+        private IntPtr[] SuspendOutsidePatches(IntPtr context)
+        {
+            for ( var attempt = 0;; attempt++ )
+            {
+                var threads = RTHandler.OpenThreadsInCurrentProcess();
+                var ips     = new long[threads.Length];
+
+                RTHandler.SuspendThreads(threads);
+                RTHandler.GetInstructionPointers(threads, context, ips);
+
+                var inside = false;
+
+                for ( var i = 0; i < ips.Length && !inside; i++ )
+                {
+                    var ip = ips[i];
+
+                    for ( var j = 0; j < this.Patches.Count; j++ )
+                    {
+                        var p     = this.Patches[j];
+                        var begin = p.Address.ToInt64();
+
+                        if ( ip > begin && ip < begin + p.Data.Length )
+                        {
+                            inside = true;
+                            break;
+                        }
+                    }
+                }
+
+                if ( !inside )
+                {
+                    return threads;
+                }
+
+                RTHandler.ResumeThreads(threads);
+                RTHandler.CloseThreads(threads);
+
+                if ( attempt >= MaxSuspendAttempts )
+                {
+                    throw new InvalidOperationException("A thread kept running inside the code that is patched!");
+                }
+
+                Thread.Sleep(1);
+            }
+        }
+
+        /// <summary>
+        ///     A recorded write.
+        /// </summary>
+        private struct Patch
+        {
+            /// <summary>
+            ///     Initializes a new instance of the <see cref="Patch" /> struct.
+            /// </summary>
+            /// <param name="address">The address.</param>
+            /// <param name="data">The data.</param>
+            internal Patch(IntPtr address, byte[] data)
+            {
+                this.Address = address;
+                this.Data    = data;
+            }
+
+            /// <summary>
+            ///     The address.
+            /// </summary>
+            internal readonly IntPtr Address;
+
+            /// <summary>
+            ///     The data to write.
+            /// </summary>
+            internal readonly byte[] Data;
+        }
+
+    #region Api calls
+
+        [ DllImport("kernel32.dll") ]
+        private static extern bool VirtualProtect(IntPtr lpAddress, IntPtr dwSize, uint flNewProtect, out uint lpflOldProtect);
+
+        [ DllImport("kernel32.dll") ]
+        private static extern bool FlushInstructionCache(IntPtr hProcess, IntPtr lpBaseAddress, IntPtr dwSize);
+
+        [ DllImport("kernel32.dll") ]
+        private static extern IntPtr GetCurrentProcess();
+
+    #endregion
+    }
+}
@@ -0,0 +1,290 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+    using System.Runtime.InteropServices;
+
+    /// <summary>
+    ///     Records native function calls and executes all of them with a single transition to native code. Arguments are
+    ///     written directly to a reusable buffer so recording does not allocate once the buffer has grown large enough.
+    ///     Calls are executed in the order they were added, all calls use the "cdecl" convention which on x64 is also used for
+    ///     "fastcall" and "thiscall".
+    /// </summary>
+    public sealed class InvokeBatch
+    {
+        /// <summary>
+        ///     The count of values in a call record before arguments.
+        /// </summary>
+        private const int HeaderSize = 3;
+
+        /// <summary>
+        ///     The maximum argument count of a call.
+        /// </summary>
+        private const int MaxArguments = 31;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="InvokeBatch" /> class.
+        /// </summary>
+        /// <param name="capacity">The expected count of calls.</param>
+        public InvokeBatch(int capacity = 16)
+        {
+            if ( capacity < 1 )
+            {
+                capacity = 1;
+            }
+
+            if ( !Main.Is64Bit )
+            {
+                throw new NotImplementedException();
+            }
+
+            this._records = new IntPtr[capacity * (HeaderSize + 8)];
+            this._results = new IntPtr[capacity];
+        }
+
+        /// <summary>
+        ///     The recorded calls.
+        /// </summary>
+        private IntPtr[] _records;
+
+        /// <summary>
+        ///     The results of calls.
+        /// </summary>
+        private IntPtr[] _results;
+
+        /// <summary>
+        ///     The used length of records.
+        /// </summary>
+        private int _length;
+
+        /// <summary>
+        ///     The index of current call record in records.
+        /// </summary>
+        private int _current = -1;
+
+        /// <summary>
+        ///     Gets the count of recorded calls.
+        /// </summary>
+        /// <value>
+        ///     The count of recorded calls.
+        /// </value>
+        public int Count { get; private set; }
+
+        /// <summary>
+        ///     Gets the count of calls that have results from the last execute.
+        /// </summary>
+        /// <value>
+        ///     The count of executed calls.
+        /// </value>
+        public int ExecutedCount { get; private set; }
+
+        /// <summary>
+        ///     Gets the raw results of last execute. Use <see cref="GetResultF" /> or <see cref="GetResultD" /> for calls that
+        ///     return a floating point value.
+        /// </summary>
+        /// <value>
+        ///     The results.
+        /// </value>
+        public ReadOnlySpan<IntPtr> Results => new ReadOnlySpan<IntPtr>(this._results, 0, this.ExecutedCount);
+
+        /// <summary>
+        ///     Adds a call to a function. Add arguments with <see cref="Arg(IntPtr)" /> right after.
+        /// </summary>
+        /// <param name="funcAddress">The function address.</param>
+        /// <returns>The index of call for reading its result.</returns>
+        public int Call(IntPtr funcAddress) => this.Begin(funcAddress, 0);
+
+        /// <summary>
+        ///     Adds a call to a function that returns a floating point value.
+        /// </summary>
+        /// <param name="funcAddress">The function address.</param>
+        /// <returns>The index of call for reading its result.</returns>
+        public int CallF(IntPtr funcAddress) => this.Begin(funcAddress, 1);
+
+        /// <summary>
+        ///     Adds a call to a function that returns a double precision floating point value.
+        /// </summary>
+        /// <param name="funcAddress">The function address.</param>
+        /// <returns>The index of call for reading its result.</returns>
+        public int CallD(IntPtr funcAddress) => this.Begin(funcAddress, 2);
+
+        /// <summary>
+        ///     Adds a call to a member function, the object instance is the first argument.
+        /// </summary>
+        /// <param name="thisAddress">The address of object instance.</param>
+        /// <param name="funcAddress">The function address.</param>
+        /// <returns>The index of call for reading its result.</returns>
+        public int ThisCall(IntPtr thisAddress, IntPtr funcAddress)
+        {
+            var index = this.Begin(funcAddress, 0);
+            this.Arg(thisAddress);
+            return index;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the last added call.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This batch.</returns>
+        public InvokeBatch Arg(IntPtr value) => this.AddArgument(0, value);
+
+        /// <summary>
+        ///     Adds an argument to the last added call.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This batch.</returns>
+        public InvokeBatch Arg(long value) => this.AddArgument(0, new IntPtr(value));
+
+        /// <summary>
+        ///     Adds an argument to the last added call.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This batch.</returns>
+        public InvokeBatch Arg(bool value) => this.AddArgument(0, new IntPtr(value ? 1 : 0));
+
+        /// <summary>
+        ///     Adds an argument to the last added call.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This batch.</returns>
+        public InvokeBatch Arg(float value) => this.AddArgument(1, Memory.GetFloatArgument(value));
+
+        /// <summary>
+        ///     Adds an argument to the last added call.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This batch.</returns>
+        public InvokeBatch Arg(double value) => this.AddArgument(2, Memory.GetDoubleArgument(value));
+
+        /// <summary>
+        ///     Executes all recorded calls with a single transition to native code. The recorded calls are kept so the same
+        ///     batch can be executed again, call <see cref="Clear" /> to record new calls.
+        /// </summary>
+        public void Execute()
+        {
+            if ( this.Count == 0 )
+            {
+                this.ExecutedCount = 0;
+                return;
+            }
+
+            this.ExecutedCount = InvokeBatch_Native(this._records, this.Count, this._results);
+        }
+
+        /// <summary>
+        ///     Gets the result of call.
+        /// </summary>
+        /// <param name="index">The index of call.</param>
+        /// <returns></returns>
+        public IntPtr GetResult(int index)
+        {
+            if ( index < 0 || index >= this.ExecutedCount )
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+
+            return this._results[index];
+        }
+
+        /// <summary>
+        ///     Gets the result of call that was added with <see cref="CallF" />.
+        /// </summary>
+        /// <param name="index">The index of call.</param>
+        /// <returns></returns>
+        public float GetResultF(int index) => BitConverter.Int32BitsToSingle(unchecked((int)this.GetResult(index).ToInt64()));
+
+        /// <summary>
+        ///     Gets the result of call that was added with <see cref="CallD" />.
+        /// </summary>
+        /// <param name="index">The index of call.</param>
+        /// <returns></returns>
+        public double GetResultD(int index) => BitConverter.Int64BitsToDouble(this.GetResult(index).ToInt64());
+
+        /// <summary>
+        ///     Removes all recorded calls and results. The buffers are kept for reuse.
+        /// </summary>
+        public void Clear()
+        {
+            this._length       = 0;
+            this._current      = -1;
+            this.Count         = 0;
+            this.ExecutedCount = 0;
+        }
+
+        /// <summary>
+        ///     Begins a new call record.
+        /// </summary>
+        /// <param name="funcAddress">The function address.</param>
+        /// <param name="returnType">The return type.</param>
+        /// <returns></returns>
+        private int Begin(IntPtr funcAddress, int returnType)
+        {
+            if ( funcAddress == IntPtr.Zero )
+            {
+                throw new ArgumentNullException(nameof(funcAddress));
+            }
+
+            this.Reserve(HeaderSize);
+
+            if ( this.Count == this._results.Length )
+            {
+                Array.Resize(ref this._results, this._results.Length * 2);
+            }
+
+            this._current                   = this._length;
+            this._records[this._length]     = funcAddress;
+            this._records[this._length + 1] = new IntPtr(returnType);
+            this._records[this._length + 2] = IntPtr.Zero;
+            this._length                   += HeaderSize;
+
+            return this.Count++;
+        }
+
+        /// <summary>
+        ///     Adds the argument to current call record.
+        /// </summary>
+        /// <param name="type">The argument type.</param>
+        /// <param name="value">The raw value.</param>
+        /// <returns></returns>
+        private InvokeBatch AddArgument(int type, IntPtr value)
+        {
+            if ( this._current < 0 )
+            {
+                throw new InvalidOperationException("Add a call before adding arguments!");
+            }
+
+            var index = this._records[this._current + 2].ToInt32();
+
+            if ( index >= MaxArguments )
+            {
+                throw new ArgumentOutOfRangeException("Invoke argument count can't exceed " + MaxArguments + "!");
+            }
+
+            this.Reserve(2);
+
+            var returnType = this._records[this._current + 1].ToInt32();
+            this._records[this._length]      = Memory.GetArgumentJmpAddress(returnType, index, type);
+            this._records[this._length + 1]  = value;
+            this._records[this._current + 2] = new IntPtr(index + 1);
+            this._length                    += 2;
+
+            return this;
+        }
+
+        /// <summary>
+        ///     Makes sure the records have room for more values.
+        /// </summary>
+        /// <param name="count">The count of values.</param>
+        private void Reserve(int count)
+        {
+            if ( this._length + count <= this._records.Length )
+            {
+                return;
+            }
+
+            Array.Resize(ref this._records, Math.Max(this._records.Length * 2, this._length + count));
+        }
+
+        [ DllImport("NetScriptFramework.Runtime.dll", EntryPoint = "InvokeBatch") ]
+        private static extern int InvokeBatch_Native(IntPtr[] records, int count, IntPtr[] results);
+    }
+}
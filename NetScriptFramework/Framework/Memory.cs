@@ -6,9 +6,12 @@
     using System.Globalization;
     using System.IO;
     using System.Linq;
+    using System.Numerics;
     using System.Reflection;
+    using System.Runtime.CompilerServices;
     using System.Runtime.InteropServices;
     using System.Text;
+    using System.Threading;
 
     using Tools;
     using Tools._Internal;
@@ -345,6 +348,29 @@
 
         private static IntPtr[] _Argument_Jmp_Address;
 
+        /// <summary>
+        ///     Gets the address in invoke code that loads an argument.
+        /// </summary>
+        /// <param name="funcReturnType">The function return value type.</param>
+        /// <param name="index">The index of argument.</param>
+        /// <param name="type">The type of argument.</param>
+        /// <returns></returns>
+        internal static IntPtr GetArgumentJmpAddress(int funcReturnType, int index, int type) => _Argument_Jmp_Address[(funcReturnType * 15) + (Math.Min(4, index) * 3) + type];
+
+        /// <summary>
+        ///     Gets the raw argument value of a single precision floating point argument. The argument code loads the low 32 bits.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns></returns>
+        internal static IntPtr GetFloatArgument(float value) => new IntPtr(unchecked((uint)BitConverter.SingleToInt32Bits(value)));
+
+        /// <summary>
+        ///     Gets the raw argument value of a double precision floating point argument. The argument code loads all 64 bits.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns></returns>
+        internal static IntPtr GetDoubleArgument(double value) => new IntPtr(BitConverter.DoubleToInt64Bits(value));
+
         /// <summary>
         ///     Prepares the arguments for a native function call.
         /// </summary>
@@ -395,21 +421,11 @@
                             break;
 
                         case 1 :
-                        {
-                            var  converted  = BitConverter.GetBytes(a.ValueFloat);
-                            long converted2 = BitConverter.ToUInt32(converted, 0);
-                            result[(i * 2) + 1] = new IntPtr(converted2);
-                        }
-
+                            result[(i * 2) + 1] = GetFloatArgument(a.ValueFloat);
                             break;
 
                         case 2 :
-                        {
-                            var  converted  = BitConverter.GetBytes(a.ValueDouble);
-                            long converted2 = BitConverter.ToUInt32(converted, 0);
-                            result[(i * 2) + 1] = new IntPtr(converted2);
-                        }
-
+                            result[(i * 2) + 1] = GetDoubleArgument(a.ValueDouble);
                             break;
 
                         default : throw new NotImplementedException();
@@ -439,21 +455,11 @@
                             break;
 
                         case 1 :
-                        {
-                            var  converted  = BitConverter.GetBytes(a.ValueFloat);
-                            long converted2 = BitConverter.ToUInt32(converted, 0);
-                            result[(i * 2) + 1] = new IntPtr(converted2);
-                        }
-
+                            result[(i * 2) + 1] = GetFloatArgument(a.ValueFloat);
                             break;
 
                         case 2 :
-                        {
-                            var  converted  = BitConverter.GetBytes(a.ValueDouble);
-                            long converted2 = BitConverter.ToUInt32(converted, 0);
-                            result[(i * 2) + 1] = new IntPtr(converted2);
-                        }
-
+                            result[(i * 2) + 1] = GetDoubleArgument(a.ValueDouble);
                             break;
 
                         default : throw new NotImplementedException();
@@ -511,32 +517,20 @@
                     throw new ArgumentOutOfRangeException("size");
                 }
 
-                if ( _codePageDefault < 0 )
-                    //SYSTEM_INFO si;
-                    //GetSystemInfo(&si);
-                    //_codePageDefault = Math.Max(65536, si.dwAllocationGranularity);
-                {
-                    _codePageDefault = 65536;
-                }
-
-                MemoryAllocation result = null;
-
                 lock ( _codePageLocker )
                 {
-                    for ( var i = 0; i < _codePageList.Count; i++ )
+                    if ( _codePageTargetBegin < 0 )
                     {
-                        result = _codePageList[i].Get(size);
-
-                        if ( result != null )
-                        {
-                            return result;
-                        }
+                        InitializeCodePageTarget();
                     }
 
-                    var allocator = new CodePageAllocator(Math.Max(size, _codePageDefault));
-                    _codePageList.Add(allocator);
+                    var result = AllocateCode(size, _codePageTargetBegin, _codePageTargetEnd, false);
+
+                    if ( result == null )
+                    {
+                        throw new OutOfMemoryException("Failed to allocate memory for code page!");
+                    }
 
-                    result = allocator.Get(size);
                     return result;
                 }
             }
@@ -553,6 +547,51 @@
             }
         }
 
+        /// <summary>
+        ///     Allocates native memory that is valid until the end of current frame. The memory belongs to the calling thread, it
+        ///     is not zeroed and must not be freed or kept after the frame ends. This is much cheaper than <see cref="Allocate" />
+        ///     because nothing is allocated with the C allocator or tracked by the garbage collector, use it for short lived
+        ///     buffers that are passed to native functions. Outside of a <see cref="BeginFrameScope" /> this may only be called
+        ///     on the thread that calls <see cref="AdvanceFrame" />, which is the main thread of the game.
+        /// </summary>
+        /// <param name="size">The size of memory.</param>
+        /// <param name="align">The alignment of memory, must be a power of two. Zero means 16 byte alignment.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentOutOfRangeException">
+        ///     size;Size can't be zero or negative!
+        ///     or
+        ///     align;Alignment must be zero or a power of two!
+        /// </exception>
+        /// <exception cref="System.InvalidOperationException">Frame memory was allocated on another thread outside of a scope!</exception>
+        public static IntPtr AllocateFrame(int size, int align = 0)
+        {
+            if ( size <= 0 )
+            {
+                throw new ArgumentOutOfRangeException("size", "Size can't be zero or negative!");
+            }
+
+            if ( align < 0 || (align & (align - 1)) != 0 )
+            {
+                throw new ArgumentOutOfRangeException("align", "Alignment must be zero or a power of two!");
+            }
+
+            return FrameArena.Allocate(size, align);
+        }
+
+        /// <summary>
+        ///     Ends the current frame. Memory returned by <see cref="AllocateFrame" /> before this call will be reused. The game
+        ///     library calls this after all frame event handlers have run.
+        /// </summary>
+        public static void AdvanceFrame() => FrameArena.Advance();
+
+        /// <summary>
+        ///     Begins a frame memory scope on the current thread. Memory returned by <see cref="AllocateFrame" /> until the
+        ///     scope is disposed stays valid regardless of frames and is reused after it. Threads other than the main thread
+        ///     must use this to allocate frame memory.
+        /// </summary>
+        /// <returns></returns>
+        public static FrameScope BeginFrameScope() => FrameArena.BeginScope();
+
         /// <summary>
         ///     Allocates a structure. Default values will be zero. Use indexer for easy modification.
         /// </summary>
@@ -623,20 +662,216 @@
             lock ( _codePageLocker ) { page.Free(address, size); }
         }
 
+        /// <summary>
+        ///     Allocates executable memory that is reachable with a near jump or call from every address in the specified range.
+        ///     Returns null if no free memory was found within 2 GB of the range.
+        /// </summary>
+        /// <param name="size">The size of allocation.</param>
+        /// <param name="begin">The begin of range that must reach the memory.</param>
+        /// <param name="end">The end of range that must reach the memory.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentOutOfRangeException">size</exception>
+        internal static MemoryAllocation AllocateCodeNear(int size, IntPtr begin, IntPtr end)
+        {
+            if ( size <= 0 || size > 1024 * 1024 )
+            {
+                throw new ArgumentOutOfRangeException("size");
+            }
+
+            lock ( _codePageLocker )
+            {
+                return AllocateCode(size, begin.ToInt64(), end.ToInt64(), true);
+            }
+        }
+
+        /// <summary>
+        ///     Allocates executable memory. Pages near the range are preferred, if the range is empty or there is no free
+        ///     memory near it then the memory can be anywhere unless <paramref name="required" /> is set. Caller must hold the
+        ///     code page lock.
+        /// </summary>
+        /// <param name="size">The size of allocation.</param>
+        /// <param name="begin">The begin of range or zero.</param>
+        /// <param name="end">The end of range or zero.</param>
+        /// <param name="required">If set to <c>true</c> then returns null instead of memory that is not near the range.</param>
+        /// <returns></returns>
+        private static MemoryAllocation AllocateCode(int size, long begin, long end, bool required)
+        {
+            if ( _codePageDefault < 0 )
+                //SYSTEM_INFO si;
+                //GetSystemInfo(&si);
+                //_codePageDefault = Math.Max(65536, si.dwAllocationGranularity);
+            {
+                _codePageDefault = 65536;
+            }
+
+            MemoryAllocation result   = null;
+            var              pageSize = (Math.Max(size, _codePageDefault) + _codePageDefault - 1) / _codePageDefault * _codePageDefault;
+
+            if ( begin != 0 && Main.Is64Bit )
+            {
+                for ( var i = 0; i < _codePageList.Count; i++ )
+                {
+                    if ( _codePageList[i].IsNear(begin, end) && (result = _codePageList[i].Get(size)) != null )
+                    {
+                        return result;
+                    }
+                }
+
+                var near = CreateCodePageNear(pageSize, begin, end);
+
+                if ( near != null )
+                {
+                    _codePageList.Add(near);
+                    return near.Get(size);
+                }
+
+                if ( required )
+                {
+                    return null;
+                }
+
+                // Main module has no free memory near it, don't search again for every allocation.
+                if ( begin == _codePageTargetBegin )
+                {
+                    _codePageTargetBegin = 0;
+                    _codePageTargetEnd   = 0;
+                }
+            }
+
+            for ( var i = 0; i < _codePageList.Count; i++ )
+            {
+                if ( (result = _codePageList[i].Get(size)) != null )
+                {
+                    return result;
+                }
+            }
+
+            var allocator = CodePageAllocator.Create(IntPtr.Zero, pageSize);
+
+            if ( allocator == null )
+            {
+                return null;
+            }
+
+            _codePageList.Add(allocator);
+            return allocator.Get(size);
+        }
+
+        /// <summary>
+        ///     Creates a code page in free memory within near jump distance of the range. Closest free regions after the range
+        ///     are tried first, then before it.
+        /// </summary>
+        /// <param name="size">The size of page, must be a multiple of allocation granularity.</param>
+        /// <param name="begin">The begin of range.</param>
+        /// <param name="end">The end of range.</param>
+        /// <returns></returns>
+        private static CodePageAllocator CreateCodePageNear(int size, long begin, long end)
+        {
+            var granularity = (long)_codePageDefault;
+            var min         = Math.Max(end - CodePageAllocator.NearDistance, granularity);
+            var max         = begin + CodePageAllocator.NearDistance;
+            var mbiSize     = Marshal.SizeOf(typeof(MEMORY_BASIC_INFORMATION));
+
+            // Upward from the end of range.
+            var addr = (end + granularity - 1) / granularity * granularity;
+
+            while ( addr + size <= max )
+            {
+                MEMORY_BASIC_INFORMATION mbi;
+
+                if ( VirtualQuery(new IntPtr(addr), out mbi, mbiSize) == 0 )
+                {
+                    break;
+                }
+
+                var regionEnd = mbi.BaseAddress.ToInt64() + mbi.RegionSize.ToInt64();
+
+                if ( mbi.State == MEM_FREE && regionEnd - addr >= size )
+                {
+                    var page = CodePageAllocator.Create(new IntPtr(addr), size);
+
+                    if ( page != null )
+                    {
+                        return page;
+                    }
+                }
+
+                addr = (regionEnd + granularity - 1) / granularity * granularity;
+            }
+
+            // Downward from the begin of range.
+            addr = (begin - size) / granularity * granularity;
+
+            while ( addr >= min )
+            {
+                MEMORY_BASIC_INFORMATION mbi;
+
+                if ( VirtualQuery(new IntPtr(addr), out mbi, mbiSize) == 0 )
+                {
+                    break;
+                }
+
+                var regionEnd = mbi.BaseAddress.ToInt64() + mbi.RegionSize.ToInt64();
+
+                if ( mbi.State == MEM_FREE && regionEnd - addr >= size )
+                {
+                    var page = CodePageAllocator.Create(new IntPtr(addr), size);
+
+                    if ( page != null )
+                    {
+                        return page;
+                    }
+                }
+
+                addr = (mbi.BaseAddress.ToInt64() - size) / granularity * granularity;
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        ///     Sets the range of main targeted module, code pages are placed near it so hooks in module can reach them with a
+        ///     near jump.
+        /// </summary>
+        private static void InitializeCodePageTarget()
+        {
+            _codePageTargetBegin = 0;
+            _codePageTargetEnd   = 0;
+
+            try
+            {
+                var module = Main.GetMainTargetedModule();
+
+                if ( module != null )
+                {
+                    _codePageTargetBegin = module.BaseAddress.ToInt64();
+                    _codePageTargetEnd   = _codePageTargetBegin + module.ModuleMemorySize;
+                }
+            }
+            catch ( FileNotFoundException ) { }
+        }
+
         [ DllImport("NetScriptFramework.Runtime.dll") ]
         internal static extern IntPtr AllocateC(int size, int align);
 
         [ DllImport("NetScriptFramework.Runtime.dll") ]
         internal static extern void FreeC(IntPtr buf, bool align);
 
-        private static readonly object                  _codePageLocker  = new object();
-        private static readonly List<CodePageAllocator> _codePageList    = new List<CodePageAllocator>();
-        private static          int                     _codePageDefault = -1;
+        private static readonly object                  _codePageLocker      = new object();
+        private static readonly List<CodePageAllocator> _codePageList        = new List<CodePageAllocator>();
+        private static          int                     _codePageDefault     = -1;
+        private static          long                    _codePageTargetBegin = -1;
+        private static          long                    _codePageTargetEnd;
 
     #endregion
 
     #region Query
 
+        /// <summary>
+        ///     The state of memory region that is not allocated or reserved.
+        /// </summary>
+        private const uint MEM_FREE = 0x10000;
+
         [ DllImport("kernel32.dll") ] private static extern int VirtualQuery(IntPtr lpAddress, out MEMORY_BASIC_INFORMATION lpBuffer, int dwLength);
 
         [ StructLayout(LayoutKind.Sequential) ]
@@ -707,6 +942,24 @@
             return true;
         }
 
+        /// <summary>
+        ///     Gets the base address of the allocation that contains the address. For an address in a loaded module this is the
+        ///     base address of module. Returns zero if the address is not allocated.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <returns></returns>
+        internal static IntPtr GetAllocationBase(IntPtr address)
+        {
+            MEMORY_BASIC_INFORMATION result;
+
+            if ( VirtualQuery(address, out result, Marshal.SizeOf(typeof(MEMORY_BASIC_INFORMATION))) == 0 )
+            {
+                return IntPtr.Zero;
+            }
+
+            return result.AllocationBase;
+        }
+
         /// <summary>
         ///     Determines whether the region is valid by its protection flags.
         /// </summary>
@@ -1284,6 +1537,122 @@
             return result;
         }
 
+        /// <summary>
+        ///     Reads bytes from specified memory address to the destination. The length of destination is the amount of bytes
+        ///     to read.
+        /// </summary>
+        /// <param name="address">The address to read from.</param>
+        /// <param name="destination">The destination.</param>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        public static void ReadBytes(IntPtr address, Span<byte> destination)
+        {
+            if ( destination.Length == 0 )
+            {
+                return;
+            }
+
+            if ( MemoryCopy(address, 0, ref MemoryMarshal.GetReference(destination), 0, destination.Length) != destination.Length )
+            {
+                throw new MemoryAccessException(address, destination.Length, false);
+            }
+        }
+
+        /// <summary>
+        ///     Reads bytes from specified memory address into a buffer owned by the current thread. The returned span is only
+        ///     valid until the next call of this method on the same thread, copy it if it must be kept. Reads longer than
+        ///     <see cref="ReadBufferMaxLength" /> bytes use a new array so the buffer of the thread stays small.
+        /// </summary>
+        /// <param name="address">The address to read from.</param>
+        /// <param name="length">Amount of bytes to read.</param>
+        /// <returns></returns>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        public static ReadOnlySpan<byte> ReadBytesSpan(IntPtr address, int length)
+        {
+            if ( length < 0 )
+            {
+                throw new ArgumentOutOfRangeException("length");
+            }
+
+            if ( length > ReadBufferMaxLength )
+            {
+                var large = new byte[length];
+                ReadBytes(address, large.AsSpan());
+                return large;
+            }
+
+            var buffer = _readBuffer;
+
+            if ( buffer == null || buffer.Length < length )
+            {
+                buffer      = new byte[Math.Max(256, length)];
+                _readBuffer = buffer;
+            }
+
+            var span = new Span<byte>(buffer, 0, length);
+            ReadBytes(address, span);
+            return span;
+        }
+
+        /// <summary>
+        ///     Reads many memory blocks with a single native call. The data of each entry is written to destination right after
+        ///     the previous entry. If an entry can't be read its bytes are set to zero and its value in failed is set to 1
+        ///     instead of throwing an exception.
+        /// </summary>
+        /// <param name="entries">The entries to read.</param>
+        /// <param name="destination">The destination, must be at least the total size of all entries.</param>
+        /// <param name="failed">Set to 1 for each entry that failed to read and 0 otherwise. Must be at least the count of entries.</param>
+        /// <returns>The count of entries that failed to read.</returns>
+        public static int ReadGather(ReadOnlySpan<MemoryGatherEntry> entries, Span<byte> destination, Span<byte> failed)
+        {
+            if ( entries.Length == 0 )
+            {
+                return 0;
+            }
+
+            if ( failed.Length < entries.Length )
+            {
+                throw new ArgumentOutOfRangeException(nameof(failed));
+            }
+
+            long total = 0;
+
+            for ( var i = 0; i < entries.Length; i++ )
+            {
+                var size = entries[i].Size.ToInt64();
+
+                if ( size < 0 )
+                {
+                    throw new ArgumentOutOfRangeException(nameof(entries));
+                }
+
+                total += size;
+            }
+
+            if ( total > destination.Length )
+            {
+                throw new ArgumentOutOfRangeException(nameof(destination));
+            }
+
+            // Native side writes to destination so it must have at least one byte even if all entries are empty.
+            if ( destination.Length == 0 )
+            {
+                destination = new byte[1];
+            }
+
+            return MemoryGather(ref MemoryMarshal.GetReference(entries), entries.Length, ref MemoryMarshal.GetReference(destination), ref MemoryMarshal.GetReference(failed));
+        }
+
+        /// <summary>
+        ///     The buffer of current thread for reading bytes into a span.
+        /// </summary>
+        [ ThreadStatic ]
+        private static byte[] _readBuffer;
+
+        /// <summary>
+        ///     The largest read in bytes that <see cref="ReadBytesSpan" /> keeps a buffer for.
+        /// </summary>
+        public const int ReadBufferMaxLength = 64 * 1024;
+
         /// <summary>
         ///     Verifies the bytes at address. If the bytes match then returns true. Use ? or * or . symbol for wildcard. Either
         ///     space or dash is allowed to be separator for bytes.
@@ -1318,182 +1687,27 @@
                 return true;
             }
 
-            var parsed = new List<byte?>(32);
-
-            {
-                byte cur_val = 0;
-                var  cur_i   = 0;
-                var  cur_w   = false;
-
-                var index = 0;
-                var len   = hex.Length;
-
-                while ( index < len )
-                {
-                    var c = hex[index];
+            return BytePattern.Get(hex).Verify(address, protect);
+        }
 
-                    switch ( c )
-                    {
-                        case ' ' :
-                        case '-' :
-                        {
-                            if ( cur_i > 0 )
-                            {
-                                if ( cur_w )
-                                {
-                                    parsed.Add(null);
-                                }
-                                else
-                                {
-                                    parsed.Add(cur_val);
-                                }
-
-                                cur_i   = 0;
-                                cur_val = 0;
-                                cur_w   = false;
-                            }
-
-                            index++;
-                            continue;
-                        }
-
-                        case '*' :
-                        case '?' :
-                        case '.' :
-                        {
-                            if ( cur_i > 0 )
-                            {
-                                if ( cur_w && cur_i == 1 ) // ?[?]
-                                {
-                                    cur_i++;
-                                }
-                                else if ( cur_w && cur_i == 2 ) // ??[?]
-                                {
-                                    parsed.Add(null);
-                                    cur_i = 1;
-                                }
-                                else if ( !cur_w ) // n[?]
-                                {
-                                    parsed.Add(cur_val);
-                                    cur_w   = true;
-                                    cur_i   = 1;
-                                    cur_val = 0;
-                                }
-                            }
-                            else
-                            {
-                                cur_i = 1;
-                                cur_w = true;
-                            }
-
-                            index++;
-                            continue;
-                        }
-
-                        case '0' :
-                        case '1' :
-                        case '2' :
-                        case '3' :
-                        case '4' :
-                        case '5' :
-                        case '6' :
-                        case '7' :
-                        case '8' :
-                        case '9' :
-                        case 'a' :
-                        case 'b' :
-                        case 'c' :
-                        case 'd' :
-                        case 'e' :
-                        case 'f' :
-                        case 'A' :
-                        case 'B' :
-                        case 'C' :
-                        case 'D' :
-                        case 'E' :
-                        case 'F' :
-                        {
-                            byte val = 0;
-
-                            if ( c >= '0' && c <= '9' )
-                            {
-                                val = (byte)(c - '0');
-                            }
-                            else if ( c >= 'a' && c <= 'f' )
-                            {
-                                val = (byte)((c - 'a') + 10);
-                            }
-                            else if ( c >= 'A' && c <= 'F' )
-                            {
-                                val = (byte)((c - 'A') + 10);
-                            }
-
-                            if ( cur_i > 0 )
-                            {
-                                if ( cur_w )
-                                {
-                                    parsed.Add(null);
-                                    cur_i   = 1;
-                                    cur_w   = false;
-                                    cur_val = val;
-                                }
-                                else
-                                {
-                                    cur_val <<= 4;
-                                    cur_val |=  val;
-                                    parsed.Add(cur_val);
-
-                                    cur_val = 0;
-                                    cur_i   = 0;
-                                }
-                            }
-                            else
-                            {
-                                cur_i   = 1;
-                                cur_val = val;
-                            }
-
-                            index++;
-                            continue;
-                        }
-
-                        default : throw new FormatException("Unknown symbol in hex string: '" + c + "'!");
-                    }
-                }
-
-                if ( cur_i > 0 )
-                {
-                    if ( cur_w )
-                    {
-                        parsed.Add(null);
-                    }
-                    else
-                    {
-                        parsed.Add(cur_val);
-                    }
-                }
-            }
-
-            var bytes = ReadBytes(address, parsed.Count, protect);
-
-            for ( var i = 0; i < bytes.Length; i++ )
+        /// <summary>
+        ///     Verifies the bytes at address. If the bytes match then returns true.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <param name="pattern">The compiled pattern.</param>
+        /// <param name="protect">
+        ///     If set to <c>true</c> then change protection flags of memory page before reading and return after.
+        ///     Only set this true if you are sure you don't have read permissions!
+        /// </param>
+        /// <returns></returns>
+        public static bool VerifyBytes(IntPtr address, BytePattern pattern, bool protect = false)
+        {
+            if ( pattern == null )
             {
-                var comp = parsed[i];
-
-                if ( !comp.HasValue )
-                {
-                    continue;
-                }
-
-                var val = bytes[i];
-
-                if ( comp.Value != val )
-                {
-                    return false;
-                }
+                throw new ArgumentNullException(nameof(pattern));
             }
 
-            return true;
+            return pattern.Verify(address, protect);
         }
 
         /// <summary>
@@ -1963,7 +2177,8 @@
         }
 
         /// <summary>
-        ///     Finds a code cave on the specific memory page.
+        ///     Finds a code cave on the specific memory page. This only looks, the cave may still be used later by hooks. Use
+        ///     <see cref="ReserveCodeCave" /> to get a cave for writing code.
         /// </summary>
         /// <param name="page">The page. This does not have to be the base address of the page, it can be anywhere in it.</param>
         /// <param name="size">The size of code cave. Expect this to be less than 15 bytes.</param>
@@ -2028,6 +2243,33 @@
             return false;
         }
 
+        /// <summary>
+        ///     Reserves a code cave near the address so that it is not returned again by this method or used by hooks. If the
+        ///     address is in an executable section of a module then the smallest free cave of that section is reserved. Other
+        ///     memory is searched the same way as <see cref="FindCodeCave" /> and the cave can't be reserved there.
+        /// </summary>
+        /// <param name="address">The address that the cave must be near to.</param>
+        /// <param name="size">The size of code cave.</param>
+        /// <param name="result">The result.</param>
+        /// <returns></returns>
+        public static bool ReserveCodeCave(IntPtr address, int size, ref IntPtr result)
+        {
+            if ( size <= 0 || !CodeCaveIndex.IsIndexed(address) )
+            {
+                return FindCodeCave(address, size, ref result);
+            }
+
+            var cave = CodeCaveIndex.Reserve(address, size);
+
+            if ( cave == IntPtr.Zero )
+            {
+                return false;
+            }
+
+            result = cave;
+            return true;
+        }
+
         /// <summary>
         ///     Finds all code caves in the specified memory page.
         /// </summary>
@@ -2219,9 +2461,9 @@
             {
                 var cave = IntPtr.Zero;
 
-                if ( !FindCodeCave(address, jmpAway.Length, ref cave) )
+                if ( !ReserveCodeCave(address, jmpAway.Length, ref cave) )
                 {
-                    throw new ArgumentException("The replaced code would require a code cave but didn't find an available code cave of length " + jmpAway.Length + " in the code page!");
+                    throw new ArgumentException("The replaced code would require a code cave but didn't find an available code cave of length " + jmpAway.Length + " near the address!");
                 }
 
                 WriteBytes(cave, jmpAway, true);
@@ -2535,6 +2777,15 @@
                 return;
             }
 
+            // Protected writes of a hook transaction are applied together when it is committed.
+            var transaction = HookTransaction.Current;
+
+            if ( transaction != null && intl == 0 )
+            {
+                transaction.AddPatch(address, buffer, index, length);
+                return;
+            }
+
             lock ( ProtectedMemoryLocker )
             {
                 uint oldProtect = 0;
@@ -2641,7 +2892,7 @@
         ///     The protected memory locker. This is used to make sure memory protection flags are returned correctly if reading or
         ///     writing from multiple threads.
         /// </summary>
-        private static readonly object ProtectedMemoryLocker = new object();
+        internal static readonly object ProtectedMemoryLocker = new object();
 
         [ DllImport("kernel32.dll") ] private static extern bool VirtualProtect(IntPtr lpAddress, uint dwSize, uint flNewProtect, out uint lpflOldProtect);
 
@@ -2651,6 +2902,12 @@
         [ DllImport("NetScriptFramework.Runtime.dll") ]
         private static extern int MemoryCopy(byte[] source, int sourceIndex, IntPtr destination, int destinationIndex, int length);
 
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern int MemoryCopy(IntPtr source, int sourceIndex, ref byte destination, int destinationIndex, int length);
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern int MemoryGather(ref MemoryGatherEntry entries, int count, ref byte destination, ref byte failed);
+
         [ DllImport("NetScriptFramework.Runtime.dll") ]
         private static extern int MemoryReadInterlocked32(IntPtr address, byte[] result);
 
@@ -2823,7 +3080,64 @@
         /// </exception>
         /// <exception cref="System.ArgumentOutOfRangeException">parameters.IncludeLength;Include length can't be a negative value!</exception>
         /// <exception cref="System.NotImplementedException"></exception>
-        public static void WriteHook(HookParameters parameters)
+        [ MethodImpl(MethodImplOptions.NoInlining) ]
+        public static void WriteHook(HookParameters parameters) => WriteHook(parameters, Assembly.GetCallingAssembly(), true);
+
+        /// <summary>
+        ///     Builds and registers a hook without writing the jump at its address, the original code keeps running until the
+        ///     hook is activated with <see cref="SetHookActive" />. The address is still reserved so overlapping hooks fail the
+        ///     same way as with <see cref="WriteHook(HookParameters)" />.
+        /// </summary>
+        /// <param name="parameters">The parameters.</param>
+        /// <returns>The registered hook.</returns>
+        internal static HookInfo PrepareHook(HookParameters parameters) => WriteHook(parameters, typeof(Memory).Assembly, false);
+
+        /// <summary>
+        ///     Writes the jump of a prepared hook or restores the original code at its address. Other threads are suspended while
+        ///     the code is written and no thread is left inside the replaced bytes, if a hook transaction is active on current
+        ///     thread then the write is recorded in it instead and the hook changes state when that transaction is committed.
+        /// </summary>
+        /// <param name="hook">The hook.</param>
+        /// <param name="active">Write the hook jump if set to <c>true</c>; otherwise, restore the original code.</param>
+        internal static void SetHookActive(HookInfo hook, bool active)
+        {
+            lock ( hook )
+            {
+                var current = HookTransaction.Current;
+
+                if ( current != null )
+                {
+                    if ( current.IsActive(hook) != active )
+                    {
+                        WriteBytes(hook.Address, active ? hook.HookCode : hook.OriginalCode, true);
+                        current.SetActive(hook, active);
+                    }
+
+                    return;
+                }
+
+                if ( hook.IsActive == active )
+                {
+                    return;
+                }
+
+                using ( var transaction = new HookTransaction() )
+                {
+                    WriteBytes(hook.Address, active ? hook.HookCode : hook.OriginalCode, true);
+                    transaction.SetActive(hook, active);
+                    transaction.Commit();
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Builds and registers a hook.
+        /// </summary>
+        /// <param name="parameters">The parameters.</param>
+        /// <param name="assembly">The assembly that requested the hook.</param>
+        /// <param name="active">Write the jump at hook address now or not.</param>
+        /// <returns>The registered hook.</returns>
+        private static HookInfo WriteHook(HookParameters parameters, Assembly assembly, bool active)
         {
             if ( parameters == null )
             {
@@ -2901,8 +3215,7 @@
                 throw new ArgumentOutOfRangeException("parameters.IncludeLength", "Include length can't be a negative value!");
             }
 
-            var assembly = Assembly.GetCallingAssembly();
-            var plugin   = PluginManager.GetPlugins().FirstOrDefault(q => q.Assembly == assembly);
+            var plugin = PluginManager.GetPlugins().FirstOrDefault(q => q.Assembly == assembly);
 
             var info = new HookInfo
             {
@@ -2912,9 +3225,11 @@
                 Plugin    = plugin,
                 Before    = parameters.Before,
                 After     = parameters.After,
+                Handler   = handler,
                 IsFarJump = isLongHook,
                 Include   = include1,
-                Include2  = include2
+                Include2  = include2,
+                Slot      = Interlocked.Increment(ref LastHookSlot)
             };
 
             HookInfo conflict = null;
@@ -2935,8 +3250,17 @@
                 );
             }
 
-            HookRealMap[info.Address.ToInt64()]                     = info;
-            HookMap[info.Address.ToInt64() + (isLongHook ? 13 : 5)] = info;
+            HookRealMap[info.Address.ToInt64()] = info;
+            HookDispatch                        = HookDispatch.Add(info.Address.ToInt64() + (isLongHook ? 13 : 5), info);
+
+            lock ( HookList )
+            {
+                HookList.Add(info);
+            }
+
+            HookTransaction.Current?.AddHook(info);
+
+            StartHookStatistics();
 
             byte[] source = null;
 
@@ -2952,21 +3276,107 @@
                 throw new InvalidOperationException();
             }
 
-            WriteBytes(parameters.Address, source, true);
+            // The rest of replaced code is filled with nops.
+            var code = new byte[parameters.ReplaceLength];
+            Buffer.BlockCopy(source, 0, code, 0, source.Length);
+
+            for ( var i = source.Length; i < code.Length; i++ )
+            {
+                code[i] = 0x90;
+            }
+
+            info.HookCode     = code;
+            info.OriginalCode = ReadBytes(parameters.Address, parameters.ReplaceLength);
+
+            if ( active )
+            {
+                WriteBytes(parameters.Address, code, true);
+
+                if ( HookTransaction.Current != null )
+                {
+                    HookTransaction.Current.SetActive(info, true);
+                }
+                else
+                {
+                    info.IsActive = true;
+                }
+            }
+
+            return info;
+        }
 
-            if ( parameters.ReplaceLength <= requiredLength )
+        /// <summary>
+        ///     Writes a performance monitor hook. The monitored function is timed in native code and never enters .NET.
+        /// </summary>
+        /// <param name="address">The address of function.</param>
+        /// <param name="replaceLength">Length of the replaced code, this must end on an instruction boundary.</param>
+        /// <param name="pattern">The expected byte pattern at address or null.</param>
+        /// <param name="slot">The slot of function in native performance monitor.</param>
+        /// <param name="assembly">The assembly that requested the hook.</param>
+        /// <exception cref="System.InvalidOperationException">Unable to place performance hook because another hook would overlap.</exception>
+        /// <exception cref="System.ArgumentException">Replace length is too short for the jump.</exception>
+        internal static void WritePerformanceHook(IntPtr address, int replaceLength, string pattern, int slot, Assembly assembly)
+        {
+            if ( Main._is_initializing_plugin != 2 )
+            {
+                throw new InvalidOperationException("Writing code hooks is only allowed during plugin initialization!");
+            }
+
+            if ( !Main.Is64Bit )
+            {
+                throw new NotImplementedException();
+            }
+
+            var isLongHook     = replaceLength >= 13;
+            var requiredLength = isLongHook ? 13 : 5;
+
+            if ( replaceLength < requiredLength )
+            {
+                throw new ArgumentException("replaceLength", "Replace length must be at least " + requiredLength + " bytes!");
+            }
+
+            var info = new HookInfo
+            {
+                Address   = address,
+                Length    = replaceLength,
+                Assembly  = assembly,
+                Plugin    = PluginManager.GetPlugins().FirstOrDefault(q => q.Assembly == assembly),
+                IsFarJump = isLongHook
+            };
+
+            HookInfo conflict = null;
+
+            if ( (conflict = AddHookIfNoOverlap(info, address, replaceLength, pattern)) != null )
+            {
+                var placedBy = (conflict.Plugin   != null ? conflict.Plugin.GetInternalString() :
+                                conflict.Assembly != null ? conflict.Assembly.GetName().FullName : "(null)") ??
+                               string.Empty;
+
+                throw new InvalidOperationException(
+                    "Unable to place performance hook at address 0x" + Convert(address).ToString("X") + " because there is another hook already in place that would overlap! Previous hook was placed by " + placedBy
+                );
+            }
+
+            HookTransaction.Current?.AddHook(info);
+
+            var target = HookPerformance.Instance.BuildMonitor(address, replaceLength, slot, isLongHook);
+            var source = isLongHook ? GetHookBytesSource64_Far(address, target) : GetHookBytesSource64_Near(address, target);
+
+            WriteBytes(address, source, true);
+
+            if ( replaceLength <= requiredLength )
             {
                 return;
             }
 
-            var nops = new byte[parameters.ReplaceLength - requiredLength];
+            var nops = new byte[replaceLength - requiredLength];
 
             for ( var i = 0; i < nops.Length; i++ )
             {
                 nops[i] = 0x90;
             }
 
-            WriteBytes(parameters.Address + requiredLength, nops, true);
+            WriteBytes(address + requiredLength, nops, true);
         }
 
         /// <summary>
@@ -3073,6 +3483,163 @@
             }
         }
 
+        /// <summary>
+        ///     Gets how much memory is used by hook execution contexts. Contexts are reserved per thread but only committed as
+        ///     the hook recursion depth of that thread grows.
+        /// </summary>
+        /// <param name="committed">The committed context memory of current thread in bytes.</param>
+        /// <param name="reserved">The reserved context memory of current thread in bytes.</param>
+        /// <param name="highWater">
+        ///     The deepest hook recursion reached on current thread. This is only tracked if Debug.Hook.TrackDepth
+        ///     is enabled in the framework configuration, otherwise it's zero.
+        /// </param>
+        /// <param name="totalCommitted">The committed context memory of all threads in bytes.</param>
+        /// <param name="totalReserved">The reserved context memory of all threads in bytes.</param>
+        public static void GetHookContextMemory(out long committed, out long reserved, out int highWater, out long totalCommitted, out long totalReserved)
+        {
+            GetHookContextMemory_Native(out committed, out reserved, out var depth, out totalCommitted, out totalReserved);
+            highWater = (int)depth;
+        }
+
+        [ DllImport("NetScriptFramework.Runtime.dll", EntryPoint = "GetHookContextMemory") ]
+        private static extern void GetHookContextMemory_Native(out long committed, out long reserved, out long highWater, out long totalCommitted, out long totalReserved);
+
+        /// <summary>
+        ///     Gets the call count and managed handler time of every hook written with
+        ///     <see cref="WriteHook(HookParameters)" />. Times are only recorded if Debug.Hook.Statistics is enabled in the
+        ///     framework configuration, otherwise everything is zero.
+        /// </summary>
+        /// <returns></returns>
+        public static List<HookStatistics> GetHookStatistics()
+        {
+            var result = new List<HookStatistics>();
+            var values = new long[HookStatistics.BucketCount + 3];
+            var max    = GetHookStatisticsMaxHooks();
+
+            HookInfo[] hooks;
+
+            lock ( HookList )
+            {
+                hooks = HookList.ToArray();
+            }
+
+            foreach ( var hook in hooks )
+            {
+                if ( hook.Slot >= max || GetHookStatistics(hook.Slot, values, values.Length) == 0 )
+                {
+                    Array.Clear(values, 0, values.Length);
+                }
+
+                var histogram = new long[HookStatistics.BucketCount];
+                Array.Copy(values, 3, histogram, 0, histogram.Length);
+
+                result.Add(new HookStatistics(hook, values[0], values[1], values[2], histogram));
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        ///     Starts recording hook statistics and the thread that writes them to file if enabled in configuration.
+        /// </summary>
+        private static void StartHookStatistics()
+        {
+            if ( _hookStatisticsThread != null )
+            {
+                return;
+            }
+
+            var vl       = Main.Config?.GetValue(Main._Config_Debug_Hook_Statistics);
+            var interval = 0;
+
+            if ( vl == null || !vl.TryToInt32(out interval) || interval <= 0 )
+            {
+                return;
+            }
+
+            SetHookStatisticsEnabled(true);
+
+            var path = Path.Combine(Main.Config.Path, "HookStatistics.txt");
+
+            _hookStatisticsThread = new Thread(() =>
+            {
+                while ( !Main.IsShutdown )
+                {
+                    Thread.Sleep(interval * 1000);
+
+                    try
+                    {
+                        WriteHookStatistics(path);
+                    }
+                    catch ( IOException ) { }
+                }
+            })
+            {
+                IsBackground = true,
+                Name         = "NetScriptFramework.HookStatistics"
+            };
+
+            _hookStatisticsThread.Start();
+        }
+
+        /// <summary>
+        ///     Writes the statistics of all hooks to a text file, slowest hooks first.
+        /// </summary>
+        /// <param name="filePath">The file path.</param>
+        public static void WriteHookStatistics(string filePath)
+        {
+            var bld = new StringBuilder();
+            bld.AppendLine("Hook statistics at " + DateTime.Now.ToString("yyyy-MM-dd HH:mm:ss") + ". Times are in milliseconds.");
+            bld.AppendLine();
+
+            foreach ( var stat in GetHookStatistics().OrderByDescending(q => q.TotalTicks) )
+            {
+                bld.Append(stat.Address.ToHexString());
+
+                if ( stat.FunctionId != 0 )
+                {
+                    bld.Append(" (" + stat.FunctionId + "+" + stat.FunctionOffset.ToString("X") + ")");
+                }
+
+                bld.Append(" " + (stat.Plugin != null ? stat.Plugin.GetInternalString() : stat.Assembly?.GetName().Name ?? "(null)"));
+                bld.AppendLine();
+                bld.AppendLine(string.Format(CultureInfo.InvariantCulture, "  calls {0}, total {1:0.000}, average {2:0.0000}, max {3:0.000}", stat.Calls, stat.TotalMilliseconds, stat.AverageMilliseconds, stat.MaxMilliseconds));
+
+                if ( stat.Calls == 0 )
+                {
+                    continue;
+                }
+
+                bld.Append("  histogram");
+
+                for ( var i = 0; i < stat.Histogram.Length; i++ )
+                {
+                    if ( stat.Histogram[i] != 0 )
+                    {
+                        bld.Append(string.Format(CultureInfo.InvariantCulture, " <{0:0.####}ms:{1}", HookStatistics.GetBucketUpperMilliseconds(i), stat.Histogram[i]));
+                    }
+                }
+
+                bld.AppendLine();
+            }
+
+            File.WriteAllText(filePath, bld.ToString());
+        }
+
+        /// <summary>
+        ///     The thread that writes hook statistics to file.
+        /// </summary>
+        private static Thread _hookStatisticsThread;
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern void SetHookStatisticsEnabled([ MarshalAs(UnmanagedType.I1) ] bool enabled);
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern int GetHookStatisticsMaxHooks();
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern int GetHookStatistics(int slot, long[] values, int count);
+
         [ DllImport("NetScriptFramework.Runtime.dll") ]
         private static extern IntPtr GetDoActionAddress();
 
@@ -3124,8 +3691,36 @@
         }
 
         internal static         IntPtr                     _unmanagedDoAction = IntPtr.Zero;
-        private static readonly Dictionary<long, HookInfo> HookMap            = new Dictionary<long, HookInfo>();
         private static readonly Dictionary<long, HookInfo> HookRealMap        = new Dictionary<long, HookInfo>();
+        private static readonly List<HookInfo>             HookList           = new List<HookInfo>();
+
+        /// <summary>
+        ///     The last statistics slot given to a hook. Slots are never reused, even if the hook is removed again, so that
+        ///     two live hooks can not share statistics.
+        /// </summary>
+        private static int LastHookSlot = -1;
+
+        /// <summary>
+        ///     The hooks by the address that hook call returns to. This is replaced, never modified, so hook calls on other threads can read it without locking.
+        /// </summary>
+        private static volatile HookDispatchTable HookDispatch = HookDispatchTable.Empty;
+
+        /// <summary>
+        ///     The reusable CPU register wrappers of current thread by hook call depth.
+        /// </summary>
+        [ ThreadStatic ]
+        private static CPURegisters[] _cpuPool;
+
+        /// <summary>
+        ///     The depth of managed hook calls on current thread.
+        /// </summary>
+        [ ThreadStatic ]
+        private static int _cpuPoolDepth;
+
+        /// <summary>
+        ///     The cached size of hook context.
+        /// </summary>
+        private static int _hookContextSize;
 
         private static readonly List<Tuple<ulong, ulong, HookInfo>> HookOverlapList = new List<Tuple<ulong, ulong, HookInfo>>();
 
@@ -3187,16 +3782,64 @@
             return null;
         }
 
+        /// <summary>
+        ///     Removes hooks that were registered but never written because their transaction was rolled back. The trampoline
+        ///     code allocated for these hooks and the code caves reserved for their near jumps are not released, they stay
+        ///     allocated until the process exits.
+        /// </summary>
+        /// <param name="hooks">The hooks.</param>
+        internal static void RemoveHooks(ICollection<HookInfo> hooks)
+        {
+            if ( hooks.Count == 0 )
+            {
+                return;
+            }
+
+            HookOverlapList.RemoveAll(q => hooks.Contains(q.Item3));
+
+            foreach ( var h in hooks )
+            {
+                HookInfo real;
+
+                if ( HookRealMap.TryGetValue(h.Address.ToInt64(), out real) && real == h )
+                {
+                    HookRealMap.Remove(h.Address.ToInt64());
+                }
+            }
+
+            var dispatch = HookDispatchTable.Empty;
+
+            lock ( HookList )
+            {
+                HookList.RemoveAll(q => hooks.Contains(q));
+
+                for ( var i = 0; i < HookList.Count; i++ )
+                {
+                    var h = HookList[i];
+                    dispatch = dispatch.Add(h.Address.ToInt64() + (h.IsFarJump ? 13 : 5), h);
+                }
+            }
+
+            HookDispatch = dispatch;
+        }
+
+        /// <summary>
+        ///     Gets the hook.
+        /// </summary>
+        /// <param name="addr">The addr.</param>
+        /// <returns></returns>
+        private static HookInfo GetHook(IntPtr addr) => HookDispatch.Find(addr.ToInt64());
+
         /// <summary>
         ///     Gets the hook.
         /// </summary>
         /// <param name="addr">The addr.</param>
         /// <returns></returns>
-        private static HookInfo GetHook(IntPtr addr)
+        private static HookInfo GetHookReal(IntPtr addr)
         {
             HookInfo result = null;
 
-            if ( HookMap.TryGetValue(addr.ToInt64(), out result) )
+            if ( HookRealMap.TryGetValue(addr.ToInt64(), out result) )
             {
                 return result;
             }
@@ -3205,143 +3848,428 @@
         }
 
         /// <summary>
-        ///     Gets the hook.
+        ///     Invoke previously registered action. This is called from unmanaged code.
         /// </summary>
-        /// <param name="addr">The addr.</param>
+        /// <param name="cpu_address">The address to CPU register info.</param>
+        /// <param name="pass">The pass.</param>
+        /// <returns>The statistics slot of hook or -1 if the hook was not found.</returns>
+        /// <exception cref="System.InvalidOperationException">Trying to invoke missing action (actionId)!</exception>
+        internal static int DoAction(IntPtr cpu_address, int pass)
+        {
+            var slot = -1;
+
+            try
+            {
+                /*if (Main.IsShutdown)
+                    return;*/
+
+                // Read the hook info.
+                var sz = _hookContextSize;
+
+                if ( sz == 0 )
+                {
+                    sz               = GetHookContextSize();
+                    _hookContextSize = sz;
+                }
+
+                // The hooked address. This is not the actual address yet!
+                var hookAddr = ReadPointer((cpu_address + sz) - (IntPtr.Size * 6));
+
+                // Get action.
+                var hook = GetHook(hookAddr);
+
+                if ( hook == null )
+                {
+                    throw new InvalidOperationException("Trying to invoke missing hook (0x" + hookAddr.ToInt64().ToString("X") + ")!");
+                }
+
+                // Get CPU register info, the handler type was decided when the hook was installed.
+                var cpu = RentCPURegisters(cpu_address, hook.Handler);
+                slot = hook.Slot;
+
+                try
+                {
+                    // Fix some things according to hook.
+                    cpu.IP        = hook.Address + hook.Length;
+                    cpu.Include   = pass == 0 ? hook.Include : hook.Include2;
+                    cpu.Hook      = hook.Address;
+                    cpu.AllowSkip = pass == 0;
+
+                    // Perform action.
+                    var ac = pass == 0 ? hook.Before : hook.After;
+
+                    if ( ac != null )
+                    {
+                        ac(cpu);
+                    }
+                }
+                finally
+                {
+                    _cpuPoolDepth--;
+                }
+            }
+            catch ( Exception ex )
+            {
+                // We can't rely on AppDomain.CurrentDomain.UnhandledException event here because if it happens in main thread the native exception handler is invoked before managed.
+                Main.ProcessManagedUnhandledException(ex);
+            }
+
+            return slot;
+        }
+
+        /// <summary>
+        ///     Gets a CPU register wrapper for the hook call that is starting on current thread. The wrapper is reused by later
+        ///     hook calls at the same depth so it must be returned by decrementing the depth once the hook call is done.
+        /// </summary>
+        /// <param name="cpu_address">The address to CPU register info.</param>
+        /// <param name="handler">The handler of hook.</param>
         /// <returns></returns>
-        private static HookInfo GetHookReal(IntPtr addr)
+        private static CPURegisters RentCPURegisters(IntPtr cpu_address, HookBase handler)
+        {
+            var pool  = _cpuPool;
+            var depth = _cpuPoolDepth;
+
+            if ( pool == null || depth >= pool.Length )
+            {
+                Array.Resize(ref pool, Math.Max(8, depth * 2));
+                _cpuPool = pool;
+            }
+
+            var cpu = pool[depth];
+
+            if ( cpu == null )
+            {
+                cpu         = new CPURegisters(cpu_address, handler);
+                pool[depth] = cpu;
+            }
+            else
+            {
+                cpu.Reset(cpu_address, handler);
+            }
+
+            _cpuPoolDepth = depth + 1;
+            return cpu;
+        }
+
+    #endregion
+    }
+
+    /// <summary>
+    ///     Information about a .NET code hook.
+    /// </summary>
+    internal sealed class HookInfo
+    {
+        /// <summary>
+        ///     The base address of hook.
+        /// </summary>
+        internal IntPtr Address;
+
+        /// <summary>
+        ///     The action.
+        /// </summary>
+        internal Action<CPURegisters> After;
+
+        /// <summary>
+        ///     The assembly that installed the hook.
+        /// </summary>
+        internal Assembly Assembly;
+
+        /// <summary>
+        ///     The action.
+        /// </summary>
+        internal Action<CPURegisters> Before;
+
+        /// <summary>
+        ///     The pointer to included code cave.
+        /// </summary>
+        internal IntPtr Include;
+
+        /// <summary>
+        ///     The pointer to after.
+        /// </summary>
+        internal IntPtr Include2;
+
+        /// <summary>
+        ///     Is this using far jump or near?
+        /// </summary>
+        internal bool IsFarJump;
+
+        /// <summary>
+        ///     The length of hook.
+        /// </summary>
+        internal int Length;
+
+        /// <summary>
+        ///     The handler that built the hook.
+        /// </summary>
+        internal HookBase Handler;
+
+        /// <summary>
+        ///     The plugin associated with assembly.
+        /// </summary>
+        internal Plugin Plugin;
+
+        /// <summary>
+        ///     The slot of hook in native statistics.
+        /// </summary>
+        internal int Slot;
+
+        /// <summary>
+        ///     The code written at hook address, this is the jump and padding.
+        /// </summary>
+        internal byte[] HookCode;
+
+        /// <summary>
+        ///     The code at hook address before the hook was written.
+        /// </summary>
+        internal byte[] OriginalCode;
+
+        /// <summary>
+        ///     Is the hook code currently written at hook address.
+        /// </summary>
+        internal bool IsActive;
+    }
+
+    /// <summary>
+    ///     Call count and managed handler time of a hook summed over all threads.
+    /// </summary>
+    public sealed class HookStatistics
+    {
+        /// <summary>
+        ///     The count of histogram buckets. Bucket i counts calls that took less than 2^(i+1) performance counter ticks.
+        /// </summary>
+        public const int BucketCount = 32;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="HookStatistics" /> class.
+        /// </summary>
+        /// <param name="hook">The hook.</param>
+        /// <param name="calls">The calls.</param>
+        /// <param name="totalTicks">The total ticks.</param>
+        /// <param name="maxTicks">The maximum ticks.</param>
+        /// <param name="histogram">The histogram.</param>
+        internal HookStatistics(HookInfo hook, long calls, long totalTicks, long maxTicks, long[] histogram)
         {
-            HookInfo result = null;
+            this.Address    = hook.Address;
+            this.Assembly   = hook.Assembly;
+            this.Plugin     = hook.Plugin;
+            this.Calls      = calls;
+            this.TotalTicks = totalTicks;
+            this.MaxTicks   = maxTicks;
+            this.Histogram  = histogram;
 
-            if ( HookRealMap.TryGetValue(addr.ToInt64(), out result) )
+            var fn = Main.GameInfo?.GetFunctionInfo(hook.Address, true);
+
+            if ( fn != null )
             {
-                return result;
+                this.FunctionId     = fn.Id;
+                this.FunctionOffset = Memory.Convert(hook.Address) - Memory.Convert(Main.GetMainTargetedModule().BaseAddress) - fn.Begin;
             }
-
-            return null;
         }
 
         /// <summary>
-        ///     Invoke previously registered action. This is called from unmanaged code.
+        ///     Gets the address of hook.
         /// </summary>
-        /// <param name="cpu_address">The address to CPU register info.</param>
-        /// <param name="pass">The pass.</param>
-        /// <returns></returns>
-        /// <exception cref="System.InvalidOperationException">Trying to invoke missing action (actionId)!</exception>
-        internal static void DoAction(IntPtr cpu_address, int pass)
-        {
-            try
-            {
-                /*if (Main.IsShutdown)
-                    return;*/
+        public IntPtr Address { get; }
 
-                // Read the hook info.
-                var sz = GetHookContextSize();
+        /// <summary>
+        ///     Gets the assembly that installed the hook.
+        /// </summary>
+        public Assembly Assembly { get; }
 
-                // The hooked address. This is not the actual address yet!
-                var hookAddr = ReadPointer((cpu_address + sz) - (IntPtr.Size * 6));
+        /// <summary>
+        ///     Gets the plugin that installed the hook or null.
+        /// </summary>
+        public Plugin Plugin { get; }
 
-                // Get action.
-                var hook = GetHook(hookAddr);
+        /// <summary>
+        ///     Gets the ID of function that contains the hook or zero if unknown.
+        /// </summary>
+        public ulong FunctionId { get; }
 
-                if ( hook == null )
-                {
-                    throw new InvalidOperationException("Trying to invoke missing hook (0x" + hookAddr.ToInt64().ToString("X") + ")!");
-                }
+        /// <summary>
+        ///     Gets the offset of hook from the start of function.
+        /// </summary>
+        public ulong FunctionOffset { get; }
 
-                // Decide handler type.
-                HookBase handler = null;
+        /// <summary>
+        ///     Gets the count of calls.
+        /// </summary>
+        public long Calls { get; }
 
-                if ( hook.Before == null )
-                {
-                    if ( hook.After != null )
-                    {
-                        handler = HookAfter.Instance;
-                    }
-                    else
-                    {
-                        throw new InvalidOperationException("Trying to invoke hook with no handlers!");
-                    }
-                }
-                else if ( hook.After != null ) { handler = HookBoth.Instance; }
-                else { handler                           = HookBefore.Instance; }
+        /// <summary>
+        ///     Gets the total time of calls in performance counter ticks.
+        /// </summary>
+        public long TotalTicks { get; }
 
-                // Create CPU register info.
-                var cpu = new CPURegisters(cpu_address, handler);
+        /// <summary>
+        ///     Gets the longest call in performance counter ticks.
+        /// </summary>
+        public long MaxTicks { get; }
 
-                // Fix some things according to hook.
-                cpu.IP        = hook.Address + hook.Length;
-                cpu.Include   = pass == 0 ? hook.Include : hook.Include2;
-                cpu.Hook      = hook.Address;
-                cpu.AllowSkip = pass == 0;
+        /// <summary>
+        ///     Gets the count of calls in each log2 time bucket.
+        /// </summary>
+        public long[] Histogram { get; }
 
-                // Perform action.
-                var ac = pass == 0 ? hook.Before : hook.After;
+        /// <summary>
+        ///     Gets the total time of calls in milliseconds.
+        /// </summary>
+        public double TotalMilliseconds => (double)this.TotalTicks * 1000.0 / Stopwatch.Frequency;
 
-                if ( ac != null )
-                {
-                    ac(cpu);
-                }
-            }
-            catch ( Exception ex )
-            {
-                // We can't rely on AppDomain.CurrentDomain.UnhandledException event here because if it happens in main thread the native exception handler is invoked before managed.
-                Main.ProcessManagedUnhandledException(ex);
-            }
-        }
+        /// <summary>
+        ///     Gets the longest call in milliseconds.
+        /// </summary>
+        public double MaxMilliseconds => (double)this.MaxTicks * 1000.0 / Stopwatch.Frequency;
 
-    #endregion
+        /// <summary>
+        ///     Gets the average call in milliseconds.
+        /// </summary>
+        public double AverageMilliseconds => this.Calls > 0 ? this.TotalMilliseconds / this.Calls : 0.0;
+
+        /// <summary>
+        ///     Gets the upper limit of histogram bucket in milliseconds.
+        /// </summary>
+        /// <param name="bucket">The bucket.</param>
+        /// <returns></returns>
+        public static double GetBucketUpperMilliseconds(int bucket) => Math.Pow(2.0, bucket + 1) * 1000.0 / Stopwatch.Frequency;
     }
 
     /// <summary>
-    ///     Information about a .NET code hook.
+    ///     Immutable open addressing table of hooks keyed by the address that the hook call returns to.
     /// </summary>
-    internal sealed class HookInfo
+    internal sealed class HookDispatchTable
     {
         /// <summary>
-        ///     The base address of hook.
+        ///     The empty table.
         /// </summary>
-        internal IntPtr Address;
+        internal static readonly HookDispatchTable Empty = new HookDispatchTable(new long[1], new HookInfo[1], 0);
 
         /// <summary>
-        ///     The action.
+        ///     The hooks, same index as key.
         /// </summary>
-        internal Action<CPURegisters> After;
+        private readonly HookInfo[] Hooks;
 
         /// <summary>
-        ///     The assembly that installed the hook.
+        ///     The keys, zero means empty slot.
         /// </summary>
-        internal Assembly Assembly;
+        private readonly long[] Keys;
 
         /// <summary>
-        ///     The action.
+        ///     Initializes a new instance of the <see cref="HookDispatchTable" /> class.
         /// </summary>
-        internal Action<CPURegisters> Before;
+        /// <param name="keys">The keys.</param>
+        /// <param name="hooks">The hooks.</param>
+        /// <param name="count">The count.</param>
+        private HookDispatchTable(long[] keys, HookInfo[] hooks, int count)
+        {
+            this.Keys  = keys;
+            this.Hooks = hooks;
+            this.Count = count;
+        }
 
         /// <summary>
-        ///     The pointer to included code cave.
+        ///     The count of hooks in table.
         /// </summary>
-        internal IntPtr Include;
+        internal readonly int Count;
 
         /// <summary>
-        ///     The pointer to after.
+        ///     Finds the hook by key.
         /// </summary>
-        internal IntPtr Include2;
+        /// <param name="key">The key.</param>
+        /// <returns></returns>
+        internal HookInfo Find(long key)
+        {
+            var keys = this.Keys;
+            var mask = keys.Length - 1;
+            var i    = GetIndex(key, mask);
+
+            while ( true )
+            {
+                var k = keys[i];
+
+                if ( k == key )
+                {
+                    return this.Hooks[i];
+                }
+
+                if ( k == 0 )
+                {
+                    return null;
+                }
+
+                i = (i + 1) & mask;
+            }
+        }
 
         /// <summary>
-        ///     Is this using far jump or near?
+        ///     Creates a new table that also contains the specified hook. This table is not modified.
         /// </summary>
-        internal bool IsFarJump;
+        /// <param name="key">The key.</param>
+        /// <param name="hook">The hook.</param>
+        /// <returns></returns>
+        internal HookDispatchTable Add(long key, HookInfo hook)
+        {
+            if ( key == 0 )
+            {
+                throw new ArgumentOutOfRangeException(nameof(key));
+            }
+
+            // Keep the table at most half full so lookups stay short.
+            var capacity = 1;
+
+            while ( capacity < (this.Count + 1) * 2 )
+            {
+                capacity <<= 1;
+            }
+
+            var keys  = new long[capacity];
+            var hooks = new HookInfo[capacity];
+            var count = 0;
+
+            for ( var i = 0; i < this.Keys.Length; i++ )
+            {
+                if ( this.Keys[i] != 0 && this.Keys[i] != key )
+                {
+                    Insert(keys, hooks, this.Keys[i], this.Hooks[i]);
+                    count++;
+                }
+            }
+
+            Insert(keys, hooks, key, hook);
+            count++;
+
+            return new HookDispatchTable(keys, hooks, count);
+        }
 
         /// <summary>
-        ///     The length of hook.
+        ///     Inserts the hook to arrays.
         /// </summary>
-        internal int Length;
+        /// <param name="keys">The keys.</param>
+        /// <param name="hooks">The hooks.</param>
+        /// <param name="key">The key.</param>
+        /// <param name="hook">The hook.</param>
+        private static void Insert(long[] keys, HookInfo[] hooks, long key, HookInfo hook)
+        {
+            var mask = keys.Length - 1;
+            var i    = GetIndex(key, mask);
+
+            while ( keys[i] != 0 )
+            {
+                i = (i + 1) & mask;
+            }
+
+            keys[i]  = key;
+            hooks[i] = hook;
+        }
 
         /// <summary>
-        ///     The plugin associated with assembly.
+        ///     Gets the first index to probe for key.
         /// </summary>
-        internal Plugin Plugin;
+        /// <param name="key">The key.</param>
+        /// <param name="mask">The mask.</param>
+        /// <returns></returns>
+        private static int GetIndex(long key, int mask) => (int)(((ulong)key * 0x9E3779B97F4A7C15UL) >> 32) & mask;
     }
 
     /// <summary>
@@ -3453,6 +4381,34 @@
     #endregion
     }
 
+    /// <summary>
+    ///     A memory block to read with <see cref="Memory.ReadGather" />.
+    /// </summary>
+    [ StructLayout(LayoutKind.Sequential) ]
+    public readonly struct MemoryGatherEntry
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="MemoryGatherEntry" /> struct.
+        /// </summary>
+        /// <param name="address">The address to read from.</param>
+        /// <param name="size">Amount of bytes to read.</param>
+        public MemoryGatherEntry(IntPtr address, int size)
+        {
+            this.Address = address;
+            this.Size    = new IntPtr(size);
+        }
+
+        /// <summary>
+        ///     The address to read from.
+        /// </summary>
+        public readonly IntPtr Address;
+
+        /// <summary>
+        ///     Amount of bytes to read.
+        /// </summary>
+        public readonly IntPtr Size;
+    }
+
     /// <summary>
     ///     Implement invoke argument for native calls.
     /// </summary>
@@ -3644,7 +4600,8 @@
 
         /// <summary>
         ///     Gets or sets the action to run when hooked code is triggered. This action will run before included code and may
-        ///     read or write CPU registers.
+        ///     read or write CPU registers. The <see cref="CPURegisters" /> instance is reused for later hook calls on the same
+        ///     thread, don't keep it after the action returns.
         /// </summary>
         /// <value>
         ///     The action.
@@ -3653,7 +4610,8 @@
 
         /// <summary>
         ///     Gets or sets the action to run when hooked code is triggered. This action will run after included code and may read
-        ///     or write CPU registers.
+        ///     or write CPU registers. The <see cref="CPURegisters" /> instance is reused for later hook calls on the same
+        ///     thread, don't keep it after the action returns.
         /// </summary>
         /// <value>
         ///     The action.
@@ -3707,7 +4665,8 @@
 
         /// <summary>
         ///     Gets or sets the action to run when hooked code is triggered. This action will run before included code and may
-        ///     read or write CPU registers.
+        ///     read or write CPU registers. The <see cref="CPURegisters" /> instance is reused for later hook calls on the same
+        ///     thread, don't keep it after the action returns.
         /// </summary>
         /// <value>
         ///     The action.
@@ -3716,7 +4675,8 @@
 
         /// <summary>
         ///     Gets or sets the action to run when hooked code is triggered. This action will run after included code and may read
-        ///     or write CPU registers.
+        ///     or write CPU registers. The <see cref="CPURegisters" /> instance is reused for later hook calls on the same
+        ///     thread, don't keep it after the action returns.
         /// </summary>
         /// <value>
         ///     The action.
@@ -3736,15 +4696,48 @@
     /// <summary>
     ///     Use this for code allocations. VirtualAlloc is used to allocate whole page of memory and is very wasteful for this
     ///     reason.
-    ///     So we use our own backend allocator to use same code page for multiple allocations to save memory.
+    ///     So we use our own backend allocator to use same code page for multiple allocations to save memory. Small
+    ///     allocations such as hook trampolines are rounded up to a size class and reuse freed slots of the same class so
+    ///     getting and freeing them does not search anything.
     /// </summary>
     internal sealed class CodePageAllocator : IDisposable
     {
         /// <summary>
-        ///     The available memory ranges.
+        ///     The maximum distance between a code page and code that must reach it with a near jump. This is a bit less than
+        ///     2 GB to leave room for the instruction length.
+        /// </summary>
+        internal const long NearDistance = 0x7FF00000;
+
+        /// <summary>
+        ///     The granularity of small size classes.
+        /// </summary>
+        private const int SlotGranularity = 16;
+
+        /// <summary>
+        ///     The largest size that is a multiple of slot granularity, larger classes are powers of two.
+        /// </summary>
+        private const int SlotLinearMax = 512;
+
+        /// <summary>
+        ///     The largest allocation size that uses size classes.
+        /// </summary>
+        private const int SlotMax = 4096;
+
+        /// <summary>
+        ///     The count of size classes.
+        /// </summary>
+        private const int SlotClassCount = SlotLinearMax / SlotGranularity + 3;
+
+        /// <summary>
+        ///     The available memory ranges of freed allocations that were too large for a size class.
         /// </summary>
         private readonly SortedDictionary<ulong, int> Available;
 
+        /// <summary>
+        ///     The freed slots by size class.
+        /// </summary>
+        private readonly Stack<IntPtr>[] FreeSlots = new Stack<IntPtr>[SlotClassCount];
+
         /// <summary>
         ///     The size of code page.
         /// </summary>
@@ -3760,30 +4753,57 @@
         /// </summary>
         private IntPtr End = IntPtr.Zero;
 
+        /// <summary>
+        ///     The begin of memory that has never been allocated.
+        /// </summary>
+        private long Next;
+
         /// <summary>
         ///     Initializes a new instance of the <see cref="CodePageAllocator" /> class.
         /// </summary>
+        /// <param name="begin">The begin of allocated memory.</param>
+        /// <param name="size">The full size of code page.</param>
+        private CodePageAllocator(IntPtr begin, int size)
+        {
+            this.Size      = size;
+            this.Available = new SortedDictionary<ulong, int>();
+            this.Begin     = begin;
+            this.End       = this.Begin + size;
+            this.Next      = this.Begin.ToInt64();
+        }
+
+        /// <summary>
+        ///     Allocates a new code page. Returns null if the memory could not be allocated.
+        /// </summary>
+        /// <param name="address">The address where to allocate or zero to let system choose.</param>
         /// <param name="size">The full size of code page.</param>
-        internal CodePageAllocator(int size)
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentOutOfRangeException">size;Size must be positive!</exception>
+        internal static CodePageAllocator Create(IntPtr address, int size)
         {
             if ( size <= 0 )
             {
                 throw new ArgumentOutOfRangeException("size", "Size must be positive!");
             }
 
-            this.Size      = size;
-            this.Available = new SortedDictionary<ulong, int>();
-            this.Begin     = VirtualAlloc(IntPtr.Zero, new IntPtr(size), 0x3000, 0x40);
+            var begin = VirtualAlloc(address, new IntPtr(size), 0x3000, 0x40);
 
-            if ( this.Begin == IntPtr.Zero )
+            if ( begin == IntPtr.Zero )
             {
-                throw new OutOfMemoryException("Failed to allocate memory for code page!");
+                return null;
             }
 
-            this.End                                   = this.Begin + size;
-            this.Available[Memory.Convert(this.Begin)] = size;
+            return new CodePageAllocator(begin, size);
         }
 
+        /// <summary>
+        ///     Determines whether every address in the range can reach this whole code page with a near jump.
+        /// </summary>
+        /// <param name="begin">The begin of range.</param>
+        /// <param name="end">The end of range.</param>
+        /// <returns></returns>
+        internal bool IsNear(long begin, long end) => this.End.ToInt64() - begin <= NearDistance && end - this.Begin.ToInt64() <= NearDistance;
+
         /// <summary>
         ///     Gets allocated memory from page with specified size. If the allocation is not possible in this code page this
         ///     function returns null.
@@ -3792,18 +4812,29 @@
         /// <returns></returns>
         internal MemoryAllocation Get(int size)
         {
-            if ( this.Available.Count == 0 )
+            var sizeClass = GetSizeClass(size);
+
+            if ( sizeClass >= 0 )
             {
-                return null;
+                var slots = this.FreeSlots[sizeClass];
+
+                if ( slots != null && slots.Count != 0 )
+                {
+                    return new MemoryAllocation(slots.Pop(), size, 0, MemoryAllocation.MemoryAllocationTypes.Code, this);
+                }
+
+                return this.Take(GetSizeOfClass(sizeClass), size);
             }
 
+            var rounded = GetRoundedSize(size);
+
             ulong found      = 0;
             var   foundTotal = 0;
 
             foreach ( var x in this.Available )
 
             {
-                if ( x.Value >= size )
+                if ( x.Value >= rounded )
                 {
                     found      = x.Key;
                     foundTotal = x.Value;
@@ -3813,14 +4844,14 @@
 
             if ( found == 0 )
             {
-                return null;
+                return this.Take(rounded, size);
             }
 
             this.Available.Remove(found);
 
-            if ( foundTotal > size )
+            if ( foundTotal > rounded )
             {
-                this.Available[found + (uint)size] = foundTotal - size;
+                this.Available[found + (uint)rounded] = foundTotal - rounded;
             }
 
             return new MemoryAllocation(Memory.Convert(found), size, 0, MemoryAllocation.MemoryAllocationTypes.Code, this);
@@ -3833,6 +4864,24 @@
         /// <param name="size">The size of allocation.</param>
         internal void Free(IntPtr addr, int size)
         {
+            var sizeClass = GetSizeClass(size);
+
+            if ( sizeClass >= 0 )
+            {
+                var slots = this.FreeSlots[sizeClass];
+
+                if ( slots == null )
+                {
+                    slots                     = new Stack<IntPtr>();
+                    this.FreeSlots[sizeClass] = slots;
+                }
+
+                slots.Push(addr);
+                return;
+            }
+
+            size = GetRoundedSize(size);
+
             var   addr_u     = Memory.Convert(addr);
             ulong keyFound   = 0;
             var   valueFound = 0;
@@ -3874,6 +4923,70 @@
             else { throw new NotImplementedException(); }
         }
 
+        /// <summary>
+        ///     Takes memory that has never been allocated from the page. Returns null if page is full.
+        /// </summary>
+        /// <param name="length">The length to take.</param>
+        /// <param name="size">The requested size of allocation.</param>
+        /// <returns></returns>
+        private MemoryAllocation Take(int length, int size)
+        {
+            if ( this.End.ToInt64() - this.Next < length )
+            {
+                return null;
+            }
+
+            var address = new IntPtr(this.Next);
+            this.Next += length;
+
+            return new MemoryAllocation(address, size, 0, MemoryAllocation.MemoryAllocationTypes.Code, this);
+        }
+
+        /// <summary>
+        ///     Gets the size class of allocation size or -1 if the size is too large for a size class.
+        /// </summary>
+        /// <param name="size">The size.</param>
+        /// <returns></returns>
+        private static int GetSizeClass(int size)
+        {
+            if ( size <= SlotLinearMax )
+            {
+                return (size - 1) / SlotGranularity;
+            }
+
+            if ( size > SlotMax )
+            {
+                return -1;
+            }
+
+            // 513 - 1024, 1025 - 2048, 2049 - 4096.
+            return SlotLinearMax / SlotGranularity + BitOperations.Log2((uint)(size - 1)) - 9;
+        }
+
+        /// <summary>
+        ///     Gets the slot size of size class.
+        /// </summary>
+        /// <param name="sizeClass">The size class.</param>
+        /// <returns></returns>
+        private static int GetSizeOfClass(int sizeClass)
+        {
+            var linear = SlotLinearMax / SlotGranularity;
+
+            if ( sizeClass < linear )
+            {
+                return (sizeClass + 1) * SlotGranularity;
+            }
+
+            return SlotLinearMax << (sizeClass - linear + 1);
+        }
+
+        /// <summary>
+        ///     Gets the size rounded up to slot granularity so all allocations stay aligned.
+        /// </summary>
+        /// <param name="size">The size.</param>
+        /// <returns></returns>
+        private static int GetRoundedSize(int size) => (size + SlotGranularity - 1) / SlotGranularity * SlotGranularity;
+
     #region Api calls
 
         [ DllImport("kernel32.dll", SetLastError = true) ]
@@ -3932,14 +5045,16 @@
     }
 
     /// <summary>
-    ///     Contains information about CPU registers at a specific location in hooked code.
+    ///     Contains information about CPU registers at a specific location in hooked code. Instances passed to hook actions
+    ///     are pooled per thread and reused by the next hook call at the same depth, so they are only valid until the action
+    ///     returns. Copy any register values that are needed later instead of keeping the instance.
     /// </summary>
     public sealed class CPURegisters
     {
         /// <summary>
         ///     Is from hook?
         /// </summary>
-        private readonly HookBase IsFromHook;
+        private HookBase IsFromHook;
 
     #region Constructors
 
@@ -3948,10 +5063,22 @@
         /// </summary>
         /// <param name="address">The address.</param>
         /// <param name="isFromHook">Is this from hook?</param>
-        internal CPURegisters(IntPtr address, HookBase isFromHook)
+        internal CPURegisters(IntPtr address, HookBase isFromHook) => this.Reset(address, isFromHook);
+
+    #endregion
+
+    #region CPURegisters members
+
+        /// <summary>
+        ///     Points this instance to another register info so it can be reused for the next hook call.
+        /// </summary>
+        /// <param name="address">The address.</param>
+        /// <param name="isFromHook">Is this from hook?</param>
+        internal void Reset(IntPtr address, HookBase isFromHook)
         {
             this.Address    = address;
             this.IsFromHook = isFromHook;
+            this.AllowSkip  = false;
 
             var handler = this.IsFromHook;
 
@@ -3962,10 +5089,6 @@
             }
         }
 
-    #endregion
-
-    #region CPURegisters members
-
         /// <summary>
         ///     Verifies the offset.
         /// </summary>
@@ -5119,7 +6242,7 @@
         /// <summary>
         ///     The base address of allocation.
         /// </summary>
-        internal readonly IntPtr Address;
+        internal IntPtr Address;
 
         /// <summary>
         ///     The offsets of unmanaged memory.
@@ -3,6 +3,7 @@
     using System;
     using System.Collections;
     using System.Collections.Generic;
+    using System.Runtime.InteropServices;
     using System.Text;
 
     /// <summary>
@@ -102,12 +103,28 @@
         }
 
         /// <summary>
-        ///     Returns an enumerator that iterates through the collection.
+        ///     Returns an enumerator that iterates through the collection. This boxes the enumerator, use
+        ///     <see cref="AsValueEnumerable" /> in <c>foreach</c> to enumerate without allocating.
         /// </summary>
         /// <returns>
         ///     A <see cref="T:System.Collections.Generic.IEnumerator`1" /> that can be used to iterate through the collection.
         /// </returns>
-        public IEnumerator<TValue> GetEnumerator() => new enumerator(this);
+        public IEnumerator<TValue> GetEnumerator() => new Enumerator(this);
+
+        /// <summary>
+        ///     Gets a value type wrapper of this array whose enumerator is a value type, so <c>foreach</c> over it does not
+        ///     allocate. The length is read once when enumeration begins.
+        /// </summary>
+        /// <returns></returns>
+        /// <example>
+        ///     <code>
+        ///     foreach ( var value in array.AsValueEnumerable() )
+        ///     {
+        ///         ...
+        ///     }
+        ///     </code>
+        /// </example>
+        public ValueEnumerable AsValueEnumerable() => new ValueEnumerable(this);
 
         /// <summary>
         ///     Returns an enumerator that iterates through a collection.
@@ -115,7 +132,57 @@
         /// <returns>
         ///     An <see cref="T:System.Collections.IEnumerator" /> object that can be used to iterate through the collection.
         /// </returns>
-        IEnumerator IEnumerable.GetEnumerator() => this.GetEnumerator();
+        IEnumerator IEnumerable.GetEnumerator() => new Enumerator(this);
+
+        /// <summary>
+        ///     Reads the raw pointer entries of array to destination with a single memory copy. This can only be used when each
+        ///     entry is the size of a pointer, for example arrays of object references.
+        /// </summary>
+        /// <param name="destination">The destination.</param>
+        /// <returns>
+        ///     The count of entries that were read. This is less than <see cref="MemoryArrayBase.Length" /> if destination is too
+        ///     short.
+        /// </returns>
+        /// <exception cref="System.InvalidOperationException">Array entries are not pointers!</exception>
+        /// <exception cref="NetScriptFramework.MemoryAccessException"></exception>
+        public int ReadAllPointers(Span<IntPtr> destination)
+        {
+            if ( this.Handler.Stride != IntPtr.Size )
+            {
+                throw new InvalidOperationException("Array entries are not pointers!");
+            }
+
+            if ( this.Address == IntPtr.Zero )
+            {
+                return 0;
+            }
+
+            var count = Math.Min(this.Length, destination.Length);
+
+            if ( count > 0 )
+            {
+                Memory.ReadBytes(this.Address, MemoryMarshal.AsBytes(destination.Slice(0, count)));
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        ///     Copies the raw pointer entries of array to destination with a single memory copy.
+        /// </summary>
+        /// <param name="destination">The destination.</param>
+        /// <returns>The count of entries that were copied.</returns>
+        /// <exception cref="System.ArgumentNullException">destination</exception>
+        /// <seealso cref="ReadAllPointers" />
+        public int CopyTo(IntPtr[] destination)
+        {
+            if ( destination == null )
+            {
+                throw new ArgumentNullException(nameof(destination));
+            }
+
+            return this.ReadAllPointers(destination);
+        }
 
         /// <summary>
         ///     Returns a <see cref="System.String" /> that represents this instance.
@@ -197,32 +264,72 @@
         }
 
         /// <summary>
-        ///     The enumerator implementation.
+        ///     A memory array that is enumerated with a value type enumerator, see <see cref="AsValueEnumerable" />.
+        /// </summary>
+        public readonly struct ValueEnumerable
+        {
+            /// <summary>
+            ///     The array.
+            /// </summary>
+            private readonly MemoryArray<TValue> Array;
+
+            /// <summary>
+            ///     Initializes a new instance of the <see cref="ValueEnumerable" /> struct.
+            /// </summary>
+            /// <param name="array">The array.</param>
+            internal ValueEnumerable(MemoryArray<TValue> array) => this.Array = array;
+
+            /// <summary>
+            ///     Returns an enumerator that iterates through the array without allocating.
+            /// </summary>
+            /// <returns>
+            ///     An <see cref="Enumerator" /> that can be used to iterate through the array.
+            /// </returns>
+            public Enumerator GetEnumerator() => new Enumerator(this.Array);
+        }
+
+        /// <summary>
+        ///     Enumerates the values of a memory array.
         /// </summary>
-        /// <seealso cref="NetScriptFramework.MemoryArrayBase" />
-        /// <seealso cref="System.Collections.Generic.IEnumerable{TValue}" />
-        private sealed class enumerator : IEnumerator<TValue>
+        /// <seealso cref="System.Collections.Generic.IEnumerator{TValue}" />
+        public struct Enumerator : IEnumerator<TValue>
         {
             /// <summary>
             ///     The array.
             /// </summary>
             private readonly MemoryArray<TValue> Array;
 
+            /// <summary>
+            ///     The handler of array.
+            /// </summary>
+            private readonly MemoryArrayTypeHandler<TValue> Handler;
+
+            /// <summary>
+            ///     The length of array when enumeration began.
+            /// </summary>
+            private readonly int Length;
+
             /// <summary>
             ///     The index.
             /// </summary>
-            private int Index = -1;
+            private int Index;
 
             /// <summary>
-            ///     Initializes a new instance of the <see cref="enumerator" /> class.
+            ///     Initializes a new instance of the <see cref="Enumerator" /> struct.
             /// </summary>
             /// <param name="array">The array.</param>
-            internal enumerator(MemoryArray<TValue> array) => this.Array = array;
+            internal Enumerator(MemoryArray<TValue> array)
+            {
+                this.Array   = array;
+                this.Handler = array.Handler;
+                this.Length  = array.Address != IntPtr.Zero ? array.Length : 0;
+                this.Index   = -1;
+            }
 
             /// <summary>
             ///     Gets the element in the collection at the current position of the enumerator.
             /// </summary>
-            public TValue Current => this.Array[this.Index];
+            public TValue Current => this.Handler.Read(this.Array.Address, this.Index);
 
             /// <summary>
             ///     Gets the element in the collection at the current position of the enumerator.
@@ -241,7 +348,7 @@
             ///     true if the enumerator was successfully advanced to the next element; false if the enumerator has passed the end of
             ///     the collection.
             /// </returns>
-            public bool MoveNext() => ++this.Index < this.Array.Length;
+            public bool MoveNext() => ++this.Index < this.Length;
 
             /// <summary>
             ///     Sets the enumerator to its initial position, which is before the first element in the collection.
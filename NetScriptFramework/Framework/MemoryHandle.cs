@@ -0,0 +1,140 @@
+﻿namespace NetScriptFramework
+{
+    using System;
+
+    /// <summary>
+    ///     Typed handle to an object in memory that does not allocate a wrapper. Use this for hot types without a virtual
+    ///     function table where fields are read directly by offset, the wrapper is only created when <see cref="Value" /> is
+    ///     accessed.
+    /// </summary>
+    /// <typeparam name="T">The type of object.</typeparam>
+    public readonly struct MemoryHandle <T> : IEquatable<MemoryHandle<T>> where T : IMemoryObject
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="MemoryHandle{T}" /> struct.
+        /// </summary>
+        /// <param name="address">The address of object.</param>
+        public MemoryHandle(IntPtr address) => this.Address = address;
+
+        /// <summary>
+        ///     The address of object.
+        /// </summary>
+        public readonly IntPtr Address;
+
+        /// <summary>
+        ///     Gets a value indicating whether this handle does not point to an object.
+        /// </summary>
+        /// <value>
+        ///     <c>true</c> if the address is zero; otherwise, <c>false</c>.
+        /// </value>
+        public bool IsNull => this.Address == IntPtr.Zero;
+
+        /// <summary>
+        ///     Gets the wrapper of object. This allocates a wrapper unless the frame cache is enabled and already has it.
+        /// </summary>
+        /// <value>
+        ///     The wrapper or null if handle is null.
+        /// </value>
+        public T Value => MemoryObject.FromAddress<T>(this.Address);
+
+        /// <summary>
+        ///     Gets a handle to a pointer field of this object.
+        /// </summary>
+        /// <typeparam name="TField">The type of object that the field points to.</typeparam>
+        /// <param name="offset">The offset of field.</param>
+        /// <returns></returns>
+        public MemoryHandle<TField> ReadHandle <TField>(int offset) where TField : IMemoryObject => new MemoryHandle<TField>(Memory.ReadPointer(this.Address + offset));
+
+        /// <summary>
+        ///     Gets a handle to an object that is a field of this object.
+        /// </summary>
+        /// <typeparam name="TField">The type of field.</typeparam>
+        /// <param name="offset">The offset of field.</param>
+        /// <returns></returns>
+        public MemoryHandle<TField> GetField <TField>(int offset) where TField : IMemoryObject => new MemoryHandle<TField>(this.Address + offset);
+
+        /// <summary>
+        ///     Reads a pointer field.
+        /// </summary>
+        /// <param name="offset">The offset of field.</param>
+        /// <returns></returns>
+        public IntPtr ReadPointer(int offset) => Memory.ReadPointer(this.Address + offset);
+
+        /// <summary>
+        ///     Reads a 32 bit integer field.
+        /// </summary>
+        /// <param name="offset">The offset of field.</param>
+        /// <returns></returns>
+        public int ReadInt32(int offset) => Memory.ReadInt32(this.Address + offset);
+
+        /// <summary>
+        ///     Reads a 32 bit unsigned integer field.
+        /// </summary>
+        /// <param name="offset">The offset of field.</param>
+        /// <returns></returns>
+        public uint ReadUInt32(int offset) => Memory.ReadUInt32(this.Address + offset);
+
+        /// <summary>
+        ///     Reads a floating point field.
+        /// </summary>
+        /// <param name="offset">The offset of field.</param>
+        /// <returns></returns>
+        public float ReadFloat(int offset) => Memory.ReadFloat(this.Address + offset);
+
+        /// <summary>
+        ///     Writes a floating point field.
+        /// </summary>
+        /// <param name="offset">The offset of field.</param>
+        /// <param name="value">The value.</param>
+        public void WriteFloat(int offset, float value) => Memory.WriteFloat(this.Address + offset, value);
+
+        /// <summary>
+        ///     Performs an implicit conversion from <see cref="MemoryHandle{T}" /> to <see cref="IntPtr" />.
+        /// </summary>
+        /// <param name="handle">The handle.</param>
+        /// <returns>
+        ///     The address of object.
+        /// </returns>
+        public static implicit operator IntPtr(MemoryHandle<T> handle) => handle.Address;
+
+        /// <summary>
+        ///     Determines whether the handles point to the same address.
+        /// </summary>
+        /// <param name="a">The first handle.</param>
+        /// <param name="b">The second handle.</param>
+        /// <returns></returns>
+        public static bool operator ==(MemoryHandle<T> a, MemoryHandle<T> b) => a.Address == b.Address;
+
+        /// <summary>
+        ///     Determines whether the handles point to different addresses.
+        /// </summary>
+        /// <param name="a">The first handle.</param>
+        /// <param name="b">The second handle.</param>
+        /// <returns></returns>
+        public static bool operator !=(MemoryHandle<T> a, MemoryHandle<T> b) => a.Address != b.Address;
+
+        /// <summary>
+        ///     Determines whether the specified handle points to the same address.
+        /// </summary>
+        /// <param name="other">The other handle.</param>
+        /// <returns></returns>
+        public bool Equals(MemoryHandle<T> other) => this.Address == other.Address;
+
+        /// <summary>
+        ///     Determines whether the specified <see cref="System.Object" />, is a handle to the same address.
+        /// </summary>
+        /// <param name="obj">The <see cref="System.Object" /> to compare with this instance.</param>
+        /// <returns>
+        ///     <c>true</c> if the specified <see cref="System.Object" /> is equal to this instance; otherwise, <c>false</c>.
+        /// </returns>
+        public override bool Equals(object obj) => obj is MemoryHandle<T> other && this.Address == other.Address;
+
+        /// <summary>
+        ///     Returns a hash code for this instance.
+        /// </summary>
+        /// <returns>
+        ///     A hash code for this instance, suitable for use in hashing algorithms and data structures like a hash table.
+        /// </returns>
+        public override int GetHashCode() => this.Address.GetHashCode();
+    }
+}
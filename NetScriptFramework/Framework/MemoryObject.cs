@@ -98,6 +98,36 @@
         /// </value>
         public abstract IReadOnlyList<GameInfo.GameTypeInstanceInfo> TypeInfos { get; }
 
+        /// <summary>
+        ///     Gets or sets a value indicating whether wrappers are cached for the current frame. When enabled, getting the same
+        ///     object as the same type again on the same thread during one frame returns the same wrapper instead of allocating
+        ///     a new one. Default value is read from configuration.
+        /// </summary>
+        /// <value>
+        ///     <c>true</c> if wrappers are cached; otherwise, <c>false</c>.
+        /// </value>
+        public static bool FrameCacheEnabled
+        {
+            get => FrameObjectCache.Enabled;
+            set => FrameObjectCache.Enabled = value;
+        }
+
+        /// <summary>
+        ///     Gets the count of wrappers that have been allocated. Sample this twice to get the allocation rate.
+        /// </summary>
+        /// <value>
+        ///     The count of allocated wrappers.
+        /// </value>
+        public static long AllocatedWrapperCount => FrameObjectCache.CreatedCount;
+
+        /// <summary>
+        ///     Gets the count of times a wrapper was returned from frame cache instead of allocating a new one.
+        /// </summary>
+        /// <value>
+        ///     The count of cache hits.
+        /// </value>
+        public static long CachedWrapperCount => FrameObjectCache.HitCount;
+
         /// <summary>
         ///     Get an object in memory from specified base address.
         /// </summary>
@@ -124,10 +154,9 @@
                     // Not using "TryRead" on purpose because bad pointer should cause exception instead of returning null!
                     var ptr = Memory.ReadPointer(address);
 
-                    if ( Main.Game.Types.TypesByVTable.TryGetValue(ptr, out t) )
+                    if ( (t = Main.Game.Types.FindByVTable(ptr)) != null )
                     {
-                        var mo = t.Creator();
-                        mo.Address = address - t.OffsetInFullType;
+                        var mo = FrameObjectCache.Create(t, address);
                         object result = mo;
 
                         // May cause invalid cast exception and that is fine.
@@ -144,8 +173,7 @@
                         throw new ArgumentException("Type \"" + typeof(T).Name + "\" is not registered with game library!");
                     }
 
-                    var mo = t.Creator();
-                    mo.Address = address - t.OffsetInFullType;
+                    var mo = FrameObjectCache.Create(t, address);
                     object result = mo;
                     return (T)result;
                 }
@@ -200,10 +228,9 @@
                     // Not using "TryRead" on purpose because bad pointer should cause exception instead of returning null!
                     var ptr = Memory.ReadPointer(address);
 
-                    if ( Main.Game.Types.TypesByVTable.TryGetValue(ptr, out td) )
+                    if ( (td = Main.Game.Types.FindByVTable(ptr)) != null )
                     {
-                        var mo = td.Creator();
-                        mo.Address = address - td.OffsetInFullType;
+                        var mo = FrameObjectCache.Create(td, address);
 
                         if ( !t.IsAssignableFrom(td.ImplementationType) )
                         {
@@ -223,8 +250,7 @@
                         throw new ArgumentException("Type \"" + t.Name + "\" is not registered with game library!");
                     }
 
-                    var mo = td.Creator();
-                    mo.Address = address - td.OffsetInFullType;
+                    var mo = FrameObjectCache.Create(td, address);
                     return mo;
                 }
             }
@@ -292,8 +318,7 @@
                     return VirtualObject.FromAddress(address);
                 }
 
-                var mo = td.Creator();
-                mo.Address = address - td.OffsetInFullType;
+                var mo = FrameObjectCache.Create(td, address);
                 return mo;
             }
 
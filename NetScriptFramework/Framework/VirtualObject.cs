@@ -115,10 +115,9 @@
                 // Not using "TryRead" on purpose because bad pointer should cause exception instead of returning null!
                 var ptr = Memory.ReadPointer(address);
 
-                if ( Main.Game.Types.TypesByVTable.TryGetValue(ptr, out td) )
+                if ( (td = Main.Game.Types.FindByVTable(ptr)) != null )
                 {
-                    var mo = td.Creator();
-                    mo.Address = address - td.OffsetInFullType;
+                    var mo = FrameObjectCache.Create(td, address);
 
                     if ( mo is VirtualObject )
                     {
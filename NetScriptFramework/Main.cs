@@ -40,7 +40,7 @@
         /// <summary>
         ///     The required runtime version.
         /// </summary>
-        private static readonly int RequiredRuntimeVersion = 5;
+        private static readonly int RequiredRuntimeVersion = 10;
 
         /// <summary>
         ///     Gets the framework assembly.
@@ -162,6 +162,9 @@
                 }
             }
 
+            // Write queued log records before suspending threads, a suspended log writer would keep the file locked.
+            LogFile.FlushAll();
+
             RTHandler.SuspendAllThreadsInCurrentProcess();
 
             MessageBox.Show(message, "Error", MessageBoxButtons.OK, MessageBoxIcon.Error);
@@ -171,6 +174,8 @@
 
         internal static void _CriticalException_NoLog(string message, bool kill)
         {
+            LogFile.FlushAll();
+
             RTHandler.SuspendAllThreadsInCurrentProcess();
 
             MessageBox.Show(message, "Error", MessageBoxButtons.OK, MessageBoxIcon.Error);
@@ -247,9 +252,6 @@
                 // This is needed later so we can cache this call.
                 FrameworkAssembly = Assembly.GetExecutingAssembly();
 
-                // Initialize ID generator.
-                IDGenerator = new UIDGenerator();
-
                 // Allocate trash memory.
                 {
                     var alloc = Memory.Allocate(1024);
@@ -375,6 +377,9 @@
             // Shutdown plugins.
             PluginManager.Shutdown();
 
+            // Write performance monitor times if anything was monitored.
+            PerformanceMonitor.Shutdown();
+
             // Write info to log.
             Log.AppendLine("Shutdown complete.");
 
@@ -452,6 +457,9 @@
                 Log.AppendLine(logmsg);
             }
 
+            // The process may end right after this, make sure queued log records are written.
+            LogFile.FlushAll();
+
             return handled > 0;
         }
 
@@ -655,9 +663,10 @@
         internal static int GameCreate;
 
         /// <summary>
-        ///     The identifier generator.
+        ///     The identifier generator. This is created with the class so identifiers can be generated before the framework is
+        ///     initialized, for example when events are used outside of the game.
         /// </summary>
-        private static UIDGenerator IDGenerator;
+        private static readonly UIDGenerator IDGenerator = new UIDGenerator();
 
         /// <summary>
         ///     Initializes the log file.
@@ -684,6 +693,12 @@
             Config.AddSetting(_Config_Debug_CrashLog_Append, new Value(0), "Append crash logs", "Append all crash logs to same file or create a separate file for each crash.");
             Config.AddSetting(_Config_Debug_CrashLog_StackCount, new Value(512), "Stack count", "How many values to print from stack.");
             Config.AddSetting(_Config_Debug_CrashLog_Modules, new Value(true), "Modules", "Write loaded modules of process to crash log?");
+            Config.AddSetting(_Config_Debug_Hook_TrackDepth, new Value(0), "Track hook depth", "Record the deepest hook recursion reached on each thread. This adds a few instructions to every hook call.");
+            Config.AddSetting(_Config_Debug_Hook_Statistics, new Value(0), "Hook statistics", "Record call count and handler time of every hook and write them to HookStatistics.txt every this many seconds. Set 0 to disable.");
+            Config.AddSetting(_Config_Debug_PerformanceMonitor_DumpKey, new Value(0), "Performance monitor dump key", "Virtual key code that writes the times of monitored functions to the Performance directory when pressed. Set 0 to only write them on shutdown.");
+            Config.AddSetting(_Config_VersionLibrary_Index, new Value(1), "Version library index", "Convert the version library to an uncompressed index file on first load and memory map it on later loads. This makes startup faster and uses less memory.");
+            Config.AddSetting(_Config_MemoryObject_FrameCache, new Value(0), "Memory object frame cache", "Return the same wrapper when a game object is resolved again on the same thread during one frame instead of allocating a new wrapper every time.");
+            Config.AddSetting(_Config_Events_PooledArgs, new Value(0), "Pooled event arguments", "Reuse one arguments instance per thread for hooked events instead of allocating new arguments every time. Only enable if no plugin keeps event arguments after its handler returns.");
         }
 
         /// <summary>
@@ -840,7 +855,27 @@
                         var mainModule = GetMainTargetedModule();
                         var baseOffset = mainModule.BaseAddress.ToUInt64();
                         GameInfo = new GameInfo(baseOffset, Is64Bit);
-                        GameInfo.ReadFromFile(VersionLibraryFile, 0);
+
+                        var indexFile = GetVersionLibraryIndexFile();
+
+                        if ( indexFile == null || !GameInfo.ReadFromIndexFile(indexFile, VersionLibraryFile) )
+                        {
+                            GameInfo.ReadFromFile(VersionLibraryFile, 0);
+
+                            if ( indexFile != null )
+                            {
+                                try
+                                {
+                                    GameInfo.WriteIndexFile(indexFile, VersionLibraryFile);
+                                    Log.AppendLine("Wrote version library index \"" + indexFile.Name + "\".");
+                                }
+                                catch ( Exception ex ) when ( ex is IOException || ex is UnauthorizedAccessException )
+                                {
+                                    Log.AppendLine("Failed to write version library index: " + ex.Message);
+                                }
+                            }
+                        }
+
                         ValidateVersionLibrary();
                     }
                     catch ( Exception ex )
@@ -860,6 +895,22 @@
             }
         }
 
+        /// <summary>
+        ///     Gets the memory mapped index file of version library or null if index is disabled.
+        /// </summary>
+        /// <returns></returns>
+        private static FileInfo GetVersionLibraryIndexFile()
+        {
+            var vl = Config?.GetValue(_Config_VersionLibrary_Index);
+
+            if ( vl != null && vl.TryToInt32(out var enabled) && enabled == 0 )
+            {
+                return null;
+            }
+
+            return new FileInfo(Path.ChangeExtension(VersionLibraryFile.FullName, ".idx"));
+        }
+
         /// <summary>
         ///     The version library file.
         /// </summary>
@@ -985,6 +1036,36 @@
         /// </summary>
         internal const string _Config_Debug_CrashLog_Modules = "Debug.CrashLog.Modules";
 
+        /// <summary>
+        ///     Track the hook context high-water mark per thread or not.
+        /// </summary>
+        internal const string _Config_Debug_Hook_TrackDepth = "Debug.Hook.TrackDepth";
+
+        /// <summary>
+        ///     The interval of writing hook statistics in seconds.
+        /// </summary>
+        internal const string _Config_Debug_Hook_Statistics = "Debug.Hook.Statistics";
+
+        /// <summary>
+        ///     The key that writes performance monitor times.
+        /// </summary>
+        internal const string _Config_Debug_PerformanceMonitor_DumpKey = "Debug.PerformanceMonitor.DumpKey";
+
+        /// <summary>
+        ///     Use memory mapped index of version library or not.
+        /// </summary>
+        internal const string _Config_VersionLibrary_Index = "VersionLibrary.Index";
+
+        /// <summary>
+        ///     Cache memory object wrappers for the current frame or not.
+        /// </summary>
+        internal const string _Config_MemoryObject_FrameCache = "MemoryObject.FrameCache";
+
+        /// <summary>
+        ///     Reuse hooked event arguments or not.
+        /// </summary>
+        internal const string _Config_Events_PooledArgs = "Events.PooledArgs";
+
     #endregion
 
         /// <summary>
@@ -0,0 +1,385 @@
+﻿namespace NetScriptFramework.Tools
+{
+    using System;
+    using System.Buffers.Binary;
+    using System.Collections.Generic;
+    using System.IO;
+    using System.Text;
+
+#region BinaryLogDecoder class
+
+    /// <summary>
+    ///     Turns log files written with <see cref="LogFileFlags.Binary" /> back to text. This only reads the file so it can
+    ///     be used outside of the game.
+    /// </summary>
+    public static class BinaryLogDecoder
+    {
+        /// <summary>
+        ///     The identifier at the start of binary log file.
+        /// </summary>
+        internal const string FileHeader = "NSLG";
+
+        /// <summary>
+        ///     The supported version of binary log file.
+        /// </summary>
+        internal const int FileVersion = 1;
+
+        /// <summary>
+        ///     Reads a binary log file and writes the entries as text. Each line has the local time, the framework tick count in
+        ///     milliseconds and the native thread identifier before the text. A record that was cut off when the game crashed
+        ///     ends the file without an error.
+        /// </summary>
+        /// <param name="binaryPath">The binary file path.</param>
+        /// <param name="textPath">The text file path.</param>
+        /// <param name="threadId">Only write entries of this native thread, 0 to write all threads.</param>
+        /// <param name="from">Only write entries at or after this local time, null to not limit.</param>
+        /// <param name="to">Only write entries at or before this local time, null to not limit.</param>
+        /// <returns>The count of written entries.</returns>
+        /// <exception cref="System.IO.InvalidDataException">File is not a supported binary log file.</exception>
+        public static int Decode(string binaryPath, string textPath, int threadId = 0, DateTime? from = null, DateTime? to = null)
+        {
+            if ( string.IsNullOrEmpty(binaryPath) )
+            {
+                throw new ArgumentNullException(nameof(binaryPath));
+            }
+
+            if ( string.IsNullOrEmpty(textPath) )
+            {
+                throw new ArgumentNullException(nameof(textPath));
+            }
+
+            var formats   = new Dictionary<int, string>();
+            var isNewLine = true;
+            var count     = 0;
+
+            long frequency     = 1;
+            long baseTimestamp = 0;
+            long baseTick      = 0;
+            long baseTime      = 0;
+
+            using ( var file = new BinaryReader(File.OpenRead(binaryPath), Encoding.UTF8) )
+            using ( var output = new StreamWriter(textPath) )
+            {
+                var header = Encoding.ASCII.GetString(file.ReadBytes(4));
+
+                if ( header != FileHeader )
+                {
+                    throw new InvalidDataException("File is not a binary log file!");
+                }
+
+                if ( file.ReadInt32() != FileVersion )
+                {
+                    throw new InvalidDataException("Version of binary log file is not supported!");
+                }
+
+                var length = file.BaseStream.Length;
+
+                try
+                {
+                    while ( file.BaseStream.Position < length )
+                    {
+                        var kind = (LogRecordKind)file.ReadByte();
+
+                        switch ( kind )
+                        {
+                            case LogRecordKind.Session:
+                            {
+                                frequency     = file.ReadInt64();
+                                baseTimestamp = file.ReadInt64();
+                                baseTick      = file.ReadInt64();
+                                baseTime      = file.ReadInt64();
+
+                                if ( frequency <= 0 )
+                                {
+                                    frequency = 1;
+                                }
+
+                                formats.Clear();
+
+                                if ( !isNewLine )
+                                {
+                                    output.WriteLine();
+                                    isNewLine = true;
+                                }
+
+                                break;
+                            }
+
+                            case LogRecordKind.Format:
+                            {
+                                var id = file.ReadInt32();
+                                formats[id] = file.ReadString();
+
+                                break;
+                            }
+
+                            case LogRecordKind.Entry:
+                            case LogRecordKind.Text:
+                            {
+                                var thread    = file.ReadInt32();
+                                var timestamp = file.ReadInt64();
+                                var text      = string.Empty;
+                                var newLine   = true;
+
+                                if ( kind == LogRecordKind.Entry )
+                                {
+                                    var id   = file.ReadInt32();
+                                    var size = file.ReadInt32();
+
+                                    if ( size < 0 )
+                                    {
+                                        throw new InvalidDataException("Invalid entry size " + size + " in binary log file at " + (file.BaseStream.Position - 4) + "!");
+                                    }
+
+                                    var data = file.ReadBytes(size);
+
+                                    // Record was cut off, ReadBytes returns what is left instead of throwing.
+                                    if ( data.Length != size )
+                                    {
+                                        throw new EndOfStreamException();
+                                    }
+
+                                    if ( !formats.TryGetValue(id, out var format) )
+                                    {
+                                        format = "(unknown format " + id + ")";
+                                    }
+
+                                    text = Format(format, data);
+                                }
+                                else
+                                {
+                                    text    = file.ReadString();
+                                    newLine = file.ReadBoolean();
+                                }
+
+                                var seconds = (double)(timestamp - baseTimestamp) / frequency;
+                                var time    = new DateTime(baseTime + (long)(seconds * TimeSpan.TicksPerSecond));
+
+                                if ( (threadId != 0 && thread != threadId) || (from.HasValue && time < from.Value) || (to.HasValue && time > to.Value) )
+                                {
+                                    continue;
+                                }
+
+                                if ( isNewLine )
+                                {
+                                    output.Write(string.Format("[{0}] [{1:0.000}] [{2}] ", time.ToLogTimestampString(), baseTick + seconds * 1000.0, thread));
+                                }
+
+                                if ( newLine )
+                                {
+                                    output.WriteLine(text);
+                                }
+                                else
+                                {
+                                    output.Write(text);
+                                }
+
+                                isNewLine = newLine || text.EndsWith("\n") || text.EndsWith("\r");
+                                count++;
+
+                                break;
+                            }
+
+                            default: throw new InvalidDataException("Unknown record " + (int)kind + " in binary log file at " + (file.BaseStream.Position - 1) + "!");
+                        }
+                    }
+                }
+                catch ( EndOfStreamException ) { }
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        ///     Formats the text of an entry. This never throws on a bad format since it may be called while logging.
+        /// </summary>
+        /// <param name="format">The format string.</param>
+        /// <param name="data">The argument data.</param>
+        /// <returns></returns>
+        internal static string Format(string format, ReadOnlySpan<byte> data)
+        {
+            var args = ReadArguments(data);
+
+            try { return string.Format(format, args); }
+            catch ( FormatException )
+            {
+                var bld = new StringBuilder(format);
+
+                foreach ( var x in args )
+                {
+                    bld.Append(' ');
+                    bld.Append(x);
+                }
+
+                return bld.ToString();
+            }
+        }
+
+        /// <summary>
+        ///     Reads the arguments of an entry.
+        /// </summary>
+        /// <param name="data">The argument data.</param>
+        /// <returns></returns>
+        private static object[] ReadArguments(ReadOnlySpan<byte> data)
+        {
+            if ( data.Length == 0 )
+            {
+                return new object[0];
+            }
+
+            var args     = new object[data[0]];
+            var position = 1;
+
+            for ( var i = 0; i < args.Length; i++ )
+            {
+                var type  = (LogArgumentType)data[position++];
+                var value = data.Slice(position);
+
+                switch ( type )
+                {
+                    case LogArgumentType.Int32:
+                        args[i]   = BinaryPrimitives.ReadInt32LittleEndian(value);
+                        position += 4;
+                        break;
+
+                    case LogArgumentType.UInt32:
+                        args[i]   = BinaryPrimitives.ReadUInt32LittleEndian(value);
+                        position += 4;
+                        break;
+
+                    case LogArgumentType.Int64:
+                        args[i]   = BinaryPrimitives.ReadInt64LittleEndian(value);
+                        position += 8;
+                        break;
+
+                    case LogArgumentType.UInt64:
+                        args[i]   = BinaryPrimitives.ReadUInt64LittleEndian(value);
+                        position += 8;
+                        break;
+
+                    case LogArgumentType.Single:
+                        args[i]   = BitConverter.Int32BitsToSingle(BinaryPrimitives.ReadInt32LittleEndian(value));
+                        position += 4;
+                        break;
+
+                    case LogArgumentType.Double:
+                        args[i]   = BitConverter.Int64BitsToDouble(BinaryPrimitives.ReadInt64LittleEndian(value));
+                        position += 8;
+                        break;
+
+                    case LogArgumentType.Boolean:
+                        args[i]   = value[0] != 0;
+                        position += 1;
+                        break;
+
+                    case LogArgumentType.Pointer:
+                        args[i]   = BinaryPrimitives.ReadInt64LittleEndian(value).ToString("X");
+                        position += 8;
+                        break;
+
+                    case LogArgumentType.String:
+                    {
+                        var count = BinaryPrimitives.ReadInt32LittleEndian(value);
+                        position += 4;
+
+                        if ( count >= 0 )
+                        {
+                            args[i]   = Encoding.UTF8.GetString(value.Slice(4, count));
+                            position += count;
+                        }
+                        else { args[i] = "null"; }
+
+                        break;
+                    }
+
+                    default: throw new InvalidDataException("Unknown argument type " + (int)type + " in log entry!");
+                }
+            }
+
+            return args;
+        }
+    }
+
+#endregion
+
+#region Binary log enums
+
+    /// <summary>
+    ///     The kinds of records in binary log file.
+    /// </summary>
+    internal enum LogRecordKind : byte
+    {
+        /// <summary>
+        ///     Log file was opened. Has the counter frequency and the base times, previous formats are no longer valid.
+        /// </summary>
+        Session = 1,
+
+        /// <summary>
+        ///     Defines the format string of an identifier.
+        /// </summary>
+        Format = 2,
+
+        /// <summary>
+        ///     Entry with a format identifier and arguments.
+        /// </summary>
+        Entry = 3,
+
+        /// <summary>
+        ///     Text written with <see cref="LogFile.Append(string)" /> or <see cref="LogFile.AppendLine" />.
+        /// </summary>
+        Text = 4
+    }
+
+    /// <summary>
+    ///     The types of arguments in a log entry.
+    /// </summary>
+    internal enum LogArgumentType : byte
+    {
+        /// <summary>
+        ///     32-bit signed integer.
+        /// </summary>
+        Int32 = 1,
+
+        /// <summary>
+        ///     32-bit unsigned integer.
+        /// </summary>
+        UInt32 = 2,
+
+        /// <summary>
+        ///     64-bit signed integer.
+        /// </summary>
+        Int64 = 3,
+
+        /// <summary>
+        ///     64-bit unsigned integer.
+        /// </summary>
+        UInt64 = 4,
+
+        /// <summary>
+        ///     Single precision floating point value.
+        /// </summary>
+        Single = 5,
+
+        /// <summary>
+        ///     Double precision floating point value.
+        /// </summary>
+        Double = 6,
+
+        /// <summary>
+        ///     Boolean value stored as one byte.
+        /// </summary>
+        Boolean = 7,
+
+        /// <summary>
+        ///     Address, written as hexadecimal when decoded.
+        /// </summary>
+        Pointer = 8,
+
+        /// <summary>
+        ///     UTF-8 string with byte length before it, negative length for null.
+        /// </summary>
+        String = 9
+    }
+
+#endregion
+}
@@ -0,0 +1,35 @@
+﻿namespace NetScriptFramework.Tools
+{
+    using System;
+
+#region DateTimeStringConverter class
+
+    /// <summary>
+    ///     Helper function to convert date time to short string.
+    /// </summary>
+    public static class DateTimeStringConverter
+    {
+        /// <summary>
+        ///     The month names for timestamp string.
+        /// </summary>
+        private static readonly string[] Months = { "Nul", "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+        /// <summary>
+        ///     Convert this date time instance to a short string for log file (or other use).
+        /// </summary>
+        /// <param name="t">The time.</param>
+        /// <param name="milliseconds">if set to <c>true</c> then display milliseconds in the string.</param>
+        /// <returns></returns>
+        public static string ToLogTimestampString(this DateTime t, bool milliseconds = true)
+        {
+            if ( milliseconds )
+            {
+                return string.Format("{0:00} {1} {2} {3:00}:{4:00}:{5:00}.{6:000}", t.Day, Months[t.Month], t.Year, t.Hour, t.Minute, t.Second, t.Millisecond);
+            }
+
+            return string.Format("{0:00} {1} {2} {3:00}:{4:00}:{5:00}", t.Day, Months[t.Month], t.Year, t.Hour, t.Minute, t.Second);
+        }
+    }
+
+#endregion
+}
@@ -1,6 +1,7 @@
 ﻿namespace NetScriptFramework.Tools._Internal
 {
     using System;
+    using System.Collections.Generic;
     using System.Diagnostics;
     using System.Linq;
     using System.Runtime.InteropServices;
@@ -135,6 +136,100 @@
             }
         }
 
+        /// <summary>
+        ///     Opens all threads in current process except the executing thread so that they can be suspended, resumed and their
+        ///     context read without allocating anything while they are suspended.
+        /// </summary>
+        /// <returns></returns>
+        internal static IntPtr[] OpenThreadsInCurrentProcess()
+        {
+            var threads = Process.GetCurrentProcess().Threads;
+            var cur     = GetCurrentThreadId();
+            var handles = new List<IntPtr>(threads.Count);
+
+            for ( var i = 0; i < threads.Count; i++ )
+            {
+                var t = threads[i];
+
+                if ( t.Id == cur )
+                {
+                    continue;
+                }
+
+                var handle = OpenThread(0xA, false, t.Id);
+
+                if ( handle != IntPtr.Zero )
+                {
+                    handles.Add(handle);
+                }
+            }
+
+            return handles.ToArray();
+        }
+
+        /// <summary>
+        ///     Suspends the threads opened with <see cref="OpenThreadsInCurrentProcess" />.
+        /// </summary>
+        /// <param name="handles">The thread handles.</param>
+        internal static void SuspendThreads(IntPtr[] handles)
+        {
+            for ( var i = 0; i < handles.Length; i++ )
+            {
+                SuspendThread(handles[i]);
+            }
+        }
+
+        /// <summary>
+        ///     Resumes the threads opened with <see cref="OpenThreadsInCurrentProcess" />.
+        /// </summary>
+        /// <param name="handles">The thread handles.</param>
+        internal static void ResumeThreads(IntPtr[] handles)
+        {
+            for ( var i = 0; i < handles.Length; i++ )
+            {
+                ResumeThread(handles[i]);
+            }
+        }
+
+        /// <summary>
+        ///     Closes the threads opened with <see cref="OpenThreadsInCurrentProcess" />.
+        /// </summary>
+        /// <param name="handles">The thread handles.</param>
+        internal static void CloseThreads(IntPtr[] handles)
+        {
+            for ( var i = 0; i < handles.Length; i++ )
+            {
+                CloseHandle(handles[i]);
+            }
+        }
+
+        /// <summary>
+        ///     Allocates a buffer that can hold a CONTEXT structure for <see cref="GetInstructionPointers" />. Free it with
+        ///     <see cref="Marshal.FreeHGlobal" />.
+        /// </summary>
+        /// <returns></returns>
+        internal static IntPtr AllocateContext() => Marshal.AllocHGlobal(ContextSize + 16);
+
+        /// <summary>
+        ///     Gets the instruction pointers of suspended threads without allocating anything. Threads whose context can't be read
+        ///     are set to zero.
+        /// </summary>
+        /// <param name="handles">The thread handles.</param>
+        /// <param name="buffer">The buffer from <see cref="AllocateContext" />.</param>
+        /// <param name="result">The result, must be at least as long as the handles.</param>
+        internal static void GetInstructionPointers(IntPtr[] handles, IntPtr buffer, long[] result)
+        {
+            // CONTEXT must be 16 byte aligned.
+            var context = new IntPtr((buffer.ToInt64() + 15) & ~15L);
+
+            for ( var i = 0; i < handles.Length; i++ )
+            {
+                Marshal.WriteInt32(context, ContextFlagsOffset, ContextControl);
+
+                result[i] = GetThreadContext(handles[i], context) ? Marshal.ReadInt64(context, ContextRipOffset) : 0;
+            }
+        }
+
         /// <summary>
         ///     Exits the process.
         /// </summary>
@@ -156,6 +251,26 @@
 
     #region API calls
 
+        /// <summary>
+        ///     The size of x64 CONTEXT structure.
+        /// </summary>
+        private const int ContextSize = 0x4D0;
+
+        /// <summary>
+        ///     The offset of ContextFlags in x64 CONTEXT structure.
+        /// </summary>
+        private const int ContextFlagsOffset = 0x30;
+
+        /// <summary>
+        ///     The offset of Rip in x64 CONTEXT structure.
+        /// </summary>
+        private const int ContextRipOffset = 0xF8;
+
+        /// <summary>
+        ///     CONTEXT_AMD64 | CONTEXT_CONTROL.
+        /// </summary>
+        private const int ContextControl = 0x00100001;
+
         [ DllImport("kernel32.dll", SetLastError = true) ]
         private static extern bool CloseHandle(IntPtr hObject);
 
@@ -165,6 +280,8 @@
 
         [ DllImport("kernel32.dll") ] private static extern uint ResumeThread(IntPtr hThread);
 
+        [ DllImport("kernel32.dll") ] private static extern bool GetThreadContext(IntPtr hThread, IntPtr lpContext);
+
         [ DllImport("kernel32.dll") ] internal static extern int GetCurrentThreadId();
 
     #endregion
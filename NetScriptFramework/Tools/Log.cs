@@ -2,13 +2,20 @@
 {
     using System;
     using System.Collections.Generic;
+    using System.Diagnostics;
+    using System.Buffers.Binary;
     using System.IO;
+    using System.Runtime.InteropServices;
     using System.Text;
+    using System.Threading;
 
 #region LogFile class
 
     /// <summary>
-    ///     Implement helper class to write log file using default settings. Log file methods are thread-safe.
+    ///     Implement helper class to write log file using default settings. Log file methods are thread-safe. Written text is
+    ///     queued and written to file by a background thread, use <see cref="Flush" /> to write queued text immediately.
+    ///     With <see cref="LogFileFlags.Binary" /> entries are written as compact records that can be turned back to text
+    ///     with <see cref="BinaryLogDecoder" />.
     /// </summary>
     /// <seealso cref="System.IDisposable" />
     public sealed class LogFile : IDisposable
@@ -61,7 +68,12 @@
 
             if ( (this.Flags & LogFileFlags.DelayedOpen) == LogFileFlags.None )
             {
-                this.OpenFile();
+                lock ( this.Locker )
+                {
+                    this.OpenFile();
+                }
+
+                this.Register();
             }
         }
 
@@ -101,9 +113,14 @@
         private string Path { get; } = "";
 
         /// <summary>
-        ///     Closes this instance and the underlying file if it is open.
+        ///     Closes this instance and the underlying file if it is open. Queued text is written before closing.
         /// </summary>
-        public void Close() => this.CloseFile();
+        public void Close() => this.CloseFile(Timeout.Infinite, true);
+
+        /// <summary>
+        ///     Writes all queued text to file on the calling thread and flushes the file.
+        /// </summary>
+        public void Flush() => this.Drain(Timeout.Infinite, true);
 
         /// <summary>
         ///     Appends the specified text to log file without writing a newline at the end. This will re-open the file if it is
@@ -119,26 +136,7 @@
                 throw new ArgumentNullException("text");
             }
 
-            lock ( this.Locker )
-            {
-                // Append timestamp if newline.
-                if ( this.isNewLine && (this.Flags & LogFileFlags.IncludeTimestampInLine) != LogFileFlags.None )
-                {
-                    text = "[" + DateTime.Now.ToLogTimestampString() + "] " + text;
-                }
-
-                // Write to file.
-                this.OpenFile();
-                this.file.Write(text);
-
-                if ( (this.Flags & LogFileFlags.AutoFlush) != LogFileFlags.None )
-                {
-                    this.file.Flush();
-                }
-
-                // Set newline status.
-                this.isNewLine = text.EndsWith("\n") || text.EndsWith("\r");
-            }
+            this.Enqueue(LogRecordKind.Text, 0, text, false, default);
         }
 
         /// <summary>
@@ -261,26 +259,84 @@
                 throw new ArgumentNullException("text");
             }
 
-            lock ( this.Locker )
+            this.Enqueue(LogRecordKind.Text, 0, text, true, default);
+        }
+
+        /// <summary>
+        ///     Registers a format string for entries written with <see cref="Begin" />. Registering the same format again
+        ///     returns the same identifier. The format uses the same placeholders as <see cref="string.Format(string, object[])" />.
+        /// </summary>
+        /// <param name="format">The format string.</param>
+        /// <returns>The identifier of format.</returns>
+        /// <exception cref="System.ArgumentNullException">format</exception>
+        public int RegisterFormat(string format)
+        {
+            if ( format == null )
+            {
+                throw new ArgumentNullException("format");
+            }
+
+            lock ( this.FormatLocker )
             {
-                // Append timestamp if newline.
-                if ( this.isNewLine && (this.Flags & LogFileFlags.IncludeTimestampInLine) != LogFileFlags.None )
+                if ( this.FormatIds.TryGetValue(format, out var id) )
                 {
-                    text = "[" + DateTime.Now.ToLogTimestampString() + "] " + text;
+                    return id;
                 }
 
-                // Write to file.
-                this.OpenFile();
-                this.file.WriteLine(text);
+                var formats = this.Formats;
+                id = formats.Length;
 
-                if ( (this.Flags & LogFileFlags.AutoFlush) != LogFileFlags.None )
+                var copy = new string[id + 1];
+                Array.Copy(formats, copy, id);
+                copy[id] = format;
+
+                this.FormatIds[format] = id;
+                Volatile.Write(ref this.Formats, copy);
+
+                // Definition must be queued before anyone can use the identifier.
+                if ( (this.Flags & LogFileFlags.Binary) != LogFileFlags.None )
                 {
-                    this.file.Flush();
+                    this.Enqueue(LogRecordKind.Format, id, format, false, default);
                 }
 
-                // Set newline status.
-                this.isNewLine = true;
+                return id;
+            }
+        }
+
+        /// <summary>
+        ///     Begins a log entry with a registered format. Add arguments with <see cref="LogEntry.Arg(int)" /> and call
+        ///     <see cref="LogEntry.End" /> to write the entry as a line. In binary mode the arguments are stored as they are and
+        ///     the text is only formatted when decoding the file, otherwise the text is formatted when the entry ends. Only one
+        ///     entry can be built at a time on each thread.
+        /// </summary>
+        /// <param name="formatId">The format identifier returned by <see cref="RegisterFormat" />.</param>
+        /// <returns></returns>
+        /// <exception cref="System.ArgumentOutOfRangeException">formatId</exception>
+        public LogEntry Begin(int formatId)
+        {
+            if ( formatId < 0 || formatId >= Volatile.Read(ref this.Formats).Length )
+            {
+                throw new ArgumentOutOfRangeException("formatId");
+            }
+
+            return new LogEntry(this, formatId);
+        }
+
+        /// <summary>
+        ///     Ends the log entry.
+        /// </summary>
+        /// <param name="formatId">The format identifier.</param>
+        /// <param name="data">The argument data.</param>
+        internal void EndEntry(int formatId, ReadOnlySpan<byte> data)
+        {
+            if ( (this.Flags & LogFileFlags.Binary) != LogFileFlags.None )
+            {
+                this.Enqueue(LogRecordKind.Entry, formatId, null, true, data);
+                return;
             }
+
+            var text = BinaryLogDecoder.Format(Volatile.Read(ref this.Formats)[formatId], data);
+            this.Enqueue(LogRecordKind.Text, 0, text, true, default);
         }
 
     #endregion
@@ -288,10 +344,389 @@
     #region Internal members
 
         /// <summary>
-        ///     The locker for log file.
+        ///     The count of records the queue of each log file can hold, must be a power of two. When the queue is full the
+        ///     appending thread writes the queued records itself.
+        /// </summary>
+        private const int QueueCapacity = 4096;
+
+        /// <summary>
+        ///     How long the writer thread waits for new records in milliseconds before checking again.
+        /// </summary>
+        private const int WriterInterval = 100;
+
+        /// <summary>
+        ///     How long to wait for the writer in milliseconds when closing files on shutdown. Threads may be suspended at this
+        ///     point so we can't wait forever.
+        /// </summary>
+        private const int ShutdownTimeout = 1000;
+
+        /// <summary>
+        ///     Queued text of log file.
+        /// </summary>
+        private struct LogRecord
+        {
+            /// <summary>
+            ///     The sequence number of slot, tells whether the slot is free or written.
+            /// </summary>
+            internal long Sequence;
+
+            /// <summary>
+            ///     The raw performance counter value when the record was appended.
+            /// </summary>
+            internal long Timestamp;
+
+            /// <summary>
+            ///     The text.
+            /// </summary>
+            internal string Text;
+
+            /// <summary>
+            ///     Write a newline after the text.
+            /// </summary>
+            internal bool NewLine;
+
+            /// <summary>
+            ///     The kind of record.
+            /// </summary>
+            internal LogRecordKind Kind;
+
+            /// <summary>
+            ///     The format identifier of entry or format definition.
+            /// </summary>
+            internal int Id;
+
+            /// <summary>
+            ///     The native thread identifier of appending thread.
+            /// </summary>
+            internal int ThreadId;
+
+            /// <summary>
+            ///     The argument data of entry. The buffer stays with the slot and is reused.
+            /// </summary>
+            internal byte[] Data;
+
+            /// <summary>
+            ///     The used length of <see cref="Data" />.
+            /// </summary>
+            internal int Length;
+        }
+
+        /// <summary>
+        ///     The locker for log file. This is held while writing queued records so only one thread writes at a time.
         /// </summary>
         private readonly object Locker = new object();
 
+        /// <summary>
+        ///     The queued records. Any thread may append, only the thread holding <see cref="Locker" /> removes.
+        /// </summary>
+        private readonly LogRecord[] Records = CreateRecords();
+
+        /// <summary>
+        ///     The position where next record is appended.
+        /// </summary>
+        private long EnqueuePosition;
+
+        /// <summary>
+        ///     The position where next record is removed.
+        /// </summary>
+        private long DequeuePosition;
+
+        /// <summary>
+        ///     Is this log file in the list of files the writer thread writes.
+        /// </summary>
+        private bool IsRegistered;
+
+        /// <summary>
+        ///     The registered formats. The array is replaced when a format is added so it can be read without locking.
+        /// </summary>
+        private string[] Formats = new string[0];
+
+        /// <summary>
+        ///     The identifiers of registered formats.
+        /// </summary>
+        private readonly Dictionary<string, int> FormatIds = new Dictionary<string, int>();
+
+        /// <summary>
+        ///     The locker for registering formats.
+        /// </summary>
+        private readonly object FormatLocker = new object();
+
+        /// <summary>
+        ///     The cached native identifier of current thread.
+        /// </summary>
+        [ ThreadStatic ] private static int CurrentThreadId;
+
+        /// <summary>
+        ///     Creates the record queue.
+        /// </summary>
+        /// <returns></returns>
+        private static LogRecord[] CreateRecords()
+        {
+            var records = new LogRecord[QueueCapacity];
+
+            for ( var i = 0; i < records.Length; i++ )
+            {
+                records[i].Sequence = i;
+            }
+
+            return records;
+        }
+
+        /// <summary>
+        ///     Appends a record to the queue and makes sure the writer thread will write it.
+        /// </summary>
+        /// <param name="kind">The kind of record.</param>
+        /// <param name="id">The format identifier.</param>
+        /// <param name="text">The text.</param>
+        /// <param name="newLine">Write a newline after the text.</param>
+        /// <param name="data">The argument data.</param>
+        private void Enqueue(LogRecordKind kind, int id, string text, bool newLine, ReadOnlySpan<byte> data)
+        {
+            var timestamp = Stopwatch.GetTimestamp();
+            var threadId  = CurrentThreadId;
+
+            if ( threadId == 0 )
+            {
+                threadId        = Memory.GetCurrentNativeThreadId();
+                CurrentThreadId = threadId;
+            }
+
+            while ( !this.TryEnqueue(timestamp, kind, id, threadId, text, newLine, data) )
+            {
+                // Queue is full, writer can't keep up so write on this thread instead.
+                this.Drain(Timeout.Infinite, false);
+            }
+
+            if ( !Volatile.Read(ref this.IsRegistered) )
+            {
+                this.Register();
+            }
+
+            if ( Interlocked.Exchange(ref WriterSignaled, 1) == 0 )
+            {
+                WriterWake.Set();
+            }
+        }
+
+        /// <summary>
+        ///     Tries to append a record to the queue.
+        /// </summary>
+        /// <param name="timestamp">The timestamp.</param>
+        /// <param name="kind">The kind of record.</param>
+        /// <param name="id">The format identifier.</param>
+        /// <param name="threadId">The native thread identifier.</param>
+        /// <param name="text">The text.</param>
+        /// <param name="newLine">Write a newline after the text.</param>
+        /// <param name="data">The argument data.</param>
+        /// <returns></returns>
+        private bool TryEnqueue(long timestamp, LogRecordKind kind, int id, int threadId, string text, bool newLine, ReadOnlySpan<byte> data)
+        {
+            var records = this.Records;
+
+            while ( true )
+            {
+                var     position = Volatile.Read(ref this.EnqueuePosition);
+                ref var record   = ref records[position & (QueueCapacity - 1)];
+                var     sequence = Volatile.Read(ref record.Sequence);
+
+                if ( sequence == position )
+                {
+                    if ( Interlocked.CompareExchange(ref this.EnqueuePosition, position + 1, position) != position )
+                    {
+                        continue;
+                    }
+
+                    if ( data.Length != 0 && (record.Data == null || record.Data.Length < data.Length) )
+                    {
+                        record.Data = new byte[Math.Max(data.Length, 64)];
+                    }
+
+                    data.CopyTo(record.Data);
+
+                    record.Timestamp = timestamp;
+                    record.Text      = text;
+                    record.NewLine   = newLine;
+                    record.Kind      = kind;
+                    record.Id        = id;
+                    record.ThreadId  = threadId;
+                    record.Length    = data.Length;
+                    Volatile.Write(ref record.Sequence, position + 1);
+                    return true;
+                }
+
+                if ( sequence < position )
+                {
+                    return false;
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Writes all queued records to file.
+        /// </summary>
+        /// <param name="timeout">How long to wait for another thread that is writing, in milliseconds.</param>
+        /// <param name="forceFlush">Flush the file even if auto flush is not set.</param>
+        /// <returns></returns>
+        private bool Drain(int timeout, bool forceFlush)
+        {
+            if ( !Monitor.TryEnter(this.Locker, timeout) )
+            {
+                return false;
+            }
+
+            try
+            {
+                var records = this.Records;
+                var wrote   = false;
+
+                while ( true )
+                {
+                    var     position = this.DequeuePosition;
+                    ref var record   = ref records[position & (QueueCapacity - 1)];
+
+                    if ( Volatile.Read(ref record.Sequence) != position + 1 )
+                    {
+                        break;
+                    }
+
+                    // Record is released even if writing fails, otherwise the queue would be stuck.
+                    try
+                    {
+                        this.OpenFile();
+                        this.Write(ref record);
+                        wrote = true;
+                    }
+                    finally
+                    {
+                        record.Text = null;
+                        Volatile.Write(ref record.Sequence, position + QueueCapacity);
+                        this.DequeuePosition = position + 1;
+                    }
+                }
+
+                if ( forceFlush || (wrote && (this.Flags & LogFileFlags.AutoFlush) != LogFileFlags.None) )
+                {
+                    this.file?.Flush();
+                    this.binaryFile?.Flush();
+                }
+            }
+            finally { Monitor.Exit(this.Locker); }
+
+            return true;
+        }
+
+        /// <summary>
+        ///     Writes a record to the opened file. Must hold <see cref="Locker" />.
+        /// </summary>
+        /// <param name="record">The record.</param>
+        private void Write(ref LogRecord record)
+        {
+            if ( this.binaryFile != null )
+            {
+                this.WriteBinary(ref record);
+                return;
+            }
+
+            // Text file only has text records.
+            if ( record.Kind != LogRecordKind.Text )
+            {
+                return;
+            }
+
+            var text = record.Text;
+
+            // Append timestamp if newline.
+            if ( this.isNewLine && (this.Flags & LogFileFlags.IncludeTimestampInLine) != LogFileFlags.None )
+            {
+                this.file.Write('[');
+                this.file.Write(GetTime(record.Timestamp).ToLogTimestampString());
+                this.file.Write("] ");
+            }
+
+            if ( record.NewLine )
+            {
+                this.file.WriteLine(text);
+            }
+            else
+            {
+                this.file.Write(text);
+            }
+
+            // Set newline status.
+            this.isNewLine = record.NewLine || text.EndsWith("\n") || text.EndsWith("\r");
+        }
+
+        /// <summary>
+        ///     Writes a record to the opened binary file. Must hold <see cref="Locker" />.
+        /// </summary>
+        /// <param name="record">The record.</param>
+        private void WriteBinary(ref LogRecord record)
+        {
+            var w = this.binaryFile;
+            w.Write((byte)record.Kind);
+
+            switch ( record.Kind )
+            {
+                case LogRecordKind.Format:
+                    w.Write(record.Id);
+                    w.Write(record.Text);
+                    break;
+
+                case LogRecordKind.Entry:
+                    w.Write(record.ThreadId);
+                    w.Write(record.Timestamp);
+                    w.Write(record.Id);
+                    w.Write(record.Length);
+                    w.Write(record.Data, 0, record.Length);
+                    break;
+
+                case LogRecordKind.Text:
+                    w.Write(record.ThreadId);
+                    w.Write(record.Timestamp);
+                    w.Write(record.Text);
+                    w.Write(record.NewLine);
+                    break;
+            }
+        }
+
+        /// <summary>
+        ///     Writes the session record and all registered formats to the opened binary file. Must hold
+        ///     <see cref="Locker" />.
+        /// </summary>
+        private void WriteSession()
+        {
+            var w = this.binaryFile;
+
+            if ( w.BaseStream.Length == 0 )
+            {
+                w.Write(Encoding.ASCII.GetBytes(BinaryLogDecoder.FileHeader));
+                w.Write(BinaryLogDecoder.FileVersion);
+            }
+
+            w.Write((byte)LogRecordKind.Session);
+            w.Write(Stopwatch.Frequency);
+            w.Write(BaseTimestamp);
+            w.Write(BaseTick);
+            w.Write(BaseTime);
+
+            // Decoder forgets formats on each session, formats registered while the file was closed are also written here.
+            var formats = Volatile.Read(ref this.Formats);
+
+            for ( var i = 0; i < formats.Length; i++ )
+            {
+                w.Write((byte)LogRecordKind.Format);
+                w.Write(i);
+                w.Write(formats[i]);
+            }
+        }
+
+        /// <summary>
+        ///     Converts a raw performance counter value to local time.
+        /// </summary>
+        /// <param name="timestamp">The timestamp.</param>
+        /// <returns></returns>
+        private static DateTime GetTime(long timestamp) => new DateTime(BaseTime + (long)((timestamp - BaseTimestamp) * TicksPerTimestamp));
+
         /// <summary>
         ///     Generate file path with current settings.
         /// </summary>
@@ -318,7 +753,7 @@
                 strFile.Append("." + t.Year + "-" + t.Month.ToString("00") + "-" + t.Day.ToString("00") + "-" + t.Hour.ToString("00") + "-" + t.Minute.ToString("00") + "-" + t.Second.ToString("00"));
             }
 
-            strFile.Append(".txt");
+            strFile.Append((this.Flags & LogFileFlags.Binary) != LogFileFlags.None ? ".bin" : ".txt");
 
             var fullPath = strFile.ToString();
 
@@ -335,50 +770,145 @@
         /// </summary>
         private StreamWriter file;
 
+        /// <summary>
+        ///     The opened file in binary mode.
+        /// </summary>
+        private BinaryWriter binaryFile;
+
         /// <summary>
         ///     Is log currently at a new line?
         /// </summary>
         private bool isNewLine = true;
 
         /// <summary>
-        ///     Opens the file for writing.
+        ///     Opens the file for writing. Must hold <see cref="Locker" />.
         /// </summary>
         private void OpenFile()
         {
-            lock ( this.Locker )
+            if ( this.file != null || this.binaryFile != null )
             {
-                if ( this.file != null )
+                return;
+            }
+
+            var append = (this.Flags & LogFileFlags.AppendFile) != LogFileFlags.None;
+
+            if ( (this.Flags & LogFileFlags.Binary) == LogFileFlags.None )
+            {
+                this.file = new StreamWriter(this.GenerateFilePath(), append);
+                return;
+            }
+
+            var stream = new FileStream(this.GenerateFilePath(), append ? FileMode.Append : FileMode.Create, FileAccess.Write, FileShare.Read);
+            this.binaryFile = new BinaryWriter(stream, Encoding.UTF8);
+            this.WriteSession();
+        }
+
+        /// <summary>
+        ///     Adds this log file to the list of files the writer thread writes.
+        /// </summary>
+        private void Register()
+        {
+            lock ( AllLocker )
+            {
+                if ( this.IsRegistered )
                 {
                     return;
                 }
 
-                this.file = new StreamWriter(this.GenerateFilePath(), (this.Flags & LogFileFlags.AppendFile) != LogFileFlags.None);
+                All.AddLast(this);
+                AllArray = null;
+                Volatile.Write(ref this.IsRegistered, true);
 
-                lock ( AllLocker ) { All.AddLast(this); }
+                if ( WriterThread == null )
+                {
+                    WriterThread = new Thread(RunWriterThread)
+                    {
+                        IsBackground = true,
+                        Name         = "NetScriptFramework.Log"
+                    };
+
+                    WriterThread.Start();
+                }
             }
         }
 
         /// <summary>
-        ///     Closes the file.
+        ///     Writes queued records and closes the file.
         /// </summary>
-        private void CloseFile()
+        /// <param name="timeout">How long to wait for another thread that is writing, in milliseconds.</param>
+        /// <param name="reopen">Register the file again if records were appended while closing.</param>
+        private void CloseFile(int timeout, bool reopen)
         {
-            lock ( this.Locker )
+            lock ( AllLocker )
             {
-                if ( this.file == null )
+                if ( !Monitor.TryEnter(this.Locker, timeout) )
                 {
+                    // Writing thread is stuck, leave the file as it is.
+                    All.Remove(this);
+                    AllArray = null;
+                    Volatile.Write(ref this.IsRegistered, false);
                     return;
                 }
 
-                this.file.Close();
-                this.file = null;
+                try
+                {
+                    this.Drain(0, false);
+
+                    if ( this.file != null )
+                    {
+                        this.file.Close();
+                        this.file = null;
+                    }
+
+                    if ( this.binaryFile != null )
+                    {
+                        this.binaryFile.Close();
+                        this.binaryFile = null;
+                    }
+
+                    All.Remove(this);
+                    AllArray = null;
+                    Volatile.Write(ref this.IsRegistered, false);
+                }
+                finally { Monitor.Exit(this.Locker); }
+            }
+
+            if ( !reopen )
+            {
+                return;
+            }
+
+            // A record may have been appended after draining by a thread that still saw this file as registered.
+            Interlocked.MemoryBarrier();
+
+            if ( Volatile.Read(ref this.EnqueuePosition) != this.DequeuePosition )
+            {
+                this.Register();
+            }
+        }
+
+        /// <summary>
+        ///     Writes queued records of all log files on the calling thread. This is used before a crash or shutdown so that
+        ///     no records are lost when the process ends.
+        /// </summary>
+        internal static void FlushAll()
+        {
+            LogFile[] all;
+
+            lock ( AllLocker )
+            {
+                all = GetAllArray();
+            }
 
-                lock ( AllLocker ) { All.Remove(this); }
+            foreach ( var x in all )
+            {
+                try { x.Drain(ShutdownTimeout, true); }
+                catch ( IOException ) { }
             }
         }
 
         /// <summary>
-        ///     Closes all log files.
+        ///     Closes all log files. Queued records are written first.
         /// </summary>
         internal static void CloseAll()
         {
@@ -386,52 +916,321 @@
             {
                 while ( All.Count != 0 )
                 {
-                    All.First.Value.CloseFile();
+                    All.First.Value.CloseFile(ShutdownTimeout, false);
                 }
             }
         }
 
         /// <summary>
-        ///     All opened log files, we use this to make sure all log files are closed at the end.
+        ///     Gets the registered log files as an array. Must hold <see cref="AllLocker" />.
+        /// </summary>
+        /// <returns></returns>
+        private static LogFile[] GetAllArray()
+        {
+            if ( AllArray == null )
+            {
+                AllArray = new LogFile[All.Count];
+                All.CopyTo(AllArray, 0);
+            }
+
+            return AllArray;
+        }
+
+        /// <summary>
+        ///     Writes queued records of all log files in the background.
+        /// </summary>
+        private static void RunWriterThread()
+        {
+            while ( true )
+            {
+                WriterWake.WaitOne(WriterInterval);
+                Interlocked.Exchange(ref WriterSignaled, 0);
+
+                LogFile[] all;
+
+                lock ( AllLocker )
+                {
+                    all = GetAllArray();
+                }
+
+                foreach ( var x in all )
+                {
+                    // Nowhere to report failure of writing the log, the records are dropped.
+                    try { x.Drain(Timeout.Infinite, false); }
+                    catch ( Exception ) { }
+                }
+            }
+        }
+
+        /// <summary>
+        ///     All log files that are opened or have queued records, we use this to make sure all log files are written and
+        ///     closed at the end.
         /// </summary>
         private static readonly LinkedList<LogFile> All = new LinkedList<LogFile>();
 
+        /// <summary>
+        ///     The cached array of <see cref="All" />, this is null if the list has changed.
+        /// </summary>
+        private static LogFile[] AllArray;
+
         /// <summary>
         ///     Locker for all log files list.
         /// </summary>
         private static readonly object AllLocker = new object();
 
+        /// <summary>
+        ///     The thread that writes queued records.
+        /// </summary>
+        private static Thread WriterThread;
+
+        /// <summary>
+        ///     Wakes the writer thread when records are appended.
+        /// </summary>
+        private static readonly AutoResetEvent WriterWake = new AutoResetEvent(false);
+
+        /// <summary>
+        ///     Has the writer thread been woken since it last started writing. This avoids setting the event for every record.
+        /// </summary>
+        private static int WriterSignaled;
+
+        /// <summary>
+        ///     The local time in ticks when <see cref="BaseTimestamp" /> was taken.
+        /// </summary>
+        private static readonly long BaseTime = DateTime.Now.Ticks;
+
+        /// <summary>
+        ///     The raw performance counter value at <see cref="BaseTime" />.
+        /// </summary>
+        private static readonly long BaseTimestamp = Stopwatch.GetTimestamp();
+
+        /// <summary>
+        ///     The count of date time ticks in one performance counter tick.
+        /// </summary>
+        private static readonly double TicksPerTimestamp = (double)TimeSpan.TicksPerSecond / Stopwatch.Frequency;
+
+        /// <summary>
+        ///     The framework tick count in milliseconds at <see cref="BaseTime" />, written to binary files so decoded entries
+        ///     can be matched with tick values the game and plugins use.
+        /// </summary>
+        private static readonly long BaseTick = GetBaseTick();
+
+        /// <summary>
+        ///     Gets the framework tick count.
+        /// </summary>
+        /// <returns></returns>
+        private static long GetBaseTick()
+        {
+            try { return GetTickCount64_Accurate(); }
+            catch ( DllNotFoundException ) { return Environment.TickCount64; }
+            catch ( EntryPointNotFoundException ) { return Environment.TickCount64; }
+        }
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern long GetTickCount64_Accurate();
+
     #endregion
     }
 
 #endregion
 
-#region DateTimeStringConverter class
+#region LogEntry struct
 
     /// <summary>
-    ///     Helper function to convert date time to short string.
+    ///     Builds a log entry started with <see cref="LogFile.Begin" />. Arguments are written to a buffer of the current
+    ///     thread so building an entry does not allocate.
     /// </summary>
-    public static class DateTimeStringConverter
+    public struct LogEntry
     {
         /// <summary>
-        ///     The month names for timestamp string.
+        ///     The argument buffer of current thread. First byte is the count of arguments.
         /// </summary>
-        private static readonly string[] Months = { "Nul", "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+        [ ThreadStatic ] private static byte[] Buffer;
 
         /// <summary>
-        ///     Convert this date time instance to a short string for log file (or other use).
+        ///     The used length of argument buffer.
         /// </summary>
-        /// <param name="t">The time.</param>
-        /// <param name="milliseconds">if set to <c>true</c> then display milliseconds in the string.</param>
-        /// <returns></returns>
-        public static string ToLogTimestampString(this DateTime t, bool milliseconds = true)
+        [ ThreadStatic ] private static int Length;
+
+        /// <summary>
+        ///     The log file.
+        /// </summary>
+        private readonly LogFile File;
+
+        /// <summary>
+        ///     The format identifier.
+        /// </summary>
+        private readonly int FormatId;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="LogEntry" /> struct.
+        /// </summary>
+        /// <param name="file">The log file.</param>
+        /// <param name="formatId">The format identifier.</param>
+        internal LogEntry(LogFile file, int formatId)
         {
-            if ( milliseconds )
+            this.File     = file;
+            this.FormatId = formatId;
+
+            if ( Buffer == null )
             {
-                return string.Format("{0:00} {1} {2} {3:00}:{4:00}:{5:00}.{6:000}", t.Day, Months[t.Month], t.Year, t.Hour, t.Minute, t.Second, t.Millisecond);
+                Buffer = new byte[256];
             }
 
-            return string.Format("{0:00} {1} {2} {3:00}:{4:00}:{5:00}", t.Day, Months[t.Month], t.Year, t.Hour, t.Minute, t.Second);
+            Buffer[0] = 0;
+            Length    = 1;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(int value)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(this.Reserve(LogArgumentType.Int32, 4), value);
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(uint value)
+        {
+            BinaryPrimitives.WriteUInt32LittleEndian(this.Reserve(LogArgumentType.UInt32, 4), value);
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(long value)
+        {
+            BinaryPrimitives.WriteInt64LittleEndian(this.Reserve(LogArgumentType.Int64, 8), value);
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(ulong value)
+        {
+            BinaryPrimitives.WriteUInt64LittleEndian(this.Reserve(LogArgumentType.UInt64, 8), value);
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(float value)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(this.Reserve(LogArgumentType.Single, 4), BitConverter.SingleToInt32Bits(value));
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(double value)
+        {
+            BinaryPrimitives.WriteInt64LittleEndian(this.Reserve(LogArgumentType.Double, 8), BitConverter.DoubleToInt64Bits(value));
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(bool value)
+        {
+            this.Reserve(LogArgumentType.Boolean, 1)[0] = value ? (byte)1 : (byte)0;
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry. Pointers are written as hexadecimal when decoded.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(IntPtr value)
+        {
+            BinaryPrimitives.WriteInt64LittleEndian(this.Reserve(LogArgumentType.Pointer, 8), value.ToInt64());
+            return this;
+        }
+
+        /// <summary>
+        ///     Adds an argument to the entry. Strings are copied so this is slower than other arguments.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>This entry.</returns>
+        public LogEntry Arg(string value)
+        {
+            if ( value == null )
+            {
+                BinaryPrimitives.WriteInt32LittleEndian(this.Reserve(LogArgumentType.String, 4), -1);
+                return this;
+            }
+
+            var count = Encoding.UTF8.GetByteCount(value);
+            var span  = this.Reserve(LogArgumentType.String, 4 + count);
+            BinaryPrimitives.WriteInt32LittleEndian(span, count);
+            Encoding.UTF8.GetBytes(value, span.Slice(4));
+            return this;
+        }
+
+        /// <summary>
+        ///     Ends the entry and appends it to log file as a line.
+        /// </summary>
+        /// <exception cref="System.InvalidOperationException">Entry was not started with LogFile.Begin!</exception>
+        public void End()
+        {
+            if ( this.File == null )
+            {
+                throw new InvalidOperationException("Entry was not started with LogFile.Begin!");
+            }
+
+            this.File.EndEntry(this.FormatId, new ReadOnlySpan<byte>(Buffer, 0, Length));
+        }
+
+        /// <summary>
+        ///     Reserves space for an argument in the buffer.
+        /// </summary>
+        /// <param name="type">The argument type.</param>
+        /// <param name="size">The size of value.</param>
+        /// <returns>The space for value.</returns>
+        private Span<byte> Reserve(LogArgumentType type, int size)
+        {
+            if ( this.File == null )
+            {
+                throw new InvalidOperationException("Entry was not started with LogFile.Begin!");
+            }
+
+            if ( Buffer[0] == byte.MaxValue )
+            {
+                throw new InvalidOperationException("Log entry argument count can't exceed " + byte.MaxValue + "!");
+            }
+
+            if ( Length + 1 + size > Buffer.Length )
+            {
+                Array.Resize(ref Buffer, Math.Max(Buffer.Length * 2, Length + 1 + size));
+            }
+
+            Buffer[0]++;
+            Buffer[Length] = (byte)type;
+
+            var span = new Span<byte>(Buffer, Length + 1, size);
+            Length += 1 + size;
+            return span;
         }
     }
 
@@ -475,7 +1274,14 @@
         /// <summary>
         ///     Don't open the log file until first write is requested.
         /// </summary>
-        DelayedOpen = 0x10
+        DelayedOpen = 0x10,
+
+        /// <summary>
+        ///     Write compact binary records to a ".bin" file instead of text. Entries started with
+        ///     <see cref="LogFile.Begin" /> are not formatted, use <see cref="BinaryLogDecoder" /> to turn the file back to text.
+        ///     Timestamp in line option is ignored, every record has its own timestamp and thread.
+        /// </summary>
+        Binary = 0x20
     }
 
 #endregion
@@ -0,0 +1,399 @@
+﻿namespace NetScriptFramework.Tools
+{
+    using System;
+    using System.Collections.Generic;
+    using System.IO;
+    using System.Linq;
+    using System.Reflection;
+    using System.Runtime.InteropServices;
+    using System.Text;
+    using System.Threading;
+
+    /// <summary>
+    ///     Native performance monitor. Monitored functions are timed in native code on every call without entering .NET,
+    ///     the collected times are written to a binary file on shutdown or when the dump key is pressed.
+    /// </summary>
+    public static class PerformanceMonitor
+    {
+        /// <summary>
+        ///     The identifier at the start of performance monitor file.
+        /// </summary>
+        private const string FileHeader = "PMON";
+
+        /// <summary>
+        ///     The supported version of performance monitor file.
+        /// </summary>
+        private const int FileVersion = 1;
+
+        /// <summary>
+        ///     The locker for adding functions.
+        /// </summary>
+        private static readonly object Locker = new object();
+
+        /// <summary>
+        ///     The functions being monitored.
+        /// </summary>
+        private static readonly List<IntPtr> Functions = new List<IntPtr>();
+
+        /// <summary>
+        ///     The key polling thread.
+        /// </summary>
+        private static Thread _keyThread;
+
+        /// <summary>
+        ///     Is monitoring enabled.
+        /// </summary>
+        private static bool _enabled;
+
+        /// <summary>
+        ///     Gets or sets a value indicating whether monitored functions record their time. Monitoring is enabled when the first
+        ///     function is added.
+        /// </summary>
+        /// <value>
+        ///     <c>true</c> if enabled; otherwise, <c>false</c>.
+        /// </value>
+        public static bool Enabled
+        {
+            get => _enabled;
+            set
+            {
+                _enabled = value;
+                SetPerformanceMonitorEnabled(value);
+            }
+        }
+
+        /// <summary>
+        ///     Gets the count of monitored functions.
+        /// </summary>
+        /// <value>
+        ///     The count of monitored functions.
+        /// </value>
+        public static int Count
+        {
+            get
+            {
+                lock ( Locker )
+                {
+                    return Functions.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Start monitoring a function. This must be called during plugin initialization, same as writing hooks. The first
+        ///     instructions of the function are moved to a code cave so the replaced length must end on an instruction boundary
+        ///     and must not contain relative addressing other than calls.
+        /// </summary>
+        /// <param name="address">The address of the function.</param>
+        /// <param name="replaceLength">Length of the replaced code, at least 5 bytes. Use 13 or more for a far jump.</param>
+        /// <param name="pattern">The expected byte pattern at address or null to not verify.</param>
+        /// <exception cref="System.ArgumentNullException">address</exception>
+        /// <exception cref="System.InvalidOperationException">Too many functions are being monitored.</exception>
+        public static void Add(IntPtr address, int replaceLength, string pattern = null)
+        {
+            if ( address == IntPtr.Zero )
+            {
+                throw new ArgumentNullException(nameof(address));
+            }
+
+            var assembly = Assembly.GetCallingAssembly();
+
+            lock ( Locker )
+            {
+                var slot = AddPerformanceMonitorFunction(address);
+
+                if ( slot < 0 )
+                {
+                    throw new InvalidOperationException("Too many functions are being monitored!");
+                }
+
+                // The slot stays reserved even if the hook fails, it will just never record any calls.
+                Memory.WritePerformanceHook(address, replaceLength, pattern, slot, assembly);
+                Functions.Add(address);
+
+                if ( Functions.Count == 1 )
+                {
+                    Enabled = true;
+                    StartKeyThread();
+                }
+            }
+        }
+
+        /// <summary>
+        ///     Writes the current times of all threads to a binary file.
+        /// </summary>
+        /// <param name="filePath">The file path.</param>
+        /// <returns></returns>
+        public static bool Write(string filePath)
+        {
+            if ( string.IsNullOrEmpty(filePath) )
+            {
+                throw new ArgumentNullException(nameof(filePath));
+            }
+
+            var dir = Path.GetDirectoryName(Path.GetFullPath(filePath));
+
+            if ( !string.IsNullOrEmpty(dir) && !Directory.Exists(dir) )
+            {
+                Directory.CreateDirectory(dir);
+            }
+
+            return WritePerformanceMonitor(filePath) != 0;
+        }
+
+        /// <summary>
+        ///     Writes the current times to a new file in the performance directory and a summary next to it.
+        /// </summary>
+        /// <returns>The path of the binary file or null if nothing was written.</returns>
+        public static string Dump()
+        {
+            if ( Count == 0 )
+            {
+                return null;
+            }
+
+            var dir      = Path.Combine(Main.Config?.Path ?? string.Empty, "Performance");
+            var fileName = "Performance_" + DateTime.Now.ToString("yyyy_MM_dd_HH-mm-ss-fff");
+            var binPath  = Path.Combine(dir, fileName + ".bin");
+
+            if ( !Write(binPath) )
+            {
+                return null;
+            }
+
+            try
+            {
+                Summarize(binPath, Path.Combine(dir, fileName + ".txt"));
+            }
+            catch ( IOException ) { }
+
+            return binPath;
+        }
+
+        /// <summary>
+        ///     Reads a binary performance monitor file and writes a human readable summary. Functions are sorted by exclusive
+        ///     time.
+        /// </summary>
+        /// <param name="binaryPath">The binary file path.</param>
+        /// <param name="textPath">The text file path.</param>
+        /// <exception cref="System.IO.InvalidDataException">File is not a supported performance monitor file.</exception>
+        public static void Summarize(string binaryPath, string textPath)
+        {
+            long    frequency;
+            ulong[] addresses;
+            var     totals  = new Dictionary<int, long[]>();
+            var     threads = new List<Tuple<int, Dictionary<int, long[]>>>();
+
+            using ( var file = new BinaryReader(File.OpenRead(binaryPath)) )
+            {
+                var header = Encoding.ASCII.GetString(file.ReadBytes(4));
+
+                if ( header != FileHeader )
+                {
+                    throw new InvalidDataException("File is not a performance monitor file!");
+                }
+
+                var version = file.ReadInt32();
+
+                if ( version != FileVersion )
+                {
+                    throw new InvalidDataException("Version of performance monitor file is not supported!");
+                }
+
+                frequency = file.ReadInt64();
+                var functionCount = file.ReadInt32();
+                var threadCount   = file.ReadInt32();
+
+                addresses = new ulong[functionCount];
+
+                for ( var i = 0; i < functionCount; i++ )
+                {
+                    addresses[i] = file.ReadUInt64();
+                }
+
+                for ( var i = 0; i < threadCount; i++ )
+                {
+                    var threadId   = file.ReadInt32();
+                    var entryCount = file.ReadInt32();
+                    var entries    = new Dictionary<int, long[]>();
+
+                    for ( var j = 0; j < entryCount; j++ )
+                    {
+                        var slot   = file.ReadInt32();
+                        var values = new[] { file.ReadInt64(), file.ReadInt64(), file.ReadInt64() };
+                        entries[slot] = values;
+
+                        if ( !totals.TryGetValue(slot, out var total) )
+                        {
+                            total        = new long[3];
+                            totals[slot] = total;
+                        }
+
+                        for ( var k = 0; k < 3; k++ )
+                        {
+                            total[k] += values[k];
+                        }
+                    }
+
+                    threads.Add(new Tuple<int, Dictionary<int, long[]>>(threadId, entries));
+                }
+            }
+
+            if ( frequency <= 0 )
+            {
+                frequency = 1;
+            }
+
+            var bld = new StringBuilder();
+            bld.AppendLine("Performance monitor summary of " + addresses.Length + " function(s) on " + threads.Count + " thread(s).");
+            bld.AppendLine("Times are in milliseconds, exclusive time does not include time spent in other monitored functions.");
+            bld.AppendLine();
+            bld.AppendLine("All threads:");
+            AppendEntries(bld, totals, addresses, frequency);
+
+            foreach ( var t in threads.OrderBy(q => q.Item1) )
+            {
+                bld.AppendLine();
+                bld.AppendLine("Thread " + t.Item1 + ":");
+                AppendEntries(bld, t.Item2, addresses, frequency);
+            }
+
+            File.WriteAllText(textPath, bld.ToString());
+        }
+
+        /// <summary>
+        ///     Appends the entries sorted by exclusive time.
+        /// </summary>
+        /// <param name="bld">The builder.</param>
+        /// <param name="entries">The entries.</param>
+        /// <param name="addresses">The function addresses.</param>
+        /// <param name="frequency">The counter frequency.</param>
+        private static void AppendEntries(StringBuilder bld, Dictionary<int, long[]> entries, ulong[] addresses, long frequency)
+        {
+            bld.AppendLine(string.Format("  {0,-48} {1,12} {2,14} {3,14} {4,12}", "Function", "Calls", "Inclusive", "Exclusive", "Avg (us)"));
+
+            foreach ( var pair in entries.OrderByDescending(q => q.Value[2]) )
+            {
+                var calls     = pair.Value[0];
+                var inclusive = (double)pair.Value[1] * 1000.0 / frequency;
+                var exclusive = (double)pair.Value[2] * 1000.0 / frequency;
+                var average   = calls > 0 ? exclusive * 1000.0 / calls : 0.0;
+
+                bld.AppendLine(string.Format("  {0,-48} {1,12} {2,14:0.000} {3,14:0.000} {4,12:0.000}", GetFunctionName(addresses, pair.Key), calls, inclusive, exclusive, average));
+            }
+        }
+
+        /// <summary>
+        ///     Gets the name of function in slot.
+        /// </summary>
+        /// <param name="addresses">The function addresses.</param>
+        /// <param name="slot">The slot.</param>
+        /// <returns></returns>
+        private static string GetFunctionName(ulong[] addresses, int slot)
+        {
+            if ( slot < 0 || slot >= addresses.Length )
+            {
+                return "(invalid slot " + slot + ")";
+            }
+
+            var address = addresses[slot];
+            var fn      = Main.GameInfo?.GetFunctionInfo(new IntPtr(unchecked((long)address)), true);
+
+            return fn != null ? fn.GetName(true) : address.ToString("X");
+        }
+
+        /// <summary>
+        ///     Starts the thread that polls for the dump key if it is set in configuration.
+        /// </summary>
+        private static void StartKeyThread()
+        {
+            if ( _keyThread != null )
+            {
+                return;
+            }
+
+            var vl  = Main.Config?.GetValue(Main._Config_Debug_PerformanceMonitor_DumpKey);
+            var key = 0;
+
+            if ( vl == null || !vl.TryToInt32(out key) || key <= 0 )
+            {
+                return;
+            }
+
+            _keyThread = new Thread(() => RunKeyThread((VirtualKeys)key))
+            {
+                IsBackground = true,
+                Name         = "NetScriptFramework.PerformanceMonitor"
+            };
+
+            _keyThread.Start();
+        }
+
+        /// <summary>
+        ///     Polls the dump key and writes the times when it is pressed.
+        /// </summary>
+        /// <param name="key">The key.</param>
+        private static void RunKeyThread(VirtualKeys key)
+        {
+            var wasPressed = false;
+
+            while ( !Main.IsShutdown )
+            {
+                var isPressed = Input.IsPressed(key);
+
+                if ( isPressed && !wasPressed )
+                {
+                    var path = Dump();
+
+                    if ( path != null )
+                    {
+                        Main.Log.AppendLine("Wrote performance monitor times to \"" + path + "\".");
+                    }
+                }
+
+                wasPressed = isPressed;
+                Thread.Sleep(100);
+            }
+        }
+
+        /// <summary>
+        ///     Writes the times on shutdown.
+        /// </summary>
+        internal static void Shutdown()
+        {
+            if ( Count == 0 )
+            {
+                return;
+            }
+
+            Enabled = false;
+
+            try
+            {
+                var path = Dump();
+
+                if ( path != null )
+                {
+                    Main.Log.AppendLine("Wrote performance monitor times to \"" + path + "\".");
+                }
+            }
+            catch ( Exception ex )
+            {
+                Main.Log.AppendLine("Failed to write performance monitor times: " + ex.Message);
+            }
+        }
+
+    #region Imports
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern int AddPerformanceMonitorFunction(IntPtr address);
+
+        [ DllImport("NetScriptFramework.Runtime.dll") ]
+        private static extern void SetPerformanceMonitorEnabled([ MarshalAs(UnmanagedType.I1) ] bool enabled);
+
+        [ DllImport("NetScriptFramework.Runtime.dll", CharSet = CharSet.Unicode) ]
+        private static extern int WritePerformanceMonitor(string filePath);
+
+    #endregion
+    }
+}